@@ -51,6 +51,14 @@ struct StackVec {
     }
   }
 
+  //! Apply the scalar function \p f to each lane of \p a.
+  template <typename F>
+  static self_type Map(F f, const self_type& a) {
+    self_type res;
+    for (size_t i = 0; i < Num; i++) res.data_[i] = f(a[i]);
+    return res;
+  }
+
   void Store(void* base, int32_t offset) const {
     mempcpy((value_type*)base + offset, &data_[0], num_bytes());  // NOLINT
   }
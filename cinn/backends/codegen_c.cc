@@ -82,6 +82,8 @@ std::string CodeGenC::GetTypeRepr(Type type) {
     str += "int32_t";
   } else if (type.is_int(64)) {
     str += "int64_t";
+  } else if (type.is_uint(32)) {
+    str += "uint32_t";
   } else if (type.is_bool()) {
     str += "bool";
   } else if (type.is_float(32)) {
@@ -232,6 +234,8 @@ void CodeGenC::Visit(const ir::Call *op) {
     PrintCall_buffer_malloc(op);
   } else if (op->name == runtime::intrisic::pod_values_to_array_repr) {
     PrintCall_pod_values_to_array(op);
+  } else if (op->type().lanes() > 1 && op->read_args.size() == 1 && op->write_args.empty()) {
+    PrintCall_vectorized(op);
   } else if (op->is_intrinsic_call()) {
     os() << op->name << "(";
     PrintCallArgs(op);
@@ -293,6 +297,14 @@ void CodeGenC::PrintCall_cinn_pod_value_to_(const ir::Call *op) {
   os() << ")";
 }
 
+void CodeGenC::PrintCall_vectorized(const ir::Call *op) {
+  std::string scalar_type = GetTypeRepr(op->type().ElementOf());
+  os() << "StackVec<" << op->type().lanes() << "," << scalar_type << ">::Map([](" << scalar_type << " x) { return "
+       << op->name << "(x); }, ";
+  Print(op->read_args.front());
+  os() << ")";
+}
+
 void CodeGenC::PrintCall_get_address(const ir::Call *op) {
   CHECK_EQ(op->read_args.size(), 1UL);
   CHECK(op->write_args.empty());
@@ -375,11 +387,21 @@ void CodeGenC::Visit(const ir::Store *op) {
   Print(op->value);
 }
 void CodeGenC::Visit(const ir::Alloc *op) {
+  auto *buffer = op->destination.As<ir::_Buffer_>();
+  if (buffer->memory_type == ir::MemoryType::Stack) {
+    os() << GetTypeRepr(buffer->dtype) << " " << buffer->name << " ";
+    os() << "[ ";
+    for (int i = 0; i < buffer->shape.size(); i++) {
+      if (i > 0) os() << " * ";
+      Print(buffer->shape[i]);
+    }
+    os() << " ]";
+    return;
+  }
+
   os() << runtime::intrisic::buffer_malloc;
   os() << "(";
   os() << "(void*)(0), ";
-
-  auto *buffer = op->destination.As<ir::_Buffer_>();
   os() << buffer->name;
   os() << ")";
 }
@@ -483,6 +505,10 @@ void CodeGenC::Visit(const ir::_LoweredFunc_ *op) {
   std::vector<Expr> new_body;
 
   auto alloca_temp_buffers = op->PrepareAllocTempBufferExprs();
+  stack_buffers_.clear();
+  for (auto &buffer : op->temp_bufs) {
+    if (buffer->memory_type == ir::MemoryType::Stack) stack_buffers_.insert(buffer->name);
+  }
 #define APPEND_TO_NEW_BODY(field__) new_body.insert(std::end(new_body), std::begin(op->field__), std::end(op->field__));
   APPEND_TO_NEW_BODY(argument_prepare_exprs)
   APPEND_TO_NEW_BODY(alloc_output_buffer_exprs)
@@ -594,12 +620,16 @@ void CodeGenC::Visit(const ir::IntrinsicOp *op) {
 
 void CodeGenC::Visit(const ir::intrinsics::BufferGetDataHandle *op) {
   os() << op->buffer.as_buffer()->name;
+  // The arrays on the stack are the data themselves.
+  if (stack_buffers_.count(op->buffer.as_buffer()->name)) return;
   os() << "->";
   os() << "memory";
 }
 
 void CodeGenC::Visit(const ir::intrinsics::BufferGetDataConstHandle *op) {
   os() << op->buffer.as_buffer()->name;
+  // The arrays on the stack are the data themselves.
+  if (stack_buffers_.count(op->buffer.as_buffer()->name)) return;
   os() << "->";
   os() << "memory";
 }
@@ -2,6 +2,7 @@
 
 #include <gflags/gflags.h>
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,8 @@ class CodeGenC : public ir::IrPrinter {
   void PrintCall_cinn_pod_value_to_(const ir::Call* op);
   void PrintCall_get_address(const ir::Call* op);
   void PrintCall_pod_values_to_array(const ir::Call* op);
+  //! Print a math call widened by the vectorizer, the scalar function is applied to each lane.
+  void PrintCall_vectorized(const ir::Call* op);
   // @}
 
 #define __DEFINE_VISIT(op__) void Visit(const ir::op__* op) override;
@@ -102,6 +105,8 @@ class CodeGenC : public ir::IrPrinter {
   Target target_;
   std::stringstream ss_;
   bool inline_builtin_codes_{true};
+  //! The names of the temporary buffers placed on the stack of the current function.
+  std::set<std::string> stack_buffers_;
 };
 
 namespace detail {
@@ -1,5 +1,6 @@
 #include "cinn/backends/compiler.h"
 
+#include "cinn/backends/llvm/codegen_x86.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #ifdef CINN_WITH_CUDA
 #include "cinn/backends/codegen_cuda_dev.h"
@@ -77,7 +78,7 @@ void Compiler::CompileCudaModule(const Module& module, const std::string& code)
 #endif
 }
 
-void Compiler::CompileX86Module(const Module& module) { engine_->Link(module); }
+void Compiler::CompileX86Module(const Module& module) { engine_->Link<CodeGenX86>(module); }
 
 lower_func_ptr_t Compiler::Lookup(std::string_view fn_name) {
   CHECK(engine_);
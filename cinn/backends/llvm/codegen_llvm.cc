@@ -20,11 +20,13 @@
 
 #include "cinn/backends/extern_func_emitter.h"
 #include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/backends/llvm/llvm_vector_math.h"
 #include "cinn/common/cas.h"
 #include "cinn/common/type.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_verify.h"
+#include "cinn/optim/vectorize_loops.h"
 #include "cinn/runtime/cinn_runtime.h"
 #include "cinn/runtime/intrinsic.h"
 #include "cinn/utils/string.h"
@@ -236,11 +238,11 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Mul *op) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Div *op) {
-  return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '/', is_integral_type(op->type()));
+  return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '/', is_integral_type(op->type()), !op->type().is_uint());
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Mod *op) {
-  return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '%', is_integral_type(op->type()));
+  return EmitBinaryOp(Visit(&op->a()), Visit(&op->b()), '%', is_integral_type(op->type()), !op->type().is_uint());
 }
 
 #define __IR_EMITTER_DEFINE_CMP_VISITOR(__sop, __uop, __fop) \
@@ -619,6 +621,10 @@ llvm::Value *CodeGenLLVM::Visit(const ir::PrimitiveNode *) { CINN_NOT_IMPLEMENTE
 llvm::Value *CodeGenLLVM::Visit(const ir::Call *op) {
   if (op->name == runtime::intrisic::debug_log_repr) {
     return EmitCall_debug_info(op);
+  } else if (optim::IsVectorMathCall(op)) {
+    llvm::Value *x = Visit(&op->read_args.front());
+    CHECK(x) << "argument " << op->read_args.front() << " is null";
+    return VectorMathEmitter(b_, GetVectorMathAccuracy()).Emit(op->name, x);
   } else if (op->is_extern_call()) {
     auto emitter_id = ExternFuncID{backend_llvm_host, op->name.c_str()};
     auto *emitter   = ExternFunctionEmitterRegistry::Global().Lookup(emitter_id);
@@ -822,7 +828,22 @@ llvm::Value *CodeGenLLVM::Visit(const ir::Store *op) {
 
 llvm::Value *CodeGenLLVM::Visit(const ir::Alloc *op) {
   auto *buffer_op = op->destination.As<ir::_Buffer_>();
-  auto *buffer    = GetVar(buffer_op->name);
+  if (buffer_op->memory_type == ir::MemoryType::Stack) {
+    // A static alloca at the beginning of the entry block, SROA promotes its elements accessed by the constant indices
+    // to registers.
+    int64_t size = 1;
+    for (auto &dim : buffer_op->shape) {
+      CHECK(dim.is_constant()) << "the shape of the stack buffer " << buffer_op->name << " should be constant";
+      size *= static_cast<int64_t>(dim.get_constant());
+    }
+    auto *array_type = llvm::ArrayType::get(CinnTypeToLLVMType(buffer_op->dtype, m_), size);
+    auto &entry      = b_->GetInsertBlock()->getParent()->getEntryBlock();
+    llvm::IRBuilder<> entry_builder(&entry, entry.begin());
+    llvm::AllocaInst *inst = entry_builder.CreateAlloca(array_type, nullptr, buffer_op->name);
+    inst->setAlignment(llvm::Align(32));
+    return SetVar(buffer_op->name, inst);
+  }
+  auto *buffer = GetVar(buffer_op->name);
   CHECK(buffer);
 
   return buffer;
@@ -848,15 +869,29 @@ llvm::Value *CodeGenLLVM::Visit(const ir::_Tensor_ *op) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::_LoweredFunc_ *op) {
-  auto init_function_state = [this]() { alias_vars_.clear(); };
+  auto init_function_state = [this]() {
+    alias_vars_.clear();
+    stack_buffers_.clear();
+  };
   init_function_state();
 
   CHECK_EQ(op->alloc_output_buffer_exprs.size(), op->dealloc_output_buffer_exprs.size())
       << "the count of allocation and deallocaton expressions is not match";
 
+  // The heap buffers are created in the module, only the ones on the stack are allocated in the function.
+  std::vector<Expr> alloca_stack_buffers;
+  for (auto &alloc : op->PrepareAllocTempBufferExprs()) {
+    auto *buffer = alloc.As<ir::Alloc>()->destination.as_buffer();
+    if (buffer->memory_type == ir::MemoryType::Stack) {
+      alloca_stack_buffers.push_back(alloc);
+      stack_buffers_.insert(buffer->name);
+    }
+  }
+
   std::vector<Expr> new_body;
   new_body.reserve(op->argument_prepare_exprs.size() + op->alloc_output_buffer_exprs.size() +
-                   op->buffer_data_cast_exprs.size() + 1 /*op->body*/ + op->dealloc_output_buffer_exprs.size());
+                   alloca_stack_buffers.size() + op->buffer_data_cast_exprs.size() + 1 /*op->body*/ +
+                   op->dealloc_output_buffer_exprs.size());
 
   auto new_body_append = [&new_body](auto &&... v) {
     auto append = [&new_body](auto &&v) {
@@ -871,6 +906,7 @@ llvm::Value *CodeGenLLVM::Visit(const ir::_LoweredFunc_ *op) {
 
   new_body_append(op->argument_prepare_exprs,
                   op->alloc_output_buffer_exprs,
+                  alloca_stack_buffers,
                   op->buffer_data_cast_exprs,
                   op->body,
                   op->dealloc_output_buffer_exprs);
@@ -1239,12 +1275,16 @@ llvm::Value *CodeGenLLVM::Visit(const ir::IntrinsicOp *op) {
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataHandle *op) {
+  // The arrays on the stack are the data themselves.
+  if (stack_buffers_.count(op->buffer.as_buffer()->name)) return Visit(&op->buffer);
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_handle");
   return Call(callee, std::move(args));
 }
 
 llvm::Value *CodeGenLLVM::Visit(const ir::intrinsics::BufferGetDataConstHandle *op) {
+  // The arrays on the stack are the data themselves.
+  if (stack_buffers_.count(op->buffer.as_buffer()->name)) return Visit(&op->buffer);
   std::vector<llvm::Value *> args({Visit(&op->buffer)});
   auto *callee = m_->getFunction("cinn_buffer_get_data_const_handle");
   return Call(callee, std::move(args));
@@ -200,6 +200,8 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
   // std::shared_ptr<std::unordered_map<std::string, llvm::Value *>> named_vars_;
   std::shared_ptr<SymbolTable> symbol_table_;
   std::unordered_set<ir::_Var_ *> alias_vars_;
+  //! The names of the temporary buffers placed on the stack of the current function.
+  std::unordered_set<std::string> stack_buffers_;
 
   llvm::MDNode *md_tbaa_root_{nullptr};
   llvm::MDNode *md_tbaa_alias_set_{nullptr};
@@ -1,7 +1,14 @@
 #include "cinn/backends/llvm/codegen_x86.h"
 
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "cinn/backends/llvm/runtime_symbol_registry.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/runtime/cpu/thread_backend.h"
+#include "cinn/runtime/intrinsic.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Intrinsics.h"
@@ -14,4 +21,100 @@ CodeGenX86::CodeGenX86(llvm::Module *m, llvm::IRBuilder<> *b, const std::shared_
 
 CodeGenX86::~CodeGenX86() {}
 
+llvm::Value *CodeGenX86::Visit(const ir::For *op) {
+  if (op->is_parallel() && !in_parallel_task_) return CreateParallelLaunch(op);
+  return CodeGenLLVM::Visit(op);
+}
+
+llvm::Value *CodeGenX86::CreateParallelLaunch(const ir::For *op) {
+  auto &ctx = b_->getContext();
+
+  // The values the forloop refers to, the constants and globals are valid in the task and not passed.
+  std::set<std::string> names;
+  ir::CollectIRNodes(Expr(const_cast<ir::For *>(op)), [&](const Expr *x) {
+    if (auto *var = x->As<ir::_Var_>()) {
+      names.insert(var->name);
+    } else if (auto *tensor = x->As<ir::_Tensor_>()) {
+      names.insert(tensor->name);
+      if (tensor->buffer.defined()) names.insert(tensor->buffer->name);
+    } else if (auto *buffer = x->As<ir::_Buffer_>()) {
+      names.insert(buffer->name);
+    }
+    return false;
+  });
+  names.erase(op->loop_var->name);
+
+  std::vector<std::string> captured_names;
+  std::vector<llvm::Value *> captured_values;
+  std::vector<llvm::Type *> captured_types;
+  for (auto &name : names) {
+    auto *value = GetVar(name);
+    if (!value || llvm::isa<llvm::Constant>(value)) continue;
+    captured_names.push_back(name);
+    captured_values.push_back(value);
+    captured_types.push_back(value->getType());
+  }
+  auto *closure_ty = llvm::StructType::get(ctx, captured_types);
+
+  // Store the values to the closure, allocated in the entry block like the loop variables.
+  llvm::Function *func = b_->GetInsertBlock()->getParent();
+  auto ip              = b_->saveIP();
+  b_->SetInsertPoint(&func->getEntryBlock(), func->getEntryBlock().getFirstInsertionPt());
+  llvm::AllocaInst *closure = Alloca(closure_ty, nullptr, "parallel_closure");
+  b_->restoreIP(ip);
+  for (int i = 0; i < captured_values.size(); i++) {
+    Store(captured_values[i], b_->CreateStructGEP(closure_ty, closure, i));
+  }
+  llvm::Value *num_task = Sub(Visit(&op->extent), Visit(&op->min));
+
+  // Outline the forloop to the task running the iterations [begin, end) of the chunk task_id.
+  auto *task_ty =
+      llvm::FunctionType::get(b_->getInt32Ty(), {b_->getInt32Ty(), b_->getInt32Ty(), b_->getInt8PtrTy()}, false);
+  auto *task =
+      llvm::Function::Create(task_ty, llvm::Function::PrivateLinkage, func->getName() + "_parallel_task", m_);
+  ip = b_->saveIP();
+  b_->SetInsertPoint(llvm::BasicBlock::Create(ctx, "entry", task));
+  {
+    SymbolTableGuard symbol_table_guard(*symbol_table_);
+    in_parallel_task_ = true;
+
+    auto *task_closure = BitCast(task->getArg(2), closure_ty->getPointerTo());
+    for (int i = 0; i < captured_names.size(); i++) {
+      SetVar(captured_names[i],
+             b_->CreateLoad(captured_types[i], b_->CreateStructGEP(closure_ty, task_closure, i), captured_names[i]));
+    }
+
+    llvm::Value *task_id   = task->getArg(0);
+    llvm::Value *task_num  = task->getArg(1);
+    llvm::Value *min       = Visit(&op->min);
+    llvm::Value *extent    = Visit(&op->extent);
+    llvm::Value *chunk     = SDiv(Add(Sub(extent, min), Sub(task_num, ll_const_int32(1))), task_num);
+    llvm::Value *begin     = Add(min, Mul(task_id, chunk));
+    llvm::Value *chunk_end = Add(begin, chunk);
+    llvm::Value *end       = b_->CreateSelect(ICmpSLT(chunk_end, extent), chunk_end, extent);
+
+    Var begin_var(op->loop_var->name + "_task_begin");
+    Var end_var(op->loop_var->name + "_task_end");
+    SetVar(begin_var->name, begin);
+    SetVar(end_var->name, end);
+    Expr chunk_loop = ir::For::Make(
+        op->loop_var, begin_var, end_var, ir::ForType::Serial, op->device_api, op->body, op->vectorize_info());
+    chunk_loop.As<ir::For>()->metadata = op->metadata;
+    CodeGenLLVM::Visit(chunk_loop.As<ir::For>());
+    b_->CreateRet(ll_const_int32(0));
+
+    in_parallel_task_ = false;
+  }
+  b_->restoreIP(ip);
+
+  // Registered here rather than with the extern functions, the JIT resolves it whenever a parallel forloop is emitted.
+  RuntimeSymbolRegistry::Global().RegisterFn(runtime::intrisic::parallel_launch,
+                                             reinterpret_cast<void *>(&cinn_backend_parallel_launch));
+  auto launch = m_->getOrInsertFunction(
+      runtime::intrisic::parallel_launch,
+      llvm::FunctionType::get(b_->getInt32Ty(), {b_->getInt8PtrTy(), b_->getInt8PtrTy(), b_->getInt32Ty()}, false));
+  return b_->CreateCall(launch,
+                        {BitCast(task, b_->getInt8PtrTy()), BitCast(closure, b_->getInt8PtrTy()), num_task});
+}
+
 }  // namespace cinn::backends
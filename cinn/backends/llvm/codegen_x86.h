@@ -17,6 +17,18 @@ class CodeGenX86 : public CodeGenLLVM {
   virtual ~CodeGenX86();
 
   using LLVMIRVisitor::Visit;
+
+  llvm::Value *Visit(const ir::For *op) override;
+
+ private:
+  /**
+   * Lower a forloop marked parallel to a call of `cinn_backend_parallel_launch`. The forloop is outlined to a task
+   * function running a chunk of the iterations, the values it refers to are passed in a struct on the stack.
+   */
+  llvm::Value *CreateParallelLaunch(const ir::For *op);
+
+  //! Whether the code emitted is in a parallel task, the parallel forloops nested in it are lowered serially.
+  bool in_parallel_task_{false};
 };
 
 }  // namespace cinn::backends
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include "cinn/backends/llvm/execution_engine.h"
 #include "cinn/backends/llvm/simple_jit.h"
 #include "cinn/cinn.h"
 #include "cinn/common/test_helper.h"
@@ -54,5 +55,48 @@ TEST(Vectorize, basic) {
   }
 }
 
+TEST(CodeGenX86, parallel) {
+  Expr M(100);
+  Expr N(32);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+
+  auto C = Compute(
+      {M, N}, [&](Expr i, Expr j) { return A(i, j) * B(i, j) + A(i, j); }, "C");
+  auto stages = CreateStages({C});
+  stages[C]->Parallel(0);
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  builder.AddFunction(Lower("fn", stages, {A, B, C}));
+  auto module = builder.Build();
+
+  {  // The forloop is outlined to a task run by the parallel launch.
+    llvm::LLVMContext context;
+    llvm::IRBuilder<> b(context);
+    llvm::Module m("test_codegen_x86", context);
+    CodeGenX86(&m, &b).Compile(module);
+    ASSERT_TRUE(m.getFunction("fn_parallel_task"));
+    ASSERT_TRUE(m.getFunction("cinn_backend_parallel_launch"));
+  }
+
+  auto engine = ExecutionEngine::Create(ExecutionOptions());
+  engine->Link<CodeGenX86>(module);
+  auto* fn_ptr = reinterpret_cast<lower_func_ptr_t>(engine->Lookup("fn"));
+  ASSERT_TRUE(fn_ptr);
+
+  auto* A_buf = common::BufferBuilder(Float(32), {100, 32}).set_random().Build();
+  auto* B_buf = common::BufferBuilder(Float(32), {100, 32}).set_random().Build();
+  auto* C_buf = common::BufferBuilder(Float(32), {100, 32}).set_zero().Build();
+  auto args   = common::ArgsBuilder().Add(A_buf).Add(B_buf).Add(C_buf).Build();
+  fn_ptr(reinterpret_cast<void**>(args.data()), args.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  auto* C_data = reinterpret_cast<float*>(C_buf->memory);
+  for (int i = 0; i < C_buf->num_elements(); i++) {
+    ASSERT_NEAR(A_data[i] * B_data[i] + A_data[i], C_data[i], 1e-5);
+  }
+}
+
 }  // namespace backends
 }  // namespace cinn
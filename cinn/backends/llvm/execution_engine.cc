@@ -33,22 +33,27 @@
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "cinn/backends/codegen_cuda_host.h"
-#include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
 #include "cinn/backends/llvm/codegen_x86.h"
+#include "cinn/backends/llvm/llvm_module_split.h"
 #include "cinn/backends/llvm/llvm_optimizer.h"
 #include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/backends/llvm/runtime_llvm_module.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/runtime/intrinsic.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn::backends {
 namespace {
@@ -71,13 +76,33 @@ void InitializeLLVMPasses() {
   // llvm::initializeTarget(registry);
   // llvm::initializeCodeGenPreparePass(registry);
 }
+
+//! Run \p fn(i) for each i in [0, n) on \p num_threads threads.
+void ParallelFor(int n, int num_threads, const std::function<void(int)> &fn) {
+  std::atomic<int> next{0};
+  auto worker = [&] {
+    for (int i = next++; i < n; i = next++) {
+      fn(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < std::min(n, num_threads); i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
 }  // namespace
 void NaiveObjectCache::notifyObjectCompiled(const llvm::Module *m, llvm::MemoryBufferRef obj_buffer) {
+  std::lock_guard<std::mutex> lock(mu_);
   cached_objects_[m->getModuleIdentifier()] =
       llvm::MemoryBuffer::getMemBufferCopy(obj_buffer.getBuffer(), obj_buffer.getBufferIdentifier());
 }
 
 std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Module *m) {
+  std::lock_guard<std::mutex> lock(mu_);
   auto it = cached_objects_.find(m->getModuleIdentifier());
   if (it == cached_objects_.end()) {
     VLOG(1) << "No object for " << m->getModuleIdentifier() << " in cache. Compiling.";
@@ -97,15 +122,23 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   llvm::InitializeNativeTargetAsmPrinter();
   InitializeLLVMPasses();
 
-  auto engine = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true);
+  auto engine      = std::make_unique<ExecutionEngine>(/*enable_object_cache=*/true);
+  engine->options_ = config;
 
-  auto compile_layer_creator = [&engine](llvm::orc::JITTargetMachineBuilder jtmb)
+  auto compile_layer_creator = [&engine, &config](llvm::orc::JITTargetMachineBuilder jtmb)
       -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
-    auto machine = llvm::cantFail(jtmb.createTargetMachine());
     VLOG(1) << "create llvm compile layer";
-    VLOG(1) << "Target Name: " << machine->getTarget().getName();
-    VLOG(1) << "Target CPU: " << machine->getTargetCPU().str() << std::endl;
-    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(machine), engine->cache_.get());
+    VLOG(1) << "Target Triple: " << jtmb.getTargetTriple().str();
+    VLOG(1) << "Target CPU: " << jtmb.getCPU();
+    // The object cache is keyed by module name, which is not unique among the partitions of the lazy mode.
+    auto *cache = config.lazy_compile ? nullptr : engine->cache_.get();
+    // TMOwningSimpleCompiler shares one TargetMachine and is not thread-safe, while the background compilation runs
+    // concurrently with the compilations on the first calls.
+    if (config.num_compile_threads > 1 || (config.lazy_compile && config.background_compile)) {
+      return std::make_unique<llvm::orc::ConcurrentIRCompiler>(std::move(jtmb), cache);
+    }
+    auto machine = llvm::cantFail(jtmb.createTargetMachine());
+    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(machine), cache);
   };
 
   auto object_layer_creator = [&](llvm::orc::ExecutionSession &session, const llvm::Triple &triple) {
@@ -122,13 +155,34 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
   engine->jit_ = llvm::cantFail(llvm::orc::LLJITBuilder()
                                     .setCompileFunctionCreator(compile_layer_creator)
                                     .setObjectLinkingLayerCreator(object_layer_creator)
+                                    .setNumCompileThreads(std::max(config.num_compile_threads, 1) - 1)
                                     .create());
-  engine->jit_->getMainJITDylib().addGenerator(llvm::cantFail(
-      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(engine->jit_->getDataLayout().getGlobalPrefix())));
+  auto &session      = engine->jit_->getExecutionSession();
+  auto symbol_prefix = engine->jit_->getDataLayout().getGlobalPrefix();
+  engine->jit_->getMainJITDylib().addGenerator(
+      llvm::cantFail(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(symbol_prefix)));
 
   VLOG(2) << "register runtime call symbols";
+  engine->RegisterRuntimeSymbols(&engine->jit_->getMainJITDylib());
 
-  engine->RegisterRuntimeSymbols();
+  if (config.lazy_compile) {
+    llvm::Triple triple(llvm::sys::getProcessTriple());
+    engine->lazy_call_through_ =
+        llvm::cantFail(llvm::orc::createLocalLazyCallThroughManager(triple, session, /*ErrorHandlerAddr=*/0));
+    engine->indirect_stubs_ = llvm::orc::createLocalIndirectStubsManagerBuilder(triple)();
+    // The functions are looked up in the implementation JITDylib, it resolves the runtime symbols by itself.
+    engine->impl_dylib_ = &llvm::cantFail(session.createJITDylib("<main>.cinn_impl"));
+    engine->impl_dylib_->addGenerator(
+        llvm::cantFail(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(symbol_prefix)));
+    engine->RegisterRuntimeSymbols(engine->impl_dylib_);
+    // A function is optimized here right before it gets compiled.
+    engine->jit_->getIRTransformLayer().setTransform(
+        [engine = engine.get()](llvm::orc::ThreadSafeModule tsm,
+                                auto &responsibility) -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+          tsm.withModuleDo([engine](llvm::Module &m) { engine->OptimizeModule(&m); });
+          return std::move(tsm);
+        });
+  }
 
   VLOG(2) << "===================== Create CINN ExecutionEngine end ====================";
   return engine;
@@ -136,19 +190,34 @@ std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(const llvm::Modu
 
 template <typename CodeGenT>
 void ExecutionEngine::Link(const ir::Module &module) {
-  llvm::SMDiagnostic error;
-  auto ctx        = std::make_unique<llvm::LLVMContext>();
-  auto m          = llvm::parseAssemblyString(AsStringRef(backends::kRuntimeLlvmIr), error, *ctx);
-  auto b          = std::make_unique<llvm::IRBuilder<>>(*ctx);
-  auto ir_emitter = std::make_unique<CodeGenT>(m.get(), b.get());
-  ir_emitter->Compile(module);
+  auto ctx = std::make_unique<llvm::LLVMContext>();
+  std::unique_ptr<llvm::Module> m;
+  {
+    utils::ProfileTimer timer("llvm.codegen");
+    m               = LoadRuntimeLlvmModule(ctx.get());
+    auto b          = std::make_unique<llvm::IRBuilder<>>(*ctx);
+    auto ir_emitter = std::make_unique<CodeGenT>(m.get(), b.get());
+    ir_emitter->Compile(module);
+    MaterializeRuntimeFunctions(m.get());
+  }
 
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
 
-  auto machine =
-      std::move(llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine()));
-  LLVMModuleOptimizer optimize(machine.get(), 3, {}, true);
-  optimize(m.get());
+  if (impl_dylib_) {
+    CHECK(AddLazyModule(std::move(m), std::move(ctx)));
+    return;
+  }
+
+  if (options_.num_compile_threads > 1) {
+    std::vector<std::string> fn_names;
+    for (auto &fn : module.functions()) {
+      fn_names.push_back(fn->name);
+    }
+    OptimizeAndCompileParallel(SplitModuleByFunctions(*m, fn_names, options_.num_compile_threads));
+    return;
+  }
+
+  OptimizeModule(m.get());
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid optimized module detected";
   for (auto &f : *m) {
     VLOG(3) << "function: " << DumpToString(f);
@@ -184,8 +253,119 @@ bool ExecutionEngine::AddModule(std::unique_ptr<llvm::Module> module, std::uniqu
   return true;
 }
 
+bool ExecutionEngine::AddLazyModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context) {
+  CHECK(impl_dylib_) << "AddLazyModule is only valid when the ExecutionEngine is created with lazy_compile";
+  module->setDataLayout(jit_->getDataLayout());
+
+  std::vector<std::string> fn_names;
+  for (auto &fn : *module) {
+    if (!fn.isDeclaration() && fn.hasExternalLinkage()) {
+      fn_names.push_back(fn.getName().str());
+    }
+  }
+
+  // Each function is compiled alone, the first part holds the runtime functions and globals shared by them.
+  for (auto &part : SplitModuleByFunctions(*module, fn_names, fn_names.size() + 1, /*shared_part=*/true)) {
+    llvm::cantFail(jit_->addIRModule(*impl_dylib_, std::move(part)));
+  }
+
+  auto &session = jit_->getExecutionSession();
+  llvm::orc::SymbolAliasMap aliases;
+  for (auto &name : fn_names) {
+    aliases[session.intern(name)] = {session.intern(name),
+                                     llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable};
+  }
+  auto reexports = llvm::orc::lazyReexports(*lazy_call_through_, *indirect_stubs_, *impl_dylib_, std::move(aliases));
+  llvm::cantFail(jit_->getMainJITDylib().define(std::move(reexports)));
+
+  if (options_.background_compile && !fn_names.empty()) {
+    background_compile_threads_.emplace_back(&ExecutionEngine::CompileInBackground, this, std::move(fn_names));
+  }
+  return true;
+}
+
+void ExecutionEngine::CompileInBackground(std::vector<std::string> fn_names) {
+  // Looking up a function in the main JITDylib only emits its lazy stub, looking it up in the implementation
+  // JITDylib compiles its body.
+  for (auto &name : fn_names) {
+    if (stop_background_compile_) return;
+    auto symbol = jit_->lookup(*impl_dylib_, name);
+    if (!symbol) {
+      VLOG(3) << "Background compilation of [" << name << "] failed: " << llvm::toString(symbol.takeError());
+    }
+  }
+  VLOG(2) << "Background compilation of " << fn_names.size() << " functions finished";
+}
+
+void ExecutionEngine::OptimizeAndCompileParallel(std::vector<llvm::orc::ThreadSafeModule> parts) {
+  const int num_parts = parts.size();
+  std::vector<std::vector<std::string>> part_fn_names(num_parts);
+
+  ParallelFor(num_parts, options_.num_compile_threads, [&](int i) {
+    parts[i].withModuleDo([&](llvm::Module &m) {
+      OptimizeModule(&m);
+      CHECK(!llvm::verifyModule(m, &llvm::errs())) << "Invalid optimized module detected";
+      for (auto &fn : m) {
+        if (!fn.isDeclaration() && fn.hasExternalLinkage()) {
+          part_fn_names[i].push_back(fn.getName().str());
+        }
+      }
+    });
+  });
+
+  // All the parts should be added before compiling any of them, for they reference the symbols of each other.
+  for (auto &part : parts) {
+    part.withModuleDo([&](llvm::Module &m) { m.setDataLayout(jit_->getDataLayout()); });
+    llvm::cantFail(jit_->addIRModule(std::move(part)));
+  }
+
+  // Looking up a symbol materializes the part defining it.
+  ParallelFor(num_parts, options_.num_compile_threads, [&](int i) {
+    for (auto &name : part_fn_names[i]) {
+      llvm::cantFail(jit_->lookup(name).takeError());
+    }
+  });
+}
+
+void ExecutionEngine::OptimizeModule(llvm::Module *m) {
+  utils::ProfileTimer timer("llvm.optimize");
+  auto machine = AcquireTargetMachine();
+  LLVMModuleOptimizer optimize(machine.get(), 3, {}, true);
+  optimize(m);
+  ReleaseTargetMachine(std::move(machine));
+  if (utils::CompileProfiler::Global().enabled()) {
+    utils::CompileProfiler::Global().AddCount("llvm.instructions", m->getInstructionCount());
+  }
+}
+
+std::unique_ptr<llvm::TargetMachine> ExecutionEngine::AcquireTargetMachine() {
+  {
+    std::lock_guard<std::mutex> lock(machines_mu_);
+    if (!machines_.empty()) {
+      auto machine = std::move(machines_.back());
+      machines_.pop_back();
+      return machine;
+    }
+  }
+  return llvm::cantFail(llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost()).createTargetMachine());
+}
+
+void ExecutionEngine::ReleaseTargetMachine(std::unique_ptr<llvm::TargetMachine> machine) {
+  std::lock_guard<std::mutex> lock(machines_mu_);
+  machines_.push_back(std::move(machine));
+}
+
+ExecutionEngine::~ExecutionEngine() {
+  stop_background_compile_ = true;
+  for (auto &thread : background_compile_threads_) {
+    thread.join();
+  }
+}
+
 void *ExecutionEngine::Lookup(std::string_view name) {
   std::lock_guard<std::mutex> lock(mu_);
+  // The first lookup of a symbol compiles the module defining it.
+  utils::ProfileTimer timer("llvm.lookup");
   if (auto symbol = jit_->lookup(AsStringRef(name))) {
     return reinterpret_cast<void *>(symbol->getAddress());
   }
@@ -194,11 +374,11 @@ void *ExecutionEngine::Lookup(std::string_view name) {
   return nullptr;
 }
 
-void ExecutionEngine::RegisterRuntimeSymbols() {
+void ExecutionEngine::RegisterRuntimeSymbols(llvm::orc::JITDylib *dylib) {
   const auto &registry = RuntimeSymbolRegistry::Global();
   auto *session        = &jit_->getExecutionSession();
   for (const auto &[name, addr] : registry.All()) {
-    llvm::cantFail(jit_->define(llvm::orc::absoluteSymbols(
+    llvm::cantFail(dylib->define(llvm::orc::absoluteSymbols(
         {{session->intern(name), {llvm::pointerToJITTargetAddress(addr), llvm::JITSymbolFlags::None}}})));
   }
 }
@@ -8,8 +8,10 @@
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
 #include <llvm/ExecutionEngine/Orc/IRCompileLayer.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/LambdaResolver.h>
+#include <llvm/ExecutionEngine/Orc/LazyReexports.h>
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/ExecutionEngine/SectionMemoryManager.h>
@@ -21,12 +23,15 @@
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "cinn/backends/llvm/codegen_x86.h"
@@ -41,14 +46,21 @@ class NaiveObjectCache : public llvm::ObjectCache {
   std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override;
 
  private:
+  //! The modules might be compiled concurrently.
+  std::mutex mu_;
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> cached_objects_;
 };
 
 struct ExecutionOptions {
   int opt_level{3};
   bool enable_debug_info{false};
+  //! Optimize and compile each function on its first call instead of the whole module in Link.
+  bool lazy_compile{false};
+  //! In the lazy mode, compile the functions not called yet on a background thread after Link.
+  bool background_compile{true};
+  //! The number of threads to optimize and compile with, the modules are split by function when it is larger than 1.
+  int num_compile_threads{1};
   // TODO(fc500110)
-  // int num_compile_threads{1};
   // bool enable_fast_math;
 };
 
@@ -63,19 +75,58 @@ class ExecutionEngine {
 
   bool AddModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context);
 
+  /**
+   * Add a module whose functions get optimized and compiled on their first call, only valid in the lazy mode.
+   *
+   * The module is split by function into the implementation JITDylib of the engine, the main JITDylib gets the lazy
+   * reexports of the functions, whose stubs compile the function on the first call.
+   */
+  bool AddLazyModule(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context);
+
+  ~ExecutionEngine();
+
  protected:
   explicit ExecutionEngine(bool enable_object_cache) : cache_(std::make_unique<NaiveObjectCache>()) {}
 
-  void RegisterRuntimeSymbols();
+  //! Define the runtime symbols in \p dylib.
+  void RegisterRuntimeSymbols(llvm::orc::JITDylib *dylib);
+
+  //! Compile the functions called \p fn_names of a lazy module ahead of their first call.
+  void CompileInBackground(std::vector<std::string> fn_names);
+
+  //! Optimize and compile the parts of a split module on `num_compile_threads` threads.
+  void OptimizeAndCompileParallel(std::vector<llvm::orc::ThreadSafeModule> parts);
 
   bool SetupTargetTriple(llvm::Module *module);
 
+  //! Run the LLVM optimization passes on \p m with a host TargetMachine of the engine.
+  void OptimizeModule(llvm::Module *m);
+
+  /**
+   * Take a host TargetMachine, a new one is created only when all the created ones are in use. A TargetMachine is
+   * costly to create and not safe to share among threads, so each engine keeps the ones it created for reuse.
+   */
+  std::unique_ptr<llvm::TargetMachine> AcquireTargetMachine();
+  void ReleaseTargetMachine(std::unique_ptr<llvm::TargetMachine> machine);
+
   friend std::unique_ptr<ExecutionEngine> std::make_unique<ExecutionEngine>(bool &&);
 
  private:
   mutable std::mutex mu_;
+  //! Declared before jit_ to outlive the compilations in flight when the engine is destroyed.
+  std::mutex machines_mu_;
+  std::vector<std::unique_ptr<llvm::TargetMachine>> machines_;
+  //! The lazy mode only, the stubs of the lazy reexports, they are declared before jit_ to outlive its JITDylibs.
+  std::unique_ptr<llvm::orc::LazyCallThroughManager> lazy_call_through_;
+  std::unique_ptr<llvm::orc::IndirectStubsManager> indirect_stubs_;
   std::unique_ptr<llvm::orc::LLJIT> jit_;
+  //! The JITDylib holding the functions of the lazy modules in the lazy mode, null otherwise.
+  llvm::orc::JITDylib *impl_dylib_{};
   std::unique_ptr<NaiveObjectCache> cache_;
+  ExecutionOptions options_;
+
+  std::vector<std::thread> background_compile_threads_;
+  std::atomic<bool> stop_background_compile_{false};
 };
 
 }  // namespace cinn::backends
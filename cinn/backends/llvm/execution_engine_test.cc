@@ -7,6 +7,7 @@
 #include <llvm/IR/Argument.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
@@ -24,6 +25,7 @@
 
 #include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
+#include "cinn/backends/llvm/runtime_llvm_module.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/cinn.h"
 #include "cinn/ir/ir.h"
@@ -35,6 +37,7 @@
 #include "cinn/optim/optimize.h"
 #include "cinn/runtime/cpu/host_intrinsics.h"
 #include "cinn/runtime/cpu/use_extern_funcs.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace backends {
@@ -302,5 +305,141 @@ TEST(ExecutionEngine, call_extern) {
   }
 }
 
+namespace {
+//! Create a module with two functions: add and mul.
+ir::Module CreateAddMulModule() {
+  ir::Expr M(kM);
+  ir::Expr N(kN);
+
+  Placeholder<float> x("x", {M, N});
+  Placeholder<float> y("y", {M, N});
+
+  Module::Builder builder("module0", common::DefaultHostTarget());
+  {
+    auto add_out = Compute(
+        {M, N}, [=](Var i, Var j) { return x(i, j) + y(i, j); }, "add_out");
+    auto stages = CreateStages({add_out});
+    builder.AddFunction(Lower("add", stages, {x, y, add_out}));
+  }
+  {
+    auto mul_out = Compute(
+        {M, N}, [=](Var i, Var j) { return x(i, j) * y(i, j); }, "mul_out");
+    auto stages = CreateStages({mul_out});
+    builder.AddFunction(Lower("mul", stages, {x, y, mul_out}));
+  }
+  return builder.Build();
+}
+
+void CheckAddMul(ExecutionEngine *engine) {
+  auto [ab, bb, cb] = CreateTestBuffer();  // NOLINT
+  cinn_pod_value_t a_arg(ab), b_arg(bb), c_arg(cb);
+  cinn_pod_value_t args[3] = {a_arg, b_arg, c_arg};
+
+  auto add = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("add"));
+  auto mul = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("mul"));
+  ASSERT_TRUE(add && mul);
+
+  auto *ad = reinterpret_cast<float *>(ab->memory);
+  auto *bd = reinterpret_cast<float *>(bb->memory);
+  auto *cd = reinterpret_cast<float *>(cb->memory);
+
+  add(args, 3);
+  for (int i = 0; i < kM * kN; i++) {
+    ASSERT_NEAR(cd[i], ad[i] + bd[i], 1e-5);
+  }
+  mul(args, 3);
+  for (int i = 0; i < kM * kN; i++) {
+    ASSERT_NEAR(cd[i], ad[i] * bd[i], 1e-5);
+  }
+}
+}  // namespace
+
+TEST(ExecutionEngine, lazy_compile) {
+  auto module = CreateAddMulModule();
+  for (bool background_compile : {false, true}) {
+    ExecutionOptions options;
+    options.lazy_compile       = true;
+    options.background_compile = background_compile;
+    auto engine                = backends::ExecutionEngine::Create(options);
+    engine->Link(module);
+    CheckAddMul(engine.get());
+  }
+}
+
+TEST(ExecutionEngine, lazy_compile_on_first_call) {
+  auto module   = CreateAddMulModule();
+  auto &profile = utils::CompileProfiler::Global();
+  bool enabled  = profile.enabled();
+  profile.set_enabled(true);
+  profile.Clear();
+  // Each function is optimized right before it gets compiled.
+  auto num_compiled = [&] { return profile.GetPhase("-", "llvm.optimize").calls; };
+
+  ExecutionOptions options;
+  options.lazy_compile       = true;
+  options.background_compile = false;
+  auto engine                = backends::ExecutionEngine::Create(options);
+  engine->Link(module);
+
+  auto [ab, bb, cb] = CreateTestBuffer();  // NOLINT
+  cinn_pod_value_t a_arg(ab), b_arg(bb), c_arg(cb);
+  cinn_pod_value_t args[3] = {a_arg, b_arg, c_arg};
+  auto add = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("add"));
+  auto mul = reinterpret_cast<void (*)(void *, int32_t)>(engine->Lookup("mul"));
+  ASSERT_TRUE(add && mul);
+  // Looking up a function only emits its stub.
+  EXPECT_EQ(num_compiled(), 0);
+
+  add(args, 3);
+  int64_t compiled_after_add = num_compiled();
+  EXPECT_GT(compiled_after_add, 0);
+  // The unused mul is compiled on its own first call.
+  mul(args, 3);
+  EXPECT_GT(num_compiled(), compiled_after_add);
+
+  profile.Clear();
+  profile.set_enabled(enabled);
+}
+
+TEST(ExecutionEngine, multi_thread_compile) {
+  auto module = CreateAddMulModule();
+  for (int num_threads : {2, 4}) {
+    ExecutionOptions options;
+    options.num_compile_threads = num_threads;
+    auto engine                 = backends::ExecutionEngine::Create(options);
+    engine->Link(module);
+    CheckAddMul(engine.get());
+  }
+}
+
+TEST(ExecutionEngine, runtime_bitcode) {
+  llvm::LLVMContext ctx;
+  llvm::SMDiagnostic error;
+  auto text_module = llvm::parseAssemblyString(AsStringRef(kRuntimeLlvmIr), error, ctx);
+  auto m           = LoadRuntimeLlvmModule(&ctx);
+  ASSERT_TRUE(text_module && m);
+
+  // The bitcode holds the same functions, with the bodies not loaded yet.
+  for (auto &fn : *text_module) {
+    auto *loaded = m->getFunction(fn.getName());
+    ASSERT_TRUE(loaded) << fn.getName().str();
+    ASSERT_EQ(loaded->isDeclaration(), fn.isDeclaration());
+    ASSERT_EQ(loaded->isMaterializable(), !fn.isDeclaration());
+  }
+
+  // Call one runtime function, only it and the functions it calls are kept.
+  auto *malloc_fn = m->getFunction("cinn_buffer_malloc");
+  ASSERT_TRUE(malloc_fn);
+  auto *caller = llvm::Function::Create(
+      malloc_fn->getFunctionType(), llvm::Function::ExternalLinkage, "call_cinn_buffer_malloc", m.get());
+  llvm::IRBuilder<> b(llvm::BasicBlock::Create(ctx, "entry", caller));
+  b.CreateRet(b.CreateCall(malloc_fn, {caller->getArg(0), caller->getArg(1)}));
+
+  MaterializeRuntimeFunctions(m.get());
+  ASSERT_FALSE(llvm::verifyModule(*m, &llvm::errs()));
+  ASSERT_FALSE(malloc_fn->isDeclaration());
+  ASSERT_FALSE(m->getFunction("cinn_buffer_copy"));
+}
+
 }  // namespace backends
 }  // namespace cinn
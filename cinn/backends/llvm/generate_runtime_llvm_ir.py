@@ -7,6 +7,7 @@ import subprocess
 def main():
     path = sys.argv[1]
     out_path = sys.argv[2]
+    bitcode_path = sys.argv[3]
 
     srcs = []
     srcs.append('#include <string_view>')
@@ -20,6 +21,21 @@ def main():
     srcs.append(')ROC"')
     srcs.append(');\n')
 
+    # The same module as bitcode, which loads much faster than parsing the text above.
+    with open(bitcode_path, 'rb') as fr:
+        bitcode = fr.read()
+    srcs.append("alignas(4) inline constexpr unsigned char kRuntimeLlvmBitcodeData[] = {")
+    for i in range(0, len(bitcode), 16):
+        srcs.append("  " + ", ".join(
+            f"0x{b:02x}" for b in bitcode[i:i + 16]) + ",")
+    srcs.append("};")
+    srcs.append(
+        "inline const std::string_view kRuntimeLlvmBitcode(reinterpret_cast<const char *>(kRuntimeLlvmBitcodeData),"
+    )
+    srcs.append(
+        "                                                  sizeof(kRuntimeLlvmBitcodeData));\n"
+    )
+
     cmd = "llvm-config --version"
     version = subprocess.check_output(
         cmd, shell=True).decode('utf-8').strip().split('.')
@@ -0,0 +1,86 @@
+#include "cinn/backends/llvm/llvm_module_split.h"
+
+#include <glog/logging.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace cinn::backends {
+
+namespace {
+
+//! Move \p m to a new LLVMContext by a bitcode round trip.
+llvm::orc::ThreadSafeModule MoveToNewContext(const llvm::Module &m) {
+  llvm::SmallVector<char, 0> buffer;
+  llvm::raw_svector_ostream os(buffer);
+  llvm::WriteBitcodeToFile(m, os);
+
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::MemoryBufferRef buffer_ref(llvm::StringRef(buffer.data(), buffer.size()), m.getModuleIdentifier());
+  auto module = llvm::parseBitcodeFile(buffer_ref, *context);
+  CHECK(module) << "Failed to reload the module part: " << llvm::toString(module.takeError());
+  return llvm::orc::ThreadSafeModule(std::move(*module), std::move(context));
+}
+
+}  // namespace
+
+std::vector<llvm::orc::ThreadSafeModule> SplitModuleByFunctions(const llvm::Module &m,
+                                                                const std::vector<std::string> &fn_names,
+                                                                int num_parts,
+                                                                bool shared_part) {
+  CHECK_GT(num_parts, 0);
+  num_parts = std::max(1, std::min<int>(num_parts, fn_names.size() + shared_part));
+  CHECK(!shared_part || fn_names.empty() || num_parts > 1) << "The shared part needs another part for the functions";
+
+  // The part each lowered function belongs to, assigned round-robin.
+  std::unordered_map<std::string, int> fn_part;
+  for (int i = 0; i < fn_names.size(); i++) {
+    fn_part[fn_names[i]] = shared_part ? i % (num_parts - 1) + 1 : i % num_parts;
+  }
+
+  std::vector<llvm::orc::ThreadSafeModule> parts;
+  for (int part = 0; part < num_parts; part++) {
+    llvm::ValueToValueMapTy vmap;
+    auto cloned = llvm::CloneModule(m, vmap, [&](const llvm::GlobalValue *gv) {
+      auto it = fn_part.find(gv->getName().str());
+      if (it != fn_part.end()) return it->second == part;
+      // The local values can not be referenced across modules, copy them to every part.
+      return part == 0 || gv->hasLocalLinkage() || llvm::isa<llvm::Function>(gv);
+    });
+
+    if (part == 0) {
+      // The other parts may reference the linkonce definitions, keep them even if they get unused here.
+      for (auto &gv : cloned->global_values()) {
+        if (gv.hasLinkOnceLinkage()) {
+          gv.setLinkage(gv.hasLinkOnceODRLinkage() ? llvm::GlobalValue::WeakODRLinkage
+                                                   : llvm::GlobalValue::WeakAnyLinkage);
+        }
+      }
+    } else {
+      for (auto &fn : *cloned) {
+        if (!fn.isDeclaration() && !fn.hasLocalLinkage() && !fn_part.count(fn.getName().str())) {
+          fn.setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+          fn.setComdat(nullptr);
+        }
+      }
+    }
+
+    cloned->setModuleIdentifier(m.getModuleIdentifier() + ".part" + std::to_string(part));
+    parts.push_back(MoveToNewContext(*cloned));
+  }
+  return parts;
+}
+
+}  // namespace cinn::backends
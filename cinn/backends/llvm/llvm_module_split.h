@@ -0,0 +1,28 @@
+#pragma once
+
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/Module.h>
+
+#include <string>
+#include <vector>
+
+namespace cinn::backends {
+
+/**
+ * Split a module into parts that can be optimized and compiled concurrently.
+ *
+ * The functions called \p fn_names (the CINN lowered functions) are distributed among at most \p num_parts parts. All
+ * the other definitions (the runtime functions and globals) live in the first part, the other parts get copies of the
+ * runtime functions as `available_externally`, so they can still be inlined there without being emitted twice.
+ *
+ * Each part owns its LLVMContext, so the parts share no state.
+ *
+ * If \p shared_part is true, the first part only holds the other definitions and none of \p fn_names, so compiling
+ * a function never compiles another one of \p fn_names with it.
+ */
+std::vector<llvm::orc::ThreadSafeModule> SplitModuleByFunctions(const llvm::Module &m,
+                                                                const std::vector<std::string> &fn_names,
+                                                                int num_parts,
+                                                                bool shared_part = false);
+
+}  // namespace cinn::backends
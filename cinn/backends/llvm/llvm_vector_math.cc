@@ -0,0 +1,237 @@
+#include "cinn/backends/llvm/llvm_vector_math.h"
+
+#include <glog/logging.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Intrinsics.h>
+
+#include <limits>
+
+DEFINE_int32(cinn_llvm_vector_math_max_ulp,
+             4,
+             "The max ULP error allowed in the vector math library, larger values select the faster approximations");
+
+namespace cinn {
+namespace backends {
+
+VectorMathAccuracy GetVectorMathAccuracy() {
+  return FLAGS_cinn_llvm_vector_math_max_ulp > 4 ? VectorMathAccuracy::kFast : VectorMathAccuracy::kHigh;
+}
+
+llvm::Value *VectorMathEmitter::Emit(const std::string &name, llvm::Value *x) {
+  if (name == "exp") return Exp(x);
+  if (name == "log") return Log(x);
+  if (name == "tanh") return Tanh(x);
+  if (name == "erf") return Erf(x);
+  return nullptr;
+}
+
+llvm::Value *VectorMathEmitter::FloatConst(llvm::Type *type, double v) { return llvm::ConstantFP::get(type, v); }
+
+llvm::Value *VectorMathEmitter::IntConst(llvm::Type *type, int v) { return llvm::ConstantInt::get(type, v, true); }
+
+llvm::Type *VectorMathEmitter::IntTypeOf(llvm::Type *type) {
+  if (auto *vec_type = llvm::dyn_cast<llvm::VectorType>(type)) {
+    return llvm::VectorType::getInteger(vec_type);
+  }
+  return b_->getInt32Ty();
+}
+
+llvm::Value *VectorMathEmitter::FMA(llvm::Value *a, llvm::Value *b, llvm::Value *c) {
+  // fmuladd lets the backend fuse the operations when the target has FMA units.
+  return b_->CreateIntrinsic(llvm::Intrinsic::fmuladd, {a->getType()}, {a, b, c});
+}
+
+llvm::Value *VectorMathEmitter::Horner(llvm::Value *x, std::initializer_list<double> coeffs) {
+  CHECK_GE(coeffs.size(), 1UL);
+  auto it          = coeffs.begin();
+  llvm::Value *res = FloatConst(x->getType(), *it++);
+  for (; it != coeffs.end(); ++it) {
+    res = FMA(res, x, FloatConst(x->getType(), *it));
+  }
+  return res;
+}
+
+llvm::Value *VectorMathEmitter::Ldexp(llvm::Value *x, llvm::Value *n) {
+  // Split the scale into two factors so that both of them are normal floats, this keeps the denormal and the
+  // near-overflow results exact.
+  llvm::Type *int_type = n->getType();
+  llvm::Value *n0      = b_->CreateAShr(n, IntConst(int_type, 1));
+  llvm::Value *n1      = b_->CreateSub(n, n0);
+  auto pow2            = [&](llvm::Value *e) {
+    llvm::Value *bits = b_->CreateShl(b_->CreateAdd(e, IntConst(int_type, 127)), IntConst(int_type, 23));
+    return b_->CreateBitCast(bits, x->getType());
+  };
+  return b_->CreateFMul(b_->CreateFMul(x, pow2(n0)), pow2(n1));
+}
+
+llvm::Value *VectorMathEmitter::KeepNaN(llvm::Value *x, llvm::Value *res) {
+  return b_->CreateSelect(b_->CreateFCmpUNO(x, x), x, res);
+}
+
+llvm::Value *VectorMathEmitter::Exp(llvm::Value *x) {
+  llvm::Type *type = x->getType();
+  // exp(x) = 2^n * exp(r), n = round(x / ln2), |r| <= ln2 / 2.
+  llvm::Value *xc = b_->CreateMinNum(x, FloatConst(type, 88.7228393554687500));
+  xc              = b_->CreateMaxNum(xc, FloatConst(type, -104.0));
+  llvm::Value *fx = b_->CreateUnaryIntrinsic(
+      llvm::Intrinsic::floor, FMA(xc, FloatConst(type, 1.44269504088896341), FloatConst(type, 0.5)));
+  // ln2 is split into two parts so that r is computed without rounding error.
+  llvm::Value *r = FMA(fx, FloatConst(type, -0.693359375), xc);
+  r              = FMA(fx, FloatConst(type, 2.12194440e-4), r);
+  llvm::Value *z = b_->CreateFMul(r, r);
+
+  llvm::Value *y{};
+  if (accuracy_ == VectorMathAccuracy::kHigh) {
+    y = Horner(
+        r, {1.9875691500E-4, 1.3981999507E-3, 8.3334519073E-3, 4.1665795894E-2, 1.6666665459E-1, 5.0000001201E-1});
+  } else {
+    y = Horner(r, {4.1665795894E-2, 1.6666665459E-1, 5.0000001201E-1});
+  }
+  y = FMA(y, z, r);
+  y = b_->CreateFAdd(y, FloatConst(type, 1.0));
+
+  llvm::Value *res = Ldexp(y, b_->CreateFPToSI(fx, IntTypeOf(type)));
+  res              = b_->CreateSelect(b_->CreateFCmpOGT(x, FloatConst(type, 88.7228393554687500)),
+                         FloatConst(type, std::numeric_limits<float>::infinity()),
+                         res);
+  return KeepNaN(x, res);
+}
+
+llvm::Value *VectorMathEmitter::Log(llvm::Value *x) {
+  llvm::Type *type     = x->getType();
+  llvm::Type *int_type = IntTypeOf(type);
+
+  // Scale the denormal inputs into the normal range first.
+  llvm::Value *is_denormal = b_->CreateFCmpOLT(x, FloatConst(type, std::numeric_limits<float>::min()));
+  llvm::Value *xs          = b_->CreateSelect(is_denormal, b_->CreateFMul(x, FloatConst(type, 8388608.0)), x);
+  llvm::Value *e_bias      = b_->CreateSelect(is_denormal, FloatConst(type, -23.0), FloatConst(type, 0.0));
+
+  // x = m * 2^e, m in [0.5, 1).
+  llvm::Value *bits = b_->CreateBitCast(xs, int_type);
+  llvm::Value *e    = b_->CreateSub(b_->CreateLShr(bits, IntConst(int_type, 23)), IntConst(int_type, 126));
+  llvm::Value *fe   = b_->CreateFAdd(b_->CreateSIToFP(e, type), e_bias);
+  llvm::Value *m    = b_->CreateOr(b_->CreateAnd(bits, IntConst(int_type, 0x007fffff)), IntConst(int_type, 0x3f000000));
+  m                 = b_->CreateBitCast(m, type);
+
+  // Shift m into [sqrt(0.5), sqrt(2)) and take f = m - 1.
+  llvm::Value *small = b_->CreateFCmpOLT(m, FloatConst(type, 0.707106781186547524));
+  fe                 = b_->CreateFSub(fe, b_->CreateSelect(small, FloatConst(type, 1.0), FloatConst(type, 0.0)));
+  llvm::Value *f = b_->CreateFAdd(b_->CreateFSub(m, FloatConst(type, 1.0)),
+                                  b_->CreateSelect(small, m, FloatConst(type, 0.0)));
+
+  llvm::Value *res{};
+  if (accuracy_ == VectorMathAccuracy::kHigh) {
+    llvm::Value *z = b_->CreateFMul(f, f);
+    llvm::Value *y = Horner(f,
+                            {7.0376836292E-2,
+                             -1.1514610310E-1,
+                             1.1676998740E-1,
+                             -1.2420140846E-1,
+                             1.4249322787E-1,
+                             -1.6668057665E-1,
+                             2.0000714765E-1,
+                             -2.4999993993E-1,
+                             3.3333331174E-1});
+    y              = b_->CreateFMul(b_->CreateFMul(y, f), z);
+    y              = FMA(fe, FloatConst(type, -2.12194440e-4), y);
+    y              = FMA(z, FloatConst(type, -0.5), y);
+    res            = b_->CreateFAdd(f, y);
+    res            = FMA(fe, FloatConst(type, 0.693359375), res);
+  } else {
+    // log(1 + f) = 2 * atanh(s), s = f / (2 + f).
+    llvm::Value *s  = b_->CreateFDiv(f, b_->CreateFAdd(f, FloatConst(type, 2.0)));
+    llvm::Value *s2 = b_->CreateFMul(s, s);
+    llvm::Value *y  = Horner(s2, {0.4, 0.666666666666666667, 2.0});
+    res             = FMA(fe, FloatConst(type, 0.693147180559945309), b_->CreateFMul(s, y));
+  }
+
+  res = b_->CreateSelect(b_->CreateFCmpOEQ(x, FloatConst(type, std::numeric_limits<float>::infinity())), x, res);
+  res = b_->CreateSelect(b_->CreateFCmpOEQ(x, FloatConst(type, 0.0)),
+                         FloatConst(type, -std::numeric_limits<float>::infinity()),
+                         res);
+  // log of the negative values and NaN.
+  return b_->CreateSelect(b_->CreateFCmpULT(x, FloatConst(type, 0.0)),
+                          FloatConst(type, std::numeric_limits<float>::quiet_NaN()),
+                          res);
+}
+
+llvm::Value *VectorMathEmitter::FastTanh(llvm::Value *x) {
+  // The rational approximation used by Eigen, the result saturates to +-1 beyond the clamp point.
+  llvm::Type *type = x->getType();
+  llvm::Value *xc = b_->CreateMinNum(x, FloatConst(type, 7.90531110763549805));
+  xc              = b_->CreateMaxNum(xc, FloatConst(type, -7.90531110763549805));
+  llvm::Value *x2 = b_->CreateFMul(xc, xc);
+  llvm::Value *p  = Horner(x2,
+                          {-2.76076847742355e-16,
+                           2.00018790482477e-13,
+                           -8.60467152213735e-11,
+                           5.12229709037114e-08,
+                           1.48572235717979e-05,
+                           6.37261928875436e-04,
+                           4.89352455891786e-03});
+  p               = b_->CreateFMul(p, xc);
+  llvm::Value *q =
+      Horner(x2, {1.19825839466702e-06, 1.18534705686654e-04, 2.26843463243900e-03, 4.89352518554385e-03});
+  llvm::Value *res  = b_->CreateFDiv(p, q);
+  llvm::Value *tiny = b_->CreateFCmpOLT(b_->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, x), FloatConst(type, 0.0004));
+  return KeepNaN(x, b_->CreateSelect(tiny, x, res));
+}
+
+llvm::Value *VectorMathEmitter::Tanh(llvm::Value *x) {
+  if (accuracy_ == VectorMathAccuracy::kFast) return FastTanh(x);
+
+  llvm::Type *type = x->getType();
+  llvm::Value *a   = b_->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, x);
+
+  // |x| < 0.625: odd polynomial.
+  llvm::Value *z = b_->CreateFMul(x, x);
+  llvm::Value *p =
+      Horner(z, {-5.70498872745E-3, 2.06390887954E-2, -5.37397155531E-2, 1.33314422036E-1, -3.33332819422E-1});
+  llvm::Value *small_res = FMA(b_->CreateFMul(p, z), x, x);
+
+  // |x| >= 0.625: tanh(|x|) = 1 - 2 / (exp(2|x|) + 1).
+  llvm::Value *e         = Exp(b_->CreateFAdd(a, a));
+  llvm::Value *large_res = b_->CreateFSub(
+      FloatConst(type, 1.0), b_->CreateFDiv(FloatConst(type, 2.0), b_->CreateFAdd(e, FloatConst(type, 1.0))));
+  large_res = b_->CreateBinaryIntrinsic(llvm::Intrinsic::copysign, large_res, x);
+
+  return b_->CreateSelect(b_->CreateFCmpOLT(a, FloatConst(type, 0.625)), small_res, large_res);
+}
+
+llvm::Value *VectorMathEmitter::Erf(llvm::Value *x) {
+  llvm::Type *type = x->getType();
+  if (accuracy_ == VectorMathAccuracy::kFast) {
+    // Abramowitz and Stegun 7.1.27: erf(a) = 1 - 1 / (1 + a1*a + a2*a^2 + a3*a^3 + a4*a^4)^4.
+    llvm::Value *a   = b_->CreateUnaryIntrinsic(llvm::Intrinsic::fabs, x);
+    llvm::Value *t   = FMA(Horner(a, {0.078108, 0.000972, 0.230389, 0.278393}), a, FloatConst(type, 1.0));
+    llvm::Value *t2  = b_->CreateFMul(t, t);
+    llvm::Value *res = b_->CreateFSub(FloatConst(type, 1.0),
+                                      b_->CreateFDiv(FloatConst(type, 1.0), b_->CreateFMul(t2, t2)));
+    return KeepNaN(x, b_->CreateBinaryIntrinsic(llvm::Intrinsic::copysign, res, x));
+  }
+
+  // The rational approximation used by Eigen, erf(x) saturates to +-1 beyond |x| = 4.
+  llvm::Value *xc = b_->CreateMinNum(x, FloatConst(type, 4.0));
+  xc              = b_->CreateMaxNum(xc, FloatConst(type, -4.0));
+  llvm::Value *x2 = b_->CreateFMul(xc, xc);
+  llvm::Value *p  = Horner(x2,
+                          {-2.72614225801306e-10,
+                           2.77068142495902e-08,
+                           -2.10102402082508e-06,
+                           -5.69250639462346e-05,
+                           -7.34990630326855e-04,
+                           -2.95459980854025e-03,
+                           -1.60960333262415e-02});
+  p               = b_->CreateFMul(p, xc);
+  llvm::Value *q  = Horner(x2,
+                          {-1.45660718464996e-05,
+                           -2.13374055278905e-04,
+                           -1.68282697438203e-03,
+                           -7.37332916720468e-03,
+                           -1.42647390514189e-02});
+  return KeepNaN(x, b_->CreateFDiv(p, q));
+}
+
+}  // namespace backends
+}  // namespace cinn
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <gflags/gflags.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Value.h>
+
+#include <initializer_list>
+#include <string>
+
+#include "cinn/ir/ir.h"
+
+DECLARE_int32(cinn_llvm_vector_math_max_ulp);
+
+namespace cinn {
+namespace backends {
+
+/**
+ * The accuracy tiers of the vector math library.
+ *
+ * - kHigh: minimax approximations (from Cephes and Eigen), within 2 ULP for exp, log and tanh, and about 3 ULP for erf.
+ * - kFast: lower degree approximations, relative error below 1e-4 for exp, log and tanh, absolute error below 5e-4 for
+ *   erf.
+ */
+enum class VectorMathAccuracy { kHigh, kFast };
+
+//! Get the accuracy tier selected by the flag `cinn_llvm_vector_math_max_ulp`.
+VectorMathAccuracy GetVectorMathAccuracy();
+
+/**
+ * Emit SIMD polynomial approximations of the transcendental functions in LLVM IR.
+ *
+ * The emitted code is inlined into the loop body, so it fuses with the surrounding computation instead of calling an
+ * extern per element or per buffer. All the methods work lane-wise on both `float` and `<N x float>` values, so the
+ * same code serves 256-bit (N = 8) and 512-bit (N = 16) vectors.
+ */
+class VectorMathEmitter {
+ public:
+  VectorMathEmitter(llvm::IRBuilder<> *b, VectorMathAccuracy accuracy) : b_(b), accuracy_(accuracy) {}
+
+  //! Emit the function called \p name over \p x, returns nullptr if \p name is not supported.
+  llvm::Value *Emit(const std::string &name, llvm::Value *x);
+
+  llvm::Value *Exp(llvm::Value *x);
+  llvm::Value *Log(llvm::Value *x);
+  llvm::Value *Tanh(llvm::Value *x);
+  llvm::Value *Erf(llvm::Value *x);
+
+ private:
+  llvm::Value *FloatConst(llvm::Type *type, double v);
+  llvm::Value *IntConst(llvm::Type *type, int v);
+  //! The integer type with the same shape as the float type \p type.
+  llvm::Type *IntTypeOf(llvm::Type *type);
+
+  llvm::Value *FMA(llvm::Value *a, llvm::Value *b, llvm::Value *c);
+  //! Evaluate the polynomial with \p coeffs (highest degree first) at \p x.
+  llvm::Value *Horner(llvm::Value *x, std::initializer_list<double> coeffs);
+  //! Compute x * 2^n, \p n is an integer vector in the range [-150, 128].
+  llvm::Value *Ldexp(llvm::Value *x, llvm::Value *n);
+  //! Propagate the NaN lanes of \p x to \p res.
+  llvm::Value *KeepNaN(llvm::Value *x, llvm::Value *res);
+
+  llvm::Value *FastTanh(llvm::Value *x);
+
+  llvm::IRBuilder<> *b_{};
+  VectorMathAccuracy accuracy_;
+};
+
+}  // namespace backends
+}  // namespace cinn
@@ -0,0 +1,139 @@
+#include "cinn/backends/llvm/llvm_vector_math.h"
+
+#include <gtest/gtest.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/backends/llvm/execution_engine.h"
+
+namespace cinn {
+namespace backends {
+
+namespace {
+
+using vector_fn_t = void (*)(const float *, float *);
+
+/**
+ * Create a function `void name(const float* x, float* out)` that computes \p lanes elements with one vector call of
+ * the math library.
+ */
+void CreateVectorFunction(llvm::Module *m,
+                          const std::string &fn_name,
+                          const std::string &math_fn,
+                          int lanes,
+                          VectorMathAccuracy accuracy) {
+  auto &ctx         = m->getContext();
+  auto *float_p_ty  = llvm::Type::getFloatPtrTy(ctx);
+  auto *vec_ty      = llvm::VectorType::get(llvm::Type::getFloatTy(ctx), lanes);
+  auto *fn_ty       = llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {float_p_ty, float_p_ty}, false);
+  llvm::Function *f = llvm::Function::Create(fn_ty, llvm::Function::ExternalLinkage, fn_name, m);
+
+  llvm::IRBuilder<> b(llvm::BasicBlock::Create(ctx, "entry", f));
+  llvm::Value *x_ptr   = b.CreateBitCast(f->getArg(0), vec_ty->getPointerTo());
+  llvm::Value *out_ptr = b.CreateBitCast(f->getArg(1), vec_ty->getPointerTo());
+  llvm::Value *x       = b.CreateAlignedLoad(vec_ty, x_ptr, llvm::MaybeAlign(4));
+
+  llvm::Value *res = VectorMathEmitter(&b, accuracy).Emit(math_fn, x);
+  ASSERT_TRUE(res);
+  b.CreateAlignedStore(res, out_ptr, llvm::MaybeAlign(4));
+  b.CreateRetVoid();
+}
+
+struct MathCase {
+  std::string name;
+  std::function<double(double)> ref;
+  float lo;
+  float hi;
+};
+
+std::vector<MathCase> MathCases() {
+  return {
+      {"exp", [](double x) { return std::exp(x); }, -80.f, 80.f},
+      {"log", [](double x) { return std::log(x); }, 1e-6f, 1e6f},
+      {"tanh", [](double x) { return std::tanh(x); }, -10.f, 10.f},
+      {"erf", [](double x) { return std::erf(x); }, -5.f, 5.f},
+  };
+}
+
+void TestAccuracy(VectorMathAccuracy accuracy, int lanes, double rtol, double atol) {
+  auto engine = ExecutionEngine::Create({1});
+  auto ctx    = std::make_unique<llvm::LLVMContext>();
+  auto m      = std::make_unique<llvm::Module>("vector_math", *ctx);
+  for (auto &c : MathCases()) {
+    CreateVectorFunction(m.get(), c.name + "_v", c.name, lanes, accuracy);
+  }
+  ASSERT_FALSE(llvm::verifyModule(*m, &llvm::errs()));
+  engine->AddModule(std::move(m), std::move(ctx));
+
+  const int kNumVectors = 1024;
+  for (auto &c : MathCases()) {
+    auto fn = reinterpret_cast<vector_fn_t>(engine->Lookup(c.name + "_v"));
+    ASSERT_TRUE(fn);
+
+    std::vector<float> x(lanes), out(lanes);
+    for (int i = 0; i < kNumVectors; i++) {
+      for (int j = 0; j < lanes; j++) {
+        float t = static_cast<float>(i * lanes + j) / (kNumVectors * lanes - 1);
+        // sample log on a log scale.
+        x[j] = c.name == "log" ? c.lo * std::pow(c.hi / c.lo, t) : c.lo + (c.hi - c.lo) * t;
+      }
+      fn(x.data(), out.data());
+      for (int j = 0; j < lanes; j++) {
+        double expect = c.ref(x[j]);
+        EXPECT_NEAR(out[j], expect, atol + rtol * std::abs(expect)) << c.name << "(" << x[j] << ")";
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(VectorMathEmitter, high_accuracy_256bit) { TestAccuracy(VectorMathAccuracy::kHigh, 8, 5e-7, 1e-37); }
+
+TEST(VectorMathEmitter, high_accuracy_512bit) { TestAccuracy(VectorMathAccuracy::kHigh, 16, 5e-7, 1e-37); }
+
+TEST(VectorMathEmitter, fast_512bit) { TestAccuracy(VectorMathAccuracy::kFast, 16, 1e-4, 5e-4); }
+
+TEST(VectorMathEmitter, special_values) {
+  auto engine = ExecutionEngine::Create({1});
+  auto ctx    = std::make_unique<llvm::LLVMContext>();
+  auto m      = std::make_unique<llvm::Module>("vector_math", *ctx);
+  CreateVectorFunction(m.get(), "exp_v", "exp", 8, VectorMathAccuracy::kHigh);
+  CreateVectorFunction(m.get(), "log_v", "log", 8, VectorMathAccuracy::kHigh);
+  engine->AddModule(std::move(m), std::move(ctx));
+
+  auto exp_v = reinterpret_cast<vector_fn_t>(engine->Lookup("exp_v"));
+  auto log_v = reinterpret_cast<vector_fn_t>(engine->Lookup("log_v"));
+
+  const float inf = INFINITY;
+  std::vector<float> x({-inf, -200.f, 0.f, 89.f, inf, NAN, 1.f, -1.f});
+  std::vector<float> out(8);
+
+  exp_v(x.data(), out.data());
+  EXPECT_EQ(out[0], 0.f);
+  EXPECT_EQ(out[1], 0.f);
+  EXPECT_EQ(out[2], 1.f);
+  EXPECT_EQ(out[3], inf);
+  EXPECT_EQ(out[4], inf);
+  EXPECT_TRUE(std::isnan(out[5]));
+
+  log_v(x.data(), out.data());
+  EXPECT_TRUE(std::isnan(out[0]));
+  EXPECT_EQ(out[2], -inf);
+  EXPECT_EQ(out[4], inf);
+  EXPECT_TRUE(std::isnan(out[5]));
+  EXPECT_EQ(out[6], 0.f);
+  EXPECT_TRUE(std::isnan(out[7]));
+}
+
+}  // namespace backends
+}  // namespace cinn
@@ -0,0 +1,53 @@
+#include "cinn/backends/llvm/runtime_llvm_module.h"
+
+#include <glog/logging.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/Function.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <utility>
+#include <vector>
+
+#include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
+#include "cinn/backends/llvm/llvm_util.h"
+
+namespace cinn::backends {
+
+std::unique_ptr<llvm::Module> LoadRuntimeLlvmModule(llvm::LLVMContext *ctx, std::string_view bitcode) {
+  if (bitcode.empty()) bitcode = kRuntimeLlvmBitcode;
+  // The lazy module keeps reading from the buffer, the embedded bitcode lives as long as the process.
+  llvm::MemoryBufferRef buffer(AsStringRef(bitcode), "cinn_runtime.bc");
+  auto m = llvm::getLazyBitcodeModule(buffer, *ctx);
+  if (!m) {
+    LOG(FATAL) << "Failed to load the runtime bitcode: " << llvm::toString(m.takeError());
+  }
+  return std::move(m.get());
+}
+
+void MaterializeRuntimeFunctions(llvm::Module *m) {
+  // A materialized body might reference more runtime functions, repeat until no function gets materialized.
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto &fn : *m) {
+      if (!fn.isMaterializable()) continue;
+      fn.removeDeadConstantUsers();
+      if (!fn.use_empty()) {
+        llvm::cantFail(fn.materialize());
+        changed = true;
+      }
+    }
+  }
+
+  std::vector<llvm::Function *> unused;
+  for (auto &fn : *m) {
+    if (fn.isMaterializable()) unused.push_back(&fn);
+  }
+  for (auto *fn : unused) {
+    fn->eraseFromParent();
+  }
+  VLOG(3) << "Dropped " << unused.size() << " unreferenced runtime functions";
+  llvm::cantFail(m->materializeAll());
+}
+
+}  // namespace cinn::backends
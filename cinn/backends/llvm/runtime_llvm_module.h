@@ -0,0 +1,27 @@
+#pragma once
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <memory>
+#include <string_view>
+
+namespace cinn::backends {
+
+/**
+ * Load the CINN runtime module from the bitcode \p bitcode, by default the one embedded at build time.
+ *
+ * Only the types, globals and function signatures are read, the function bodies are left to be materialized, so this
+ * is much cheaper than parsing the textual runtime IR. The module works as the base module of a code generator, call
+ * `MaterializeRuntimeFunctions` once the generation finished.
+ */
+std::unique_ptr<llvm::Module> LoadRuntimeLlvmModule(llvm::LLVMContext *ctx, std::string_view bitcode = {});
+
+/**
+ * Materialize the bodies of the runtime functions (transitively) referenced by the other functions of \p m and drop
+ * the unreferenced ones. The dropped functions are all defined in the cinn_runtime library too, so they still resolve
+ * by the process symbols in the JIT.
+ */
+void MaterializeRuntimeFunctions(llvm::Module *m);
+
+}  // namespace cinn::backends
@@ -19,9 +19,9 @@
 #include <utility>
 
 #include "cinn/backends/codegen_cuda_host.h"
-#include "cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "cinn/backends/llvm/codegen_llvm.h"
 #include "cinn/backends/llvm/llvm_util.h"
+#include "cinn/backends/llvm/runtime_llvm_module.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/runtime/intrinsic.h"
@@ -97,14 +97,13 @@ SimpleJIT::SimpleJIT() : context_(std::make_unique<llvm::LLVMContext>()) {
 
 template <typename CodeGenT>
 void SimpleJIT::Link(ir::Module module, bool optimize) {
-  std::string runtime_ir(backends::kRuntimeLlvmIr);
-  llvm::SMDiagnostic error;
-  auto m = llvm::parseAssemblyString(runtime_ir, error, context());
+  auto m = LoadRuntimeLlvmModule(&context());
   m->setDataLayout(jit_->getDataLayout());
   auto b = std::make_unique<llvm::IRBuilder<>>(context());
 
   auto ir_emitter = std::make_unique<CodeGenT>(m.get(), b.get());
   ir_emitter->Compile(module);
+  MaterializeRuntimeFunctions(m.get());
 
   CHECK(!llvm::verifyModule(*m, &llvm::errs())) << "Invalid module found";
 
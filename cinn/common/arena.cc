@@ -0,0 +1,133 @@
+#include "cinn/common/arena.h"
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "cinn/common/shared.h"
+
+namespace cinn {
+namespace common {
+
+namespace {
+
+thread_local ObjectArena* current_arena{};
+
+std::atomic<int64_t> num_arena_blocks{0};
+std::atomic<uint32_t> next_arena_id{1};
+
+//! The header at the beginning of a block.
+struct BlockHeader {
+  //! The number of the objects alive in the block, plus one while the arena holds it.
+  std::atomic<int64_t> num_live{1};
+  //! The end of the objects allocated, it is only accessed by the thread of the scope.
+  char* end{};
+};
+
+//! The header before each object, it is only accessed by the thread of the scope.
+struct ObjectHeader {
+  //! The function destroying the object, null if the object is not tracked by the arena.
+  void (*destroy)(void*);
+  uint32_t size;
+  //! The offset of the reference count in the object.
+  uint32_t ref_count_offset;
+};
+
+constexpr size_t kHeaderSize = ObjectArena::kAlignment;
+static_assert(sizeof(BlockHeader) <= kHeaderSize && sizeof(ObjectHeader) <= kHeaderSize, "");
+
+BlockHeader* GetBlock(void* p) {
+  auto begin = reinterpret_cast<uintptr_t>(p) & ~(static_cast<uintptr_t>(ObjectArena::kBlockSize) - 1);
+  return reinterpret_cast<BlockHeader*>(begin);
+}
+
+ObjectHeader* GetHeader(void* p) { return reinterpret_cast<ObjectHeader*>(static_cast<char*>(p) - kHeaderSize); }
+
+void ReleaseBlock(BlockHeader* block) {
+  if (block->num_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    block->~BlockHeader();
+    std::free(block);
+    num_arena_blocks.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+ObjectArena* ObjectArena::Current() { return current_arena; }
+
+ObjectArena::ObjectArena() {
+  // Zero is no arena, the ids wrap around after the arenas of 2^32 scopes have merged their counts.
+  do {
+    id_ = next_arena_id.fetch_add(1, std::memory_order_relaxed);
+  } while (!id_);
+}
+
+void* ObjectArena::Allocate(size_t size) {
+  size        = (size + kAlignment - 1) / kAlignment * kAlignment;
+  size_t need = kHeaderSize + size;
+  if (need > kBlockSize - kHeaderSize) return nullptr;
+
+  auto* block = blocks_.empty() ? nullptr : reinterpret_cast<BlockHeader*>(blocks_.back());
+  if (!block || block->end + need > blocks_.back() + kBlockSize) {
+    auto* begin = static_cast<char*>(std::aligned_alloc(kBlockSize, kBlockSize));
+    CHECK(begin) << "Failed to allocate an arena block";
+    block      = new (begin) BlockHeader;
+    block->end = begin + kHeaderSize;
+    blocks_.push_back(begin);
+    num_arena_blocks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  auto* header    = reinterpret_cast<ObjectHeader*>(block->end);
+  header->destroy = nullptr;
+  header->size    = size;
+  block->end += need;
+  block->num_live.fetch_add(1, std::memory_order_relaxed);
+  return header + 1;
+}
+
+void ObjectArena::Register(void* p, RefCount* ref_count, void (*destroy)(void*)) {
+  auto* header             = GetHeader(p);
+  header->destroy          = destroy;
+  header->ref_count_offset = reinterpret_cast<char*>(ref_count) - static_cast<char*>(p);
+  ref_count->Bias(id_);
+}
+
+void ObjectArena::Untrack(void* p) { GetHeader(p)->destroy = nullptr; }
+
+void ObjectArena::Free(void* p) { ReleaseBlock(GetBlock(p)); }
+
+int64_t ObjectArena::num_blocks() { return num_arena_blocks.load(std::memory_order_relaxed); }
+
+ObjectArena::~ObjectArena() {
+  // Merge the counts of the objects alive, the objects only held by the other threads are destroyed when they release
+  // them, and the ones released already are destroyed now.
+  for (char* begin : blocks_) {
+    char* end = reinterpret_cast<BlockHeader*>(begin)->end;
+    for (char* p = begin + kHeaderSize; p < end;) {
+      auto* header = reinterpret_cast<ObjectHeader*>(p);
+      char* object = p + kHeaderSize;
+      p            = object + header->size;
+      if (!header->destroy) continue;
+      auto* destroy   = header->destroy;
+      header->destroy = nullptr;
+      if (reinterpret_cast<RefCount*>(object + header->ref_count_offset)->Merge() == 0) destroy(object);
+    }
+  }
+  for (char* begin : blocks_) ReleaseBlock(reinterpret_cast<BlockHeader*>(begin));
+}
+
+ArenaScope::ArenaScope() : arena_(new ObjectArena), prev_(current_arena) {
+  current_arena             = arena_;
+  ObjectArena::current_id_ = arena_->id_;
+}
+
+ArenaScope::~ArenaScope() {
+  current_arena             = prev_;
+  ObjectArena::current_id_ = prev_ ? prev_->id_ : 0;
+  delete arena_;
+}
+
+}  // namespace common
+}  // namespace cinn
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cinn {
+namespace common {
+
+class RefCount;
+
+/**
+ * ObjectArena allocates the objects created by `make_shared` in an ArenaScope from large blocks, instead of a heap
+ * allocation for each object, and biases their reference counts to the thread of the scope (see `RefCount`).
+ *
+ * The memory of a destroyed object is not reused. The arena holds its blocks until the scope exits, then it merges the
+ * reference counts of the objects alive and releases the blocks. Each block counts its objects alive and is freed with
+ * the last one, so an arena fits a session creating many short living objects, like lowering a function.
+ *
+ * NOTE an object escaping the scope keeps its whole block of `kBlockSize` bytes until it is destroyed.
+ */
+class ObjectArena {
+ public:
+  //! The size and alignment of a block, the objects larger than a block are not allocated in an arena.
+  static constexpr size_t kBlockSize = 64 * 1024;
+  static constexpr size_t kAlignment = 16;
+
+  //! The arena of the innermost ArenaScope of the current thread, null if none.
+  static ObjectArena* Current();
+  //! The id of the arena of the innermost ArenaScope of the current thread, zero if none.
+  static uint32_t CurrentId() { return current_id_; }
+
+  /**
+   * Allocate the memory of an object.
+   * @param size The size of the object.
+   * @return The memory or null if the object is too large.
+   */
+  void* Allocate(size_t size);
+
+  /**
+   * Track the object constructed in the memory \p p allocated by the arena, its reference count is biased to the
+   * current thread until the scope exits.
+   * @param ref_count The reference count of the object.
+   * @param destroy The function destroying the object.
+   */
+  void Register(void* p, RefCount* ref_count, void (*destroy)(void*));
+
+  //! Stop tracking the object \p p destroyed by the owner thread before the scope exits.
+  static void Untrack(void* p);
+
+  //! Release the memory \p p of an object destroyed.
+  static void Free(void* p);
+
+  //! The number of the blocks not freed of all the arenas in the process.
+  static int64_t num_blocks();
+
+ private:
+  ObjectArena();
+  ~ObjectArena();
+
+  static thread_local inline uint32_t current_id_{};
+
+  //! The blocks allocated from, they are held by the arena until the scope exits.
+  std::vector<char*> blocks_;
+  uint32_t id_{};
+
+  friend class ArenaScope;
+};
+
+//! Allocate the objects created by `make_shared` on the current thread in an arena until the scope exits.
+class ArenaScope {
+ public:
+  ArenaScope();
+  ~ArenaScope();
+
+  ObjectArena* arena() { return arena_; }
+
+ private:
+  ObjectArena* arena_{};
+  ObjectArena* prev_{};
+};
+
+}  // namespace common
+}  // namespace cinn
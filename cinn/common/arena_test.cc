@@ -0,0 +1,142 @@
+#include "cinn/common/arena.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>  //NOLINT
+
+#include "cinn/common/object.h"
+#include "cinn/common/shared.h"
+
+namespace cinn {
+namespace common {
+
+namespace {
+
+int num_destroyed = 0;
+
+struct Node : public Object {
+  explicit Node(int value) : value(value) {}
+  ~Node() { num_destroyed++; }
+  const char* type_info() const override { return "ArenaTestNode"; }
+
+  int value;
+  Shared<Node> next;
+};
+
+struct Large : public Object {
+  const char* type_info() const override { return "ArenaTestLarge"; }
+
+  char data[ObjectArena::kBlockSize];
+};
+
+}  // namespace
+
+TEST(ObjectArena, allocate) {
+  ASSERT_FALSE(ObjectArena::Current());
+  int64_t num_blocks = ObjectArena::num_blocks();
+
+  Shared<Node> list;
+  {
+    ArenaScope scope;
+    ASSERT_EQ(ObjectArena::Current(), scope.arena());
+
+    // More objects than a block holds.
+    for (int i = 0; i < 10000; i++) {
+      Shared<Node> x(make_shared<Node>(i));
+      x->next = list;
+      list    = x;
+    }
+    ASSERT_TRUE(ref_count(list.get()).arena_allocated());
+    ASSERT_GT(ObjectArena::num_blocks(), num_blocks + 1);
+
+    // The objects larger than a block are allocated on the heap.
+    Shared<Large> large(make_shared<Large>());
+    ASSERT_FALSE(ref_count(large.get()).arena_allocated());
+    ASSERT_FALSE(ref_count(large.get()).owned());
+
+    // The blocks are held until the scope exits.
+    int64_t num_scope_blocks = ObjectArena::num_blocks();
+    list->next.Reset();
+    ASSERT_EQ(ObjectArena::num_blocks(), num_scope_blocks);
+  }
+  ASSERT_FALSE(ObjectArena::Current());
+
+  // The object escaping the scope keeps its whole block, the other blocks are freed.
+  ASSERT_EQ(ObjectArena::num_blocks(), num_blocks + 1);
+  ASSERT_EQ(list->value, 9999);
+  ASSERT_FALSE(ref_count(list.get()).owned());
+  ASSERT_EQ(ref_count(list.get()).val(), 1);
+
+  // Release the objects on another thread, the block is freed with the last object.
+  std::thread t([&] { list.Reset(); });
+  t.join();
+  ASSERT_FALSE(list.defined());
+  ASSERT_EQ(ObjectArena::num_blocks(), num_blocks);
+
+  Shared<Node> heap(make_shared<Node>(0));
+  ASSERT_FALSE(ref_count(heap.get()).arena_allocated());
+}
+
+TEST(ObjectArena, biased_ref_count) {
+  Shared<Node> escaped;
+  {
+    ArenaScope scope;
+    Shared<Node> x(make_shared<Node>(0));
+    // The count is updated by the scope's thread without the atomic instructions.
+    ASSERT_TRUE(ref_count(x.get()).owned());
+    Shared<Node> y = x;
+    ASSERT_EQ(ref_count(x.get()).val(), 2);
+
+    // The other threads update the shared count.
+    std::thread t([&] {
+      ASSERT_FALSE(ref_count(x.get()).owned());
+      Shared<Node> z = x;
+      escaped        = z;
+    });
+    t.join();
+    ASSERT_EQ(ref_count(x.get()).val(), 3);
+
+    // The owner destroys an object once both counts are zero.
+    num_destroyed = 0;
+    {
+      Shared<Node> a(make_shared<Node>(1));
+    }
+    ASSERT_EQ(num_destroyed, 1);
+
+    // An object whose last reference is released by another thread is destroyed when the scope exits.
+    Shared<Node> b(make_shared<Node>(2));
+    std::thread u([c = std::move(b)]() mutable { c.Reset(); });
+    u.join();
+    ASSERT_EQ(num_destroyed, 1);
+  }
+  ASSERT_EQ(num_destroyed, 2);
+
+  // The counts are merged, the escaped object is held by `escaped` only.
+  ASSERT_FALSE(ref_count(escaped.get()).owned());
+  ASSERT_EQ(ref_count(escaped.get()).val(), 1);
+  escaped.Reset();
+  ASSERT_EQ(num_destroyed, 3);
+}
+
+TEST(ObjectArena, nested) {
+  int64_t num_blocks = ObjectArena::num_blocks();
+  {
+    ArenaScope outer;
+    Shared<Node> a(make_shared<Node>(0));
+    {
+      ArenaScope inner;
+      Shared<Node> b(make_shared<Node>(1));
+      ASSERT_EQ(ObjectArena::num_blocks(), num_blocks + 2);
+      // The objects of the outer scope are not biased to the inner one.
+      ASSERT_FALSE(ref_count(a.get()).owned());
+      a->next = b;
+    }
+    ASSERT_TRUE(ref_count(a.get()).owned());
+    ASSERT_EQ(ObjectArena::Current(), outer.arena());
+    ASSERT_EQ(a->next->value, 1);
+  }
+  ASSERT_EQ(ObjectArena::num_blocks(), num_blocks);
+}
+
+}  // namespace common
+}  // namespace cinn
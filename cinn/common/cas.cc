@@ -2,28 +2,117 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 
 #include "cinn/common/arithmatic.h"
 #include "cinn/common/ir_util.h"
 #include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_compare.h"
 #include "cinn/ir/ir_mutator.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_visitor.h"
 #include "cinn/optim/ir_copy.h"
+#include "cinn/utils/profiler.h"
 #include "cinn/utils/string.h"
 
 namespace cinn {
 namespace common {
 using namespace ir;  // NOLINT
 
-Expr AutoSimplify(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals) {
+namespace {
+
+thread_local CasSimplifyMemo* current_cas_memo{};
+
+//! Replace the variables in an expression by the variables of the same names in \p vars.
+struct VarRemapper : public ir::IRMutator<> {
+  explicit VarRemapper(const std::map<std::string, Expr>& vars) : vars_(vars) {}
+
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const _Var_* op, Expr* expr) override {
+    auto it = vars_.find(op->name);
+    if (it != vars_.end()) *expr = it->second;
+  }
+
+  const std::map<std::string, Expr>& vars_;
+};
+
+Expr AutoSimplifyImpl(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals) {
   u = detail::ConvertCinnToCAS(u);
   u = CasSimplify(u, var_intervals);
   u = detail::ConvertCasToCinn(u);
   return u;
 }
 
+}  // namespace
+
+Expr AutoSimplify(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals) {
+  auto* memo = CasSimplifyMemo::Current();
+  if (!memo) return AutoSimplifyImpl(u, var_intervals);
+
+  // Only the intervals of the variables in u affect the result.
+  CasSimplifyMemo::intervals_t intervals;
+  if (!var_intervals.empty()) {
+    std::map<std::string, CasInterval> used;
+    for (auto& var : ir::CollectIRNodes(u, [](const Expr* x) { return x->As<_Var_>(); })) {
+      auto it = var_intervals.find(var.As<_Var_>()->name);
+      if (it != var_intervals.end()) used.emplace(*it);
+    }
+    for (auto& [name, interval] : used) intervals.emplace_back(name, interval.l, interval.r);
+  }
+
+  // The caller might mutate u or the result later, the memo interns the copies.
+  auto key = memo->table_.Intern(optim::IRCopy(u));
+  if (!memo->table_.interned(key)) return AutoSimplifyImpl(u, var_intervals);
+  auto res = memo->Lookup(key, intervals);
+  if (res.defined()) {
+    // The memo matches the variables by name, the result takes the variables of u rather than the ones of the
+    // expression memoized, which might have other bounds.
+    std::map<std::string, Expr> vars;
+    for (auto& var : ir::CollectIRNodes(u, [](const Expr* x) { return x->As<_Var_>(); })) {
+      vars.emplace(var.As<_Var_>()->name, var);
+    }
+    res = optim::IRCopy(res);
+    VarRemapper remapper(vars);
+    remapper(&res);
+    return res;
+  }
+
+  res = AutoSimplifyImpl(u, var_intervals);
+  memo->Insert(key, std::move(intervals), memo->table_.Intern(optim::IRCopy(res)));
+  return res;
+}
+
+CasSimplifyMemo::CasSimplifyMemo() : prev_(current_cas_memo) { current_cas_memo = this; }
+
+CasSimplifyMemo::~CasSimplifyMemo() {
+  current_cas_memo = prev_;
+  VLOG(3) << "CasSimplifyMemo: " << num_hits_ << " hits, " << num_misses_ << " misses";
+}
+
+CasSimplifyMemo* CasSimplifyMemo::Current() { return current_cas_memo; }
+
+Expr CasSimplifyMemo::Lookup(const Expr& key, const intervals_t& intervals) {
+  auto& profiler = utils::CompileProfiler::Global();
+  auto range     = entries_.equal_range(key.get());
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.intervals == intervals) {
+      num_hits_++;
+      if (profiler.enabled()) profiler.AddCount("cas.memo_hits", 1);
+      return it->second.result;
+    }
+  }
+  num_misses_++;
+  if (profiler.enabled()) profiler.AddCount("cas.memo_misses", 1);
+  return Expr();
+}
+
+void CasSimplifyMemo::Insert(const Expr& key, intervals_t&& intervals, const Expr& result) {
+  entries_.emplace(key.get(), Entry{std::move(intervals), result});
+}
+
 int gcd(int a, int b) {
   // Everything divides 0
   if (a == 0) return b;
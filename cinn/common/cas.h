@@ -1,9 +1,12 @@
 #pragma once
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include "cinn/common/macros.h"
 #include "cinn/ir/ir.h"
+#include "cinn/ir/ir_compare.h"
 
 namespace cinn {
 namespace common {
@@ -26,6 +29,53 @@ using cas_intervals_t = std::unordered_map<std::string, CasInterval>;
 
 Expr AutoSimplify(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals = {});
 
+/**
+ * The memo of AutoSimplify in a session, like lowering a function.
+ *
+ * An expression is simplified once for the intervals of the variables in it, the later AutoSimplify calls with a
+ * structurally equal expression and the same intervals get a copy of the memoized result, with the variables of the
+ * expression given in place of the ones of the expression memoized. The expressions and the
+ * results are interned in an `ir::ExprTable`, so an expression is looked up by the identity of its canonical node and
+ * the subexpressions shared by the entries are kept once. The memo is used by the current thread until it is
+ * destroyed.
+ */
+class CasSimplifyMemo {
+ public:
+  CasSimplifyMemo();
+  ~CasSimplifyMemo();
+
+  //! The innermost memo of the current thread, null if none.
+  static CasSimplifyMemo* Current();
+
+  size_t size() const { return entries_.size(); }
+  size_t num_hits() const { return num_hits_; }
+  size_t num_misses() const { return num_misses_; }
+
+ private:
+  //! The name and interval of each variable in an expression, sorted by name.
+  using intervals_t = std::vector<std::tuple<std::string, int, int>>;
+
+  struct Entry {
+    intervals_t intervals;
+    Expr result;
+  };
+
+  //! Get the simplified \p key memoized, or an undefined Expr if it is not memoized, \p key is interned.
+  Expr Lookup(const Expr& key, const intervals_t& intervals);
+  void Insert(const Expr& key, intervals_t&& intervals, const Expr& result);
+
+  ir::ExprTable table_;
+  //! The entries keyed by the canonical nodes of the expressions.
+  std::unordered_multimap<const ir::IrNode*, Entry> entries_;
+  CasSimplifyMemo* prev_{};
+  size_t num_hits_{};
+  size_t num_misses_{};
+
+  friend Expr AutoSimplify(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals);
+
+  CINN_DISALLOW_COPY_AND_ASSIGN(CasSimplifyMemo);
+};
+
 //! Simplify a CAS expression.
 Expr CasSimplify(Expr u, const std::unordered_map<std::string, CasInterval>& var_intervals = {});
 
@@ -5,6 +5,7 @@
 #include "cinn/cinn.h"
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/utils/string.h"
@@ -304,6 +305,50 @@ TEST(CAS, IntConnerCase) {
   EXPECT_EQ(GetStreamCnt(u8), "(-1 / y)");
 }
 
+TEST(CAS, memo) {
+  Var x("x", Int(32));
+  Var y("y", Int(32));
+  cas_intervals_t var_intervals{{"x", CasInterval(0, 3)}};
+
+  CasSimplifyMemo memo;
+  ASSERT_EQ(CasSimplifyMemo::Current(), &memo);
+
+  auto u0 = AutoSimplify((x * 4 + y) / 4, var_intervals);
+  ASSERT_EQ(memo.num_misses(), 1UL);
+  // A structurally equal expression built separately hits the memo.
+  auto u1 = AutoSimplify((x * 4 + y) / 4, var_intervals);
+  ASSERT_EQ(memo.num_hits(), 1UL);
+  EXPECT_EQ(GetStreamCnt(u0), GetStreamCnt(u1));
+  // The results are copies, mutating one does not change the memo.
+  ASSERT_FALSE(u0.same_as(u1));
+
+  // The intervals of the variables in the expression are part of the key, the others are not.
+  var_intervals.emplace("z", CasInterval(0, 10));
+  AutoSimplify((x * 4 + y) / 4, var_intervals);
+  ASSERT_EQ(memo.num_hits(), 2UL);
+  AutoSimplify((x * 4 + y) / 4, {{"x", CasInterval(0, 100)}});
+  ASSERT_EQ(memo.num_misses(), 2UL);
+  ASSERT_EQ(memo.size(), 2UL);
+}
+
+TEST(CAS, memo_same_named_vars) {
+  // Two reduce axes of the same name and different bounds.
+  Var k0(4, "k");
+  Var k1(8, "k");
+
+  CasSimplifyMemo memo;
+  auto u0 = AutoSimplify(k0 * 4 + 1);
+  auto u1 = AutoSimplify(k1 * 4 + 1);
+  ASSERT_EQ(memo.num_hits(), 1UL);
+  EXPECT_EQ(GetStreamCnt(u0), GetStreamCnt(u1));
+
+  // The result of the hit refers to the caller's variable, not the one memoized.
+  auto vars = ir::CollectIRNodes(u1, [](const Expr* x) { return x->As<ir::_Var_>(); });
+  ASSERT_EQ(vars.size(), 1UL);
+  ASSERT_TRUE(vars.begin()->same_as(k1));
+  ASSERT_EQ(vars.begin()->As<ir::_Var_>()->upper_bound.as_int32(), 8);
+}
+
 TEST(SolveInequality, basic) {
   Var x("x", Int(32));
   Var y("y", Int(32));
@@ -3,6 +3,7 @@
 #include <unordered_set>
 
 #include "cinn/common/cas.h"
+#include "cinn/ir/ir_compare.h"
 #include "cinn/ir/ir_mutator.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
@@ -188,6 +189,7 @@ Expr CastIfNeeded(Expr body, Type type) {
 }
 
 bool MathEqual(const Expr &a, const Expr &b) {
+  if (ir::StructuralEqual(a, b)) return true;
   auto c = a - b;
   c      = AutoSimplify(c);
   return is_zero(c);
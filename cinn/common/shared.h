@@ -1,24 +1,88 @@
 #pragma once
 #include <atomic>
+#include <cstdint>
+#include <new>
 #include <string>
 #include <type_traits>
+#include <utility>
+
+#include "cinn/common/arena.h"
 
 namespace cinn {
 namespace common {
 
+/**
+ * The reference count of an Object.
+ *
+ * The objects created in an ArenaScope are biased to the thread of the scope while it is active: that thread updates
+ * a count of its own without the atomic read-modify-write instructions, the other threads update a shared atomic
+ * count. The true count is the sum of the two, so only the owner thread can tell the object is dead, and it destroys
+ * the object when its count drops to zero and the shared one is zero. The counts are merged when the scope exits, then
+ * all the threads update the shared count, which destroys the object once it drops to zero. The objects created out of
+ * an arena use the shared count only.
+ */
 class RefCount {
  public:
   using value_type = int32_t;
   RefCount()       = default;
 
-  value_type Inc() { return ++count_; }
-  value_type Dec() { return --count_; }
-  bool is_zero() const { return 0 == count_; }
-  std::string to_string() { return std::to_string(count_.load()); }
-  int32_t val() const { return count_; }
+  value_type Inc() {
+    if (owned()) return ++biased_;
+    return Count(shared_.fetch_add(1, std::memory_order_relaxed) + 1);
+  }
+  //! Decrease the count, the object is dead if it returns zero.
+  value_type Dec() {
+    if (owned()) {
+      if (--biased_ > 0) return biased_;
+      // The owner might release the references counted by the other threads too.
+      return biased_ + Count(shared_.load(std::memory_order_acquire));
+    }
+    int64_t x = shared_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    // The shared count of an object not merged is partial, its owner decides when it is dead.
+    return (x & kMerged) ? Count(x) : 1;
+  }
+  bool is_zero() const { return 0 == val(); }
+  std::string to_string() { return std::to_string(val()); }
+  //! The count, it is exact on the owner thread or once the counts are merged.
+  int32_t val() const { return Count(shared_.load()) + (owned() ? biased_ : 0); }
+
+  //! Whether the object is allocated in an ObjectArena.
+  bool arena_allocated() const { return shared_.load(std::memory_order_relaxed) & kArenaAllocated; }
+  //! Whether the count is biased to the current thread, then it is updated without the atomic instructions.
+  bool owned() const {
+    uint32_t owner = owner_.load(std::memory_order_relaxed);
+    return owner && owner == ObjectArena::CurrentId();
+  }
 
  private:
-  std::atomic<value_type> count_{0};
+  //! The bits of the shared count, the count is stored with the offset `kOffset` in the lower 32 bits.
+  static constexpr int64_t kOffset         = int64_t(1) << 31;
+  static constexpr int64_t kMerged         = int64_t(1) << 32;
+  static constexpr int64_t kArenaAllocated = int64_t(1) << 33;
+
+  static value_type Count(int64_t x) { return static_cast<value_type>((x & 0xffffffff) - kOffset); }
+
+  //! Bias the count to the arena \p arena_id, it is called by the arena on the thread of the scope.
+  void Bias(uint32_t arena_id) {
+    shared_.fetch_add(kArenaAllocated - kMerged, std::memory_order_relaxed);
+    owner_.store(arena_id, std::memory_order_relaxed);
+  }
+
+  //! Merge the count of the owner into the shared count, it is called by the owner. Returns the count merged.
+  value_type Merge() {
+    int64_t delta = kMerged + biased_;
+    biased_       = 0;
+    owner_.store(0, std::memory_order_relaxed);
+    return Count(shared_.fetch_add(delta, std::memory_order_acq_rel) + delta);
+  }
+
+  //! The count of the owner thread.
+  value_type biased_{0};
+  //! The id of the arena owning the count, zero if the count is merged.
+  std::atomic<uint32_t> owner_{0};
+  std::atomic<int64_t> shared_{kOffset | kMerged};
+
+  friend class ObjectArena;
 };
 
 class Object;
@@ -32,6 +96,15 @@ RefCount& ref_count(const T* t) {
 }
 template <typename T>
 void Destroy(const T* t) {
+  if (t->__ref_count__.arena_allocated()) {
+    // The memory of the most derived object.
+    void* p = const_cast<void*>(dynamic_cast<const void*>(t));
+    // The counts of the object are not merged, the arena stops tracking it.
+    if (t->__ref_count__.owned()) ObjectArena::Untrack(p);
+    t->~T();
+    ObjectArena::Free(p);
+    return;
+  }
   delete t;
 }
 
@@ -106,7 +179,17 @@ Shared<T>& Shared<T>::operator=(const Shared<T>& other) {
 
 template <typename T, typename... Args>
 T* make_shared(Args&&... args) {
-  return new T(args...);
+  if constexpr (std::is_base_of<Object, T>::value) {
+    auto* arena = ObjectArena::Current();
+    void* p     = arena ? arena->Allocate(sizeof(T)) : nullptr;
+    if (p) {
+      static_assert(alignof(T) <= ObjectArena::kAlignment, "The object is over-aligned for ObjectArena");
+      T* x = new (p) T(std::forward<Args>(args)...);
+      arena->Register(p, &x->__ref_count__, [](void* p) { Destroy(static_cast<T*>(p)); });
+      return x;
+    }
+  }
+  return new T(std::forward<Args>(args)...);
 }
 
 template <typename T>
@@ -0,0 +1,336 @@
+#include "cinn/frontend/batching_server.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+#include "cinn/backends/cuda_util.h"
+
+namespace cinn::frontend {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Request {
+  std::vector<std::vector<float>> inputs;
+  std::promise<std::vector<std::vector<float>>> promise;
+  Clock::time_point submit_time;
+  std::atomic<Request*> next{};
+};
+
+/**
+ * The lock-free queue of the requests for multiple producers and a single consumer, it is an intrusive linked list with
+ * a stub node. A push is an exchange of the head followed by linking the previous node, so a pop might miss a request
+ * whose push is in progress, the producer wakes the consumer up after linking.
+ */
+class RequestQueue {
+ public:
+  RequestQueue() : head_(&stub_), tail_(&stub_) {}
+
+  void Push(Request* request) {
+    request->next.store(nullptr, std::memory_order_relaxed);
+    Request* prev = head_.exchange(request, std::memory_order_acq_rel);
+    prev->next.store(request, std::memory_order_release);
+  }
+
+  //! Pop a request, get null if the queue is empty or the next push is in progress. Only the consumer calls it.
+  Request* Pop() {
+    Request* tail = tail_;
+    Request* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next) return nullptr;
+      tail_ = next;
+      tail  = next;
+      next  = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+    // The last request is popped by putting the stub behind it.
+    Push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (!next) return nullptr;
+    tail_ = next;
+    return tail;
+  }
+
+ private:
+  std::atomic<Request*> head_;
+  Request* tail_;
+  Request stub_;
+};
+
+}  // namespace
+
+class BatchingServer::Impl {
+ public:
+  Impl(const std::vector<std::string>& input_names,
+       const std::vector<hlir::framework::shape_t>& sample_shapes,
+       const std::vector<std::string>& output_names,
+       const Target& target,
+       const Options& options)
+      : input_names_(input_names),
+        sample_shapes_(sample_shapes),
+        output_names_(output_names),
+        target_(target),
+        options_(options) {
+    CHECK_EQ(input_names.size(), sample_shapes.size());
+    CHECK_GT(options.max_batch_size, 0);
+    std::vector<hlir::framework::shape_t> input_shapes;
+    for (auto& shape : sample_shapes) {
+      int numel = 1;
+      for (int dim : shape) numel *= dim;
+      sample_numels_.push_back(numel);
+      input_shapes.push_back(GetInputShape(shape, hlir::framework::kDynamicDim));
+    }
+    interpreter_.reset(new Interpreter(input_names, input_shapes));
+  }
+
+  void Start() { worker_ = std::thread([this] { Loop(); }); }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) worker_.join();
+
+    // The requests pushed after the worker exits are failed, once the pushes in progress complete.
+    while (num_submitting_.load() > 0) std::this_thread::yield();
+    while (auto* request = queue_.Pop()) Fail(std::unique_ptr<Request>(request));
+  }
+
+  std::future<std::vector<std::vector<float>>> Submit(std::vector<std::vector<float>> inputs) {
+    CHECK_EQ(inputs.size(), input_names_.size());
+    for (int i = 0; i < inputs.size(); i++) {
+      CHECK_EQ(inputs[i].size(), sample_numels_[i]) << "The size of the input [" << input_names_[i] << "]";
+    }
+    std::unique_ptr<Request> request(new Request);
+    request->inputs      = std::move(inputs);
+    request->submit_time = Clock::now();
+    auto future          = request->promise.get_future();
+
+    // Counted before checking the stop, so either this sees the stop or the stop waits for the push.
+    num_submitting_++;
+    if (stop_.load()) {
+      num_submitting_--;
+      Fail(std::move(request));
+      return future;
+    }
+    queue_.Push(request.release());
+    // Pairs with the fence of the consumer announcing it is waiting, so either the consumer sees the request or this
+    // sees the consumer waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mu_);
+      cv_.notify_one();
+    }
+    num_submitting_--;
+    return future;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(stats_mu_);
+    Stats res;
+    res.num_requests = num_requests_;
+    res.num_batches  = num_batches_;
+    if (num_batches_ > 0) {
+      res.mean_batch_size = static_cast<double>(num_requests_) / num_batches_;
+      res.occupancy       = static_cast<double>(num_requests_) / num_rows_;
+    }
+    if (num_requests_ > 0) res.mean_latency_us = total_latency_us_ / num_requests_;
+    res.max_latency_us = max_latency_us_;
+    return res;
+  }
+
+ private:
+  friend class BatchingServer;
+
+  static void Fail(std::unique_ptr<Request> request) {
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error("The batching server is stopped")));
+  }
+
+  static hlir::framework::shape_t GetInputShape(const hlir::framework::shape_t& sample_shape, int batch) {
+    hlir::framework::shape_t res({batch});
+    res.insert(res.end(), sample_shape.begin(), sample_shape.end());
+    return res;
+  }
+
+  //! Compile the buckets of the batch sizes from 1, until as many as the Interpreter keeps are compiled.
+  void Warmup() {
+    size_t max_programs = std::max(FLAGS_cinn_max_batch_programs, 1);
+    std::unordered_set<int> buckets;
+    for (int batch = 1; batch <= options_.max_batch_size && buckets.size() < max_programs; batch++) {
+      SetBatchSize(batch);
+      buckets.insert(interpreter_->batch_bucket());
+    }
+  }
+
+  void SetBatchSize(int batch) {
+    std::vector<hlir::framework::shape_t> input_shapes;
+    for (auto& shape : sample_shapes_) input_shapes.push_back(GetInputShape(shape, batch));
+    interpreter_->SetInputShapes(input_shapes);
+  }
+
+  //! Copy \p numel floats from the host to the memory of the target.
+  void CopyToTarget(const float* src, int numel, float* dst) const {
+    if (target_.arch == Target::Arch::X86) {
+      std::copy(src, src + numel, dst);
+    } else if (target_.arch == Target::Arch::NVGPU) {
+#ifdef CINN_WITH_CUDA
+      CUDA_CALL(cudaMemcpy(dst, src, numel * sizeof(float), cudaMemcpyHostToDevice));
+#else
+      LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+    } else {
+      CINN_NOT_IMPLEMENTED
+    }
+  }
+
+  //! Copy \p numel floats from the memory of the target to the host.
+  void CopyFromTarget(const float* src, int numel, float* dst) const {
+    if (target_.arch == Target::Arch::X86) {
+      std::copy(src, src + numel, dst);
+    } else if (target_.arch == Target::Arch::NVGPU) {
+#ifdef CINN_WITH_CUDA
+      CUDA_CALL(cudaMemcpy(dst, src, numel * sizeof(float), cudaMemcpyDeviceToHost));
+#else
+      LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+    } else {
+      CINN_NOT_IMPLEMENTED
+    }
+  }
+
+  //! Pop a request, wait for one until \p deadline if the queue is empty. Get null on the timeout or the stop.
+  Request* WaitPop(Clock::time_point deadline) {
+    while (true) {
+      if (auto* request = queue_.Pop()) return request;
+      std::unique_lock<std::mutex> lock(mu_);
+      waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Request* request = queue_.Pop();
+      bool timeout     = false;
+      if (!request && !stop_) timeout = cv_.wait_until(lock, deadline) == std::cv_status::timeout;
+      waiting_.store(false, std::memory_order_relaxed);
+      if (request) return request;
+      if (stop_ || timeout) return queue_.Pop();
+    }
+  }
+
+  void Loop() {
+    std::vector<std::unique_ptr<Request>> batch;
+    while (true) {
+      Request* first = nullptr;
+      while (!first) {
+        first = WaitPop(Clock::now() + std::chrono::milliseconds(100));
+        if (!first && stop_) return;
+      }
+      batch.emplace_back(first);
+      auto deadline = first->submit_time + std::chrono::microseconds(options_.max_wait_us);
+      while (batch.size() < options_.max_batch_size) {
+        auto* request = WaitPop(deadline);
+        if (!request) break;
+        batch.emplace_back(request);
+      }
+      RunBatch(batch);
+      batch.clear();
+    }
+  }
+
+  //! Gather the samples into the input tensors, run the model and scatter the rows of the outputs.
+  void RunBatch(const std::vector<std::unique_ptr<Request>>& batch) {
+    int batch_size = batch.size();
+    SetBatchSize(batch_size);
+    int num_rows = interpreter_->batch_bucket();
+    for (int i = 0; i < input_names_.size(); i++) {
+      auto tensor = interpreter_->GetTensor(input_names_[i]);
+      auto* data  = tensor->mutable_data<float>(target_);
+      for (int j = 0; j < batch_size; j++) {
+        CopyToTarget(batch[j]->inputs[i].data(), sample_numels_[i], data + j * sample_numels_[i]);
+      }
+    }
+
+    interpreter_->Run();
+
+    std::vector<std::vector<std::vector<float>>> results(batch_size);
+    for (auto& name : output_names_) {
+      auto tensor   = interpreter_->GetTensor(name);
+      int row_numel = tensor->shape().numel() / tensor->shape().data()[0];
+      std::vector<float> data(batch_size * row_numel);
+      CopyFromTarget(tensor->data<float>(), data.size(), data.data());
+      for (int j = 0; j < batch_size; j++) {
+        results[j].emplace_back(data.begin() + j * row_numel, data.begin() + (j + 1) * row_numel);
+      }
+    }
+
+    auto now = Clock::now();
+    for (int j = 0; j < batch_size; j++) batch[j]->promise.set_value(std::move(results[j]));
+
+    std::lock_guard<std::mutex> lock(stats_mu_);
+    num_requests_ += batch_size;
+    num_batches_++;
+    num_rows_ += num_rows;
+    for (auto& request : batch) {
+      double latency_us = std::chrono::duration<double, std::micro>(now - request->submit_time).count();
+      total_latency_us_ += latency_us;
+      max_latency_us_ = std::max(max_latency_us_, latency_us);
+    }
+  }
+
+  std::vector<std::string> input_names_;
+  std::vector<hlir::framework::shape_t> sample_shapes_;
+  std::vector<int> sample_numels_;
+  std::vector<std::string> output_names_;
+  Target target_;
+  Options options_;
+  std::unique_ptr<Interpreter> interpreter_;
+
+  RequestQueue queue_;
+  std::thread worker_;
+  //! The mutex and the condition variable only put the idle worker to sleep, the queue is lock-free.
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::atomic<bool> waiting_{};
+  std::atomic<bool> stop_{};
+  //! The number of the Submit calls in progress.
+  std::atomic<int> num_submitting_{};
+
+  mutable std::mutex stats_mu_;
+  int64_t num_requests_{};
+  int64_t num_batches_{};
+  int64_t num_rows_{};
+  double total_latency_us_{};
+  double max_latency_us_{};
+};
+
+BatchingServer::BatchingServer(const std::vector<std::string>& input_names,
+                               const std::vector<hlir::framework::shape_t>& sample_shapes,
+                               const std::vector<std::string>& output_names,
+                               const std::string& model_dir,
+                               const Target& target,
+                               const Options& options)
+    : impl_(new Impl(input_names, sample_shapes, output_names, target, options)) {
+  impl_->interpreter_->LoadPaddleModel(model_dir, target);
+  if (options.warmup) impl_->Warmup();
+  impl_->Start();
+}
+
+std::future<std::vector<std::vector<float>>> BatchingServer::Submit(std::vector<std::vector<float>> inputs) {
+  return impl_->Submit(std::move(inputs));
+}
+
+BatchingServer::Stats BatchingServer::stats() const { return impl_->stats(); }
+
+BatchingServer::~BatchingServer() { impl_->Stop(); }
+
+}  // namespace cinn::frontend
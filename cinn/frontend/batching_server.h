@@ -0,0 +1,77 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/interpreter.h"
+
+namespace cinn {
+namespace frontend {
+
+/**
+ * A server batching the single-sample requests of a model into the runs of an Interpreter.
+ *
+ * The requests are pushed into a lock-free queue by any threads, a worker thread pops them and runs a batch once it
+ * has `max_batch_size` requests or the first one has waited for `max_wait_us`. The samples are copied directly into
+ * the input tensors of the Interpreter on the host or the device, the model is compiled for the buckets of the batch
+ * sizes, so the partial batches are padded to the buckets. The rows of the outputs are scattered back to the callers by
+ * futures.
+ */
+class BatchingServer final {
+ public:
+  struct Options {
+    int max_batch_size{32};
+    //! The longest time the first request of a batch waits for the others, in microseconds.
+    int max_wait_us{1000};
+    //! Compile the buckets of the batch sizes on construction, so no request waits for a compilation. At most
+    //! `FLAGS_cinn_max_batch_programs` buckets are compiled, the Interpreter would drop the others.
+    bool warmup{true};
+  };
+
+  struct Stats {
+    int64_t num_requests{};
+    int64_t num_batches{};
+    //! The mean number of the requests in a batch.
+    double mean_batch_size{};
+    //! The ratio of the rows in use to the rows computed, the rest are the padding of the buckets.
+    double occupancy{};
+    //! The latencies from the submission to the completion of the requests, in microseconds.
+    double mean_latency_us{};
+    double max_latency_us{};
+  };
+
+  /**
+   * Load a Paddle model to serve.
+   * @param input_names The names of the inputs.
+   * @param sample_shapes The shapes of the inputs of a single sample, without the batch dimensions.
+   * @param output_names The names of the outputs to return.
+   * @param model_dir The directory path to the model.
+   */
+  BatchingServer(const std::vector<std::string>& input_names,
+                 const std::vector<hlir::framework::shape_t>& sample_shapes,
+                 const std::vector<std::string>& output_names,
+                 const std::string& model_dir,
+                 const Target& target,
+                 const Options& options);
+
+  /**
+   * Submit a request, it is thread safe.
+   * @param inputs The data of the inputs of a sample, in the order of the input names.
+   * @return The future of the data of the outputs, in the order of the output names. It throws std::runtime_error if
+   * the request is submitted while the server is stopping.
+   */
+  std::future<std::vector<std::vector<float>>> Submit(std::vector<std::vector<float>> inputs);
+
+  Stats stats() const;
+
+  //! Stop the worker after running the submitted requests, the ones racing with the stop are failed.
+  ~BatchingServer();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace frontend
+}  // namespace cinn
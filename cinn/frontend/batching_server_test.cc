@@ -0,0 +1,82 @@
+#include "cinn/frontend/batching_server.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "cinn/runtime/use_extern_funcs.h"
+
+DEFINE_string(model_dir, "", "");
+
+namespace cinn::frontend {
+
+TEST(BatchingServer, loopback) {
+  auto target = common::DefaultHostTarget();
+  BatchingServer::Options options;
+  options.max_batch_size = 8;
+  options.max_wait_us    = 2000;
+  BatchingServer server({"A"}, {{30}}, {"fc_0.tmp_2"}, FLAGS_model_dir, target, options);
+
+  const int num_threads = 4, num_requests = 50;
+  auto GetSample        = [](int thread, int i) {
+    std::vector<float> sample(30);
+    for (int j = 0; j < 30; j++) sample[j] = static_cast<float>((thread * 31 + i * 7 + j) % 13) / 13;
+    return sample;
+  };
+  std::vector<std::vector<std::future<std::vector<std::vector<float>>>>> futures(num_threads);
+  std::vector<std::thread> clients;
+  for (int t = 0; t < num_threads; t++) {
+    clients.emplace_back([&, t] {
+      for (int i = 0; i < num_requests; i++) futures[t].push_back(server.Submit({GetSample(t, i)}));
+    });
+  }
+  for (auto& client : clients) client.join();
+
+  Interpreter expected({"A"}, {{1, 30}});
+  expected.LoadPaddleModel(FLAGS_model_dir, target);
+  for (int t = 0; t < num_threads; t++) {
+    for (int i = 0; i < num_requests; i++) {
+      auto sample = GetSample(t, i);
+      std::copy(sample.begin(), sample.end(), expected.GetTensor("A")->mutable_data<float>(target));
+      expected.Run();
+      auto out          = futures[t][i].get();
+      auto expected_out = expected.GetTensor("fc_0.tmp_2");
+      ASSERT_EQ(out.size(), 1UL);
+      ASSERT_EQ(out[0].size(), expected_out->shape().numel());
+      for (int j = 0; j < out[0].size(); j++) EXPECT_NEAR(out[0][j], expected_out->data<float>()[j], 1e-5);
+    }
+  }
+
+  auto stats = server.stats();
+  EXPECT_EQ(stats.num_requests, num_threads * num_requests);
+  EXPECT_GE(stats.mean_batch_size, 1);
+  EXPECT_LE(stats.mean_batch_size, options.max_batch_size);
+  EXPECT_GT(stats.occupancy, 0);
+  EXPECT_LE(stats.occupancy, 1);
+  LOG(INFO) << "batches: " << stats.num_batches << ", mean batch size: " << stats.mean_batch_size
+            << ", occupancy: " << stats.occupancy << ", mean latency: " << stats.mean_latency_us
+            << "us, max latency: " << stats.max_latency_us << "us";
+}
+
+// The requests submitted right before the stop are completed by it, none of the futures is left unset.
+TEST(BatchingServer, stop) {
+  auto target = common::DefaultHostTarget();
+  BatchingServer::Options options;
+  options.max_batch_size = 4;
+  std::vector<std::string> input_names{"A"}, output_names{"fc_0.tmp_2"};
+  std::vector<hlir::framework::shape_t> sample_shapes{{30}};
+  auto server =
+      std::make_unique<BatchingServer>(input_names, sample_shapes, output_names, FLAGS_model_dir, target, options);
+
+  std::vector<std::future<std::vector<std::vector<float>>>> futures;
+  for (int i = 0; i < 20; i++) futures.push_back(server->Submit({std::vector<float>(30, 1.f)}));
+  server.reset();
+  for (auto& future : futures) {
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_EQ(future.get().size(), 1UL);
+  }
+}
+
+}  // namespace cinn::frontend
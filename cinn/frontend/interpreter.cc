@@ -1,41 +1,145 @@
 #include "cinn/frontend/interpreter.h"
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <map>
+#include <optional>
+#include <unordered_set>
+
+#include "cinn/backends/cuda_util.h"
 #include "cinn/frontend/syntax.h"
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/hlir/op/use_ops.h"
 #include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/string.h"
+
+DEFINE_int32(cinn_max_batch_bucket,
+             64,
+             "The largest power of 2 bucket of the dynamic batch sizes of an Interpreter, the larger batch sizes are "
+             "rounded up to its multiples");
+
+DEFINE_int32(cinn_max_batch_programs,
+             16,
+             "The number of the programs compiled for the batch sizes an Interpreter keeps, the least recently used "
+             "one is dropped beyond it");
 
 namespace cinn::frontend {
 
+namespace {
+
+//! Round the batch size up to a power of 2, or to a multiple of FLAGS_cinn_max_batch_bucket beyond it.
+int GetBatchBucket(int batch) {
+  int max_bucket = std::max(FLAGS_cinn_max_batch_bucket, 1);
+  if (batch > max_bucket) return (batch + max_bucket - 1) / max_bucket * max_bucket;
+  int bucket = 1;
+  while (bucket < batch) bucket *= 2;
+  return std::min(bucket, max_bucket);
+}
+
+//! Whether \p instr combines the rows of the leading dimension of an input of rank \p rank, as the shapes do not show.
+bool MixesRows(const Instruction& instr, int rank) {
+  auto& attrs   = instr->attrs;
+  auto is_batch = [&](int axis) { return axis == 0 || axis == -rank; };
+  if (instr->op_type == "softmax") {
+    auto it = attrs.find("axis");
+    return it != attrs.end() && is_batch(std::get<int>(it->second));
+  }
+  auto find_axes = [&](const std::string& key, std::vector<int>* axes) {
+    auto it = attrs.find(key);
+    if (it == attrs.end()) return false;
+    *axes = std::get<std::vector<int>>(it->second);
+    return true;
+  };
+  std::vector<int> axes;
+  if (instr->op_type == "slice") {
+    return find_axes("axes", &axes) && std::any_of(axes.begin(), axes.end(), is_batch);
+  }
+  if (utils::Startswith(instr->op_type, "reduce")) {
+    // Reducing no dimension given reduces all of them.
+    return !find_axes("dim", &axes) || axes.empty() || std::any_of(axes.begin(), axes.end(), is_batch);
+  }
+  return false;
+}
+
+}  // namespace
+
 struct Interpreter::Impl {
   Impl(const std::vector<std::string>& input_names, const std::vector<hlir::framework::shape_t>& input_shapes)
-      : scope_(std::make_shared<hlir::framework::Scope>()), input_names_(input_names), input_shapes_(input_shapes) {}
+      : scope_(std::make_shared<hlir::framework::Scope>()), input_names_(input_names), input_shapes_(input_shapes) {
+    for (auto& shape : input_shapes) {
+      for (int i = 0; i < shape.size(); i++) {
+        if (shape[i] != hlir::framework::kDynamicDim) continue;
+        CHECK_EQ(i, 0) << "Only the leading dimensions of the inputs might be dynamic";
+        dynamic_ = true;
+      }
+    }
+  }
+
+  //! A runtime program compiled for the inputs of some shapes, with the scope holding its variables.
+  struct CompiledProgram {
+    //! The leading dimension of the dynamic inputs it is compiled for.
+    int batch_bucket{};
+    std::shared_ptr<hlir::framework::Scope> scope;
+    std::unique_ptr<hlir::framework::GraphCompiler> graph_compiler;
+    std::unique_ptr<hlir::framework::Program> runtime_program;
+  };
 
   /**
    * Build the model.
    * @param input_names The name of input variables.
    * @param input_shapes The input shapes.
+   * @param scope The scope holding the parameters, the other variables are created in it.
+   */
+  CompiledProgram Build(const std::vector<std::string>& input_names,
+                        const std::vector<hlir::framework::shape_t>& input_shapes,
+                        const Target& target,
+                        std::shared_ptr<hlir::framework::Scope> scope);
+
+  //! Get the program compiled for the bucket of \p batch, compile it on the first use of the bucket.
+  CompiledProgram* GetBucketProgram(int batch);
+
+  /**
+   * Whether the rows of the batch are computed independently, so the batch can be padded to a bucket. The shapes are
+   * inferred at two batch sizes, each variable computed from a dynamic input should keep the batch as its leading
+   * dimension, and no operation should combine the rows along it. It also collects those variables in `batch_vars_`.
    */
-  void Build(const std::vector<std::string>& input_names,
-             const std::vector<hlir::framework::shape_t>& input_shapes,
-             const Target& target);
+  bool IsBatchIndependent();
+
+  CompiledProgram* current() {
+    CHECK(current_) << "The input shapes should be set before running a model of the dynamic shapes";
+    return current_;
+  }
 
  private:
   friend class Interpreter;
 
   std::vector<std::string> input_names_;
   std::vector<hlir::framework::shape_t> input_shapes_;
+  bool dynamic_{};
+  Target target_;
 
+  //! The scope of the parameters, it holds all the variables of the static shapes.
   std::shared_ptr<hlir::framework::Scope> scope_;
   std::unique_ptr<frontend::Program> program_;
-  std::unique_ptr<hlir::framework::GraphCompiler> graph_compiler_;
 
   std::unordered_map<std::string, Variable> var_map_;
   std::unordered_map<std::string, std::string> var_map_paddle_to_cinn_;
   std::unordered_map<std::string, std::string> var_map_cinn_to_paddle_;
 
-  std::unique_ptr<hlir::framework::Program> runtime_program_;
+  CompiledProgram static_program_;
+  //! The programs of the dynamic shapes by the buckets of the batch sizes, and the buckets from the most recently used.
+  std::map<int, CompiledProgram> bucket_programs_;
+  std::list<int> recent_buckets_;
+  CompiledProgram* current_{};
+  //! The batch size set by `SetInputShapes`.
+  int batch_{};
+
+  //! Whether the batch can be padded, computed on the first use of a bucket.
+  std::optional<bool> batch_independent_;
+  //! The variables whose leading dimension is the batch.
+  std::unordered_set<std::string> batch_vars_;
 };
 
 void Interpreter::LoadPaddleModel(const std::string& model_dir, const Target& target, bool params_combined) {
@@ -44,26 +148,168 @@ void Interpreter::LoadPaddleModel(const std::string& model_dir, const Target& ta
   impl_->program_.reset(program.release());
   impl_->var_map_                = var_map;
   impl_->var_map_paddle_to_cinn_ = var_map_paddle_to_program;
+  impl_->target_                 = target;
 
-  impl_->Build(impl_->input_names_, impl_->input_shapes_, target);
+  // The models of the dynamic shapes are built on setting the input shapes.
+  if (impl_->dynamic_) return;
+  impl_->static_program_ = impl_->Build(impl_->input_names_, impl_->input_shapes_, target, impl_->scope_);
+  impl_->current_        = &impl_->static_program_;
 }
 
-void Interpreter::Run() { impl_->runtime_program_->Execute(); }
+void Interpreter::SetInputShapes(const std::vector<hlir::framework::shape_t>& input_shapes) {
+  CHECK(impl_->program_) << "The model should be loaded before setting the input shapes";
+  CHECK_EQ(input_shapes.size(), impl_->input_shapes_.size());
+  int batch = -1;
+  for (int i = 0; i < input_shapes.size(); i++) {
+    auto& declared = impl_->input_shapes_[i];
+    CHECK_EQ(input_shapes[i].size(), declared.size()) << "The rank of the input [" << impl_->input_names_[i] << "]";
+    for (int j = 0; j < declared.size(); j++) {
+      if (declared[j] != hlir::framework::kDynamicDim) {
+        CHECK_EQ(input_shapes[i][j], declared[j]) << "The static dimension of the input [" << impl_->input_names_[i]
+                                                  << "] is changed";
+        continue;
+      }
+      if (batch < 0) batch = input_shapes[i][j];
+      CHECK_EQ(input_shapes[i][j], batch) << "The dynamic dimensions of the inputs should be the same batch size";
+    }
+  }
+  if (batch < 0) return;
+  CHECK_GT(batch, 0);
+  impl_->current_ = impl_->GetBucketProgram(batch);
+  impl_->batch_   = batch;
+
+  // Zero the padding rows, so they hold no garbage from the earlier runs or the allocation.
+  for (int i = 0; i < input_shapes.size(); i++) {
+    if (impl_->input_shapes_[i].empty() || impl_->input_shapes_[i][0] != hlir::framework::kDynamicDim) continue;
+    auto tensor   = impl_->current_->scope->GetTensor(impl_->input_names_[i]);
+    int row_bytes = tensor->shape().numel() / tensor->shape().data()[0] * ((tensor->type().bits() + 7) / 8);
+    auto* padding = tensor->buffer()->memory + batch * row_bytes;
+    int num_bytes = (impl_->current_->batch_bucket - batch) * row_bytes;
+    if (impl_->target_.arch == Target::Arch::X86) {
+      std::memset(padding, 0, num_bytes);
+    } else if (impl_->target_.arch == Target::Arch::NVGPU) {
+#ifdef CINN_WITH_CUDA
+      CUDA_CALL(cudaMemset(padding, 0, num_bytes));
+#else
+      LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+    } else {
+      CINN_NOT_IMPLEMENTED
+    }
+  }
+}
+
+int Interpreter::batch_bucket() const { return impl_->current_ ? impl_->current_->batch_bucket : 0; }
+
+void Interpreter::Run() { impl_->current()->runtime_program->Execute(); }
 
 hlir::framework::Tensor Interpreter::GetTensor(const std::string& name) {
-  if (impl_->scope_->FindVar(name)) return impl_->scope_->GetTensor(name);
+  auto* scope    = impl_->current()->scope.get();
+  std::string id = name;
+  if (!scope->FindVar(name)) {
+    auto it = impl_->var_map_paddle_to_cinn_.find(name);
+    if (it == impl_->var_map_paddle_to_cinn_.end()) {
+      LOG(FATAL) << "No variable called [" << name
+                 << "] found in executor\nThe existing vars: " << utils::Join(scope->var_names(), ", ");
+    }
+    id = it->second;
+  }
+  auto tensor = scope->GetTensor(id);
+  if (impl_->batch_ == impl_->current_->batch_bucket || !impl_->batch_vars_.count(id)) return tensor;
+
+  // A view of the rows of the batch, the padding rows are hidden.
+  hlir::framework::Tensor view;
+  view->ShareBufferWith(tensor.get());
+  view->shape()           = tensor->shape();
+  view->shape().data()[0] = impl_->batch_;
+  return view;
+}
+
+Interpreter::Impl::CompiledProgram* Interpreter::Impl::GetBucketProgram(int batch) {
+  if (!batch_independent_) batch_independent_ = IsBatchIndependent();
+  // The batch is not padded if the padding rows could change the result.
+  int bucket = *batch_independent_ ? GetBatchBucket(batch) : batch;
+  auto it    = bucket_programs_.find(bucket);
+  if (it != bucket_programs_.end()) {
+    recent_buckets_.remove(bucket);
+    recent_buckets_.push_front(bucket);
+    return &it->second;
+  }
+
+  size_t max_programs = std::max(FLAGS_cinn_max_batch_programs, 1);
+  while (!bucket_programs_.empty() && bucket_programs_.size() >= max_programs) {
+    LOG(INFO) << "Drop the model of the batch size bucket " << recent_buckets_.back();
+    bucket_programs_.erase(recent_buckets_.back());
+    recent_buckets_.pop_back();
+  }
+
+  LOG(INFO) << "Build the model for the batch size bucket " << bucket;
+  auto input_shapes = input_shapes_;
+  for (auto& shape : input_shapes) {
+    if (!shape.empty() && shape[0] == hlir::framework::kDynamicDim) shape[0] = bucket;
+  }
+  // The parameters are shared by the scopes of all the buckets.
+  auto scope = std::make_shared<hlir::framework::Scope>();
+  for (auto name : scope_->var_names()) {
+    *scope->Var<hlir::framework::Tensor>(std::string(name)) = scope_->GetTensor(std::string(name));
+  }
+  auto program         = Build(input_names_, input_shapes, target_, scope);
+  program.batch_bucket = bucket;
+  recent_buckets_.push_front(bucket);
+  return &bucket_programs_.emplace(bucket, std::move(program)).first->second;
+}
 
-  auto it = impl_->var_map_paddle_to_cinn_.find(name);
-  if (it == impl_->var_map_paddle_to_cinn_.end()) {
-    LOG(FATAL) << "No variable called [" << name
-               << "] found in executor\nThe existing vars: " << utils::Join(impl_->scope_->var_names(), ", ");
+bool Interpreter::Impl::IsBatchIndependent() {
+  const int batches[] = {2, 3};
+  std::unordered_map<std::string, hlir::framework::shape_t> shapes[2];
+  // The graphs take the input shapes from the variables shared with the program, they are restored after the probes.
+  std::vector<hlir::framework::shape_t> saved_shapes;
+  for (auto& name : input_names_) saved_shapes.push_back(var_map_.at(name)->shape);
+  for (int k = 0; k < 2; k++) {
+    for (int i = 0; i < input_names_.size(); i++) {
+      auto shape = input_shapes_[i];
+      if (!shape.empty() && shape[0] == hlir::framework::kDynamicDim) shape[0] = batches[k];
+      var_map_.at(input_names_[i])->shape = shape;
+    }
+    auto graph = std::make_shared<hlir::framework::Graph>(*program_);
+    hlir::framework::ApplyPass(graph.get(), "InferShape");
+    shapes[k] = graph->GetAttrs<std::unordered_map<std::string, hlir::framework::shape_t>>("infershape");
+  }
+  for (int i = 0; i < input_names_.size(); i++) var_map_.at(input_names_[i])->shape = saved_shapes[i];
+
+  batch_vars_.clear();
+  for (int i = 0; i < input_names_.size(); i++) {
+    if (!input_shapes_[i].empty() && input_shapes_[i][0] == hlir::framework::kDynamicDim) {
+      batch_vars_.insert(var_map_.at(input_names_[i])->id);
+    }
+  }
+  for (int i = 0; i < program_->size(); i++) {
+    auto& instr = (*program_)[i];
+    auto input  = std::find_if(instr->inputs.begin(), instr->inputs.end(), [&](const Variable& x) {
+      return batch_vars_.count(x->id);
+    });
+    if (input == instr->inputs.end()) continue;
+    bool independent = !MixesRows(instr, shapes[0].at((*input)->id).size());
+    for (auto& output : instr->outputs) {
+      auto& x = shapes[0].at(output->id);
+      auto& y = shapes[1].at(output->id);
+      independent &= !x.empty() && x.size() == y.size() && x[0] == batches[0] && y[0] == batches[1] &&
+                     std::equal(x.begin() + 1, x.end(), y.begin() + 1);
+      batch_vars_.insert(output->id);
+    }
+    if (!independent) {
+      LOG(WARNING) << "The operation " << instr->op_type << " combines the rows of the batch, the model is compiled "
+                   << "for each batch size without padding";
+      return false;
+    }
   }
-  return impl_->scope_->GetTensor(it->second);
+  return true;
 }
 
-void Interpreter::Impl::Build(const std::vector<std::string>& input_names,
-                              const std::vector<hlir::framework::shape_t>& input_shapes,
-                              const Target& target) {
+Interpreter::Impl::CompiledProgram Interpreter::Impl::Build(const std::vector<std::string>& input_names,
+                                                            const std::vector<hlir::framework::shape_t>& input_shapes,
+                                                            const Target& target,
+                                                            std::shared_ptr<hlir::framework::Scope> scope) {
   CHECK(!input_names.empty());
   CHECK(!var_map_.empty());
   CHECK_EQ(input_names.size(), input_shapes.size());
@@ -84,14 +330,16 @@ void Interpreter::Impl::Build(const std::vector<std::string>& input_names,
 
   hlir::framework::ApplyPass(graph.get(), "InferShape");
   // Target target = common::DefaultHostTarget();
-  scope_ = hlir::framework::BuildScope(target, graph, scope_);
-  graph_compiler_.reset(new hlir::framework::GraphCompiler(target, scope_, graph));
-  runtime_program_ = graph_compiler_->Build();
+  CompiledProgram res;
+  res.scope = hlir::framework::BuildScope(target, graph, scope);
+  res.graph_compiler.reset(new hlir::framework::GraphCompiler(target, res.scope, graph));
+  res.runtime_program = res.graph_compiler->Build();
+  return res;
 }
 
 std::shared_ptr<hlir::framework::Scope> Interpreter::scope() {
   CHECK(impl_->scope_);
-  return impl_->scope_;
+  return impl_->current_ ? impl_->current_->scope : impl_->scope_;
 }
 
 Interpreter::Interpreter(const std::vector<std::string>& input_names,
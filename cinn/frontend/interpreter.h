@@ -1,4 +1,6 @@
 #pragma once
+#include <gflags/gflags.h>
+
 #include <algorithm>
 #include <memory>
 #include <string>
@@ -9,11 +11,20 @@
 #include "cinn/hlir/framework/graph_compiler.h"
 #include "cinn/hlir/framework/scope.h"
 
+DECLARE_int32(cinn_max_batch_bucket);
+DECLARE_int32(cinn_max_batch_programs);
+
 namespace cinn {
 namespace frontend {
 
 /**
  * The executor for a model.
+ *
+ * The leading dimensions of the inputs might be `hlir::framework::kDynamicDim`, for a batch size known only at
+ * runtime. The batch size is then set by `SetInputShapes` before each run, and the model is compiled once per bucket
+ * of the batch size: the powers of 2 up to `FLAGS_cinn_max_batch_bucket`, and its multiples beyond. The inputs are
+ * padded to the bucket with zeros, which is only done if the model computes the rows of a batch independently,
+ * otherwise it is compiled for each batch size. At most `FLAGS_cinn_max_batch_programs` compiled programs are kept.
  */
 class Interpreter final {
  public:
@@ -26,13 +37,26 @@ class Interpreter final {
    */
   void LoadPaddleModel(const std::string& model_dir, const Target& target, bool params_combined = false);
 
+  /**
+   * Set the shapes of the inputs for the following runs, it compiles the model if the bucket of the batch size is new.
+   * @param input_shapes The shapes of the inputs, the dynamic dimensions of which are set to the batch size.
+   */
+  void SetInputShapes(const std::vector<hlir::framework::shape_t>& input_shapes);
+
   /**
    * Run the executor.
    */
   void Run();
 
+  /**
+   * Get a variable of the model. The variables computed from the batch hold the rows of the batch size set, they are
+   * views of the leading rows of the tensors of the bucket.
+   */
   hlir::framework::Tensor GetTensor(const std::string& name);
 
+  //! The leading dimension of the dynamic inputs the current program is compiled for, at least the batch size.
+  int batch_bucket() const;
+
   std::shared_ptr<hlir::framework::Scope> scope();
 
   ~Interpreter();
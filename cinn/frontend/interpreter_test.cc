@@ -15,4 +15,53 @@ TEST(Interpreter, basic) {
   executor.GetTensor("fc_0.tmp_2");
 }
 
+TEST(Interpreter, dynamic_batch) {
+  auto target = common::DefaultHostTarget();
+  Interpreter executor({"A"}, {{hlir::framework::kDynamicDim, 30}});
+  executor.LoadPaddleModel(FLAGS_model_dir, target);
+
+  for (int batch : {3, 4, 1, 7}) {
+    Interpreter expected({"A"}, {{batch, 30}});
+    expected.LoadPaddleModel(FLAGS_model_dir, target);
+
+    executor.SetInputShapes({{batch, 30}});
+    // The fc model computes the rows independently, so the batch is padded to a power of 2.
+    ASSERT_GE(executor.batch_bucket(), batch);
+    ASSERT_EQ(executor.batch_bucket() & (executor.batch_bucket() - 1), 0);
+    ASSERT_EQ(executor.GetTensor("A")->shape().data()[0], batch);
+    auto* a          = executor.GetTensor("A")->mutable_data<float>(target);
+    auto* expected_a = expected.GetTensor("A")->mutable_data<float>(target);
+    for (int i = 0; i < batch * 30; i++) a[i] = expected_a[i] = static_cast<float>(i % 17) / 17;
+    executor.Run();
+    expected.Run();
+
+    auto out          = executor.GetTensor("fc_0.tmp_2");
+    auto expected_out = expected.GetTensor("fc_0.tmp_2");
+    ASSERT_EQ(out->shape().data()[0], batch);
+    ASSERT_EQ(out->shape().numel(), expected_out->shape().numel());
+    int num_used = expected_out->shape().numel();
+    for (int i = 0; i < num_used; i++) {
+      EXPECT_NEAR(out->data<float>()[i], expected_out->data<float>()[i], 1e-5);
+    }
+  }
+}
+
+TEST(Interpreter, max_batch_programs) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_max_batch_programs = 2;
+  auto target                   = common::DefaultHostTarget();
+  Interpreter executor({"A"}, {{hlir::framework::kDynamicDim, 30}});
+  executor.LoadPaddleModel(FLAGS_model_dir, target);
+
+  // The bucket of 1 is dropped for the one of 4, and compiled again.
+  for (int batch : {1, 2, 4, 1}) {
+    executor.SetInputShapes({{batch, 30}});
+    ASSERT_EQ(executor.batch_bucket(), batch);
+    auto* a = executor.GetTensor("A")->mutable_data<float>(target);
+    for (int i = 0; i < batch * 30; i++) a[i] = 1.f;
+    executor.Run();
+    ASSERT_EQ(executor.GetTensor("fc_0.tmp_2")->shape().data()[0], batch);
+  }
+}
+
 }  // namespace cinn::frontend
@@ -1,10 +1,13 @@
 #include "cinn/hlir/framework/graph.h"
 
+#include "cinn/utils/profiler.h"
+
 namespace cinn {
 namespace hlir {
 namespace framework {
 
 Graph::Graph(const frontend::Program& prog) {
+  utils::ProfileTimer timer("frontend.BuildGraph");
   std::unordered_map<std::string, shape_t> shape_dict;
   std::unordered_map<std::string, common::Type> dtype_dict;
   int counter = 0;
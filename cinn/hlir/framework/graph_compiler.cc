@@ -1,15 +1,51 @@
 #include "cinn/hlir/framework/graph_compiler.h"
 
+#include <cmath>
 #include <unordered_map>
 
 #include "cinn/backends/codegen_cuda_dev.h"
 #include "cinn/hlir/framework/instruction.h"
+#include "cinn/hlir/framework/kernel_cache.h"
 #include "cinn/hlir/framework/tensor.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace hlir {
 namespace framework {
 
+namespace {
+
+double Numel(const shape_t& shape) {
+  double res = 1;
+  for (int dim : shape) res *= dim;
+  return res;
+}
+
+/**
+ * Estimate the floating point operations of a run of an op by the shapes: a multiply-add per element of the
+ * reduction for the matrix multiplications and the convolutions, an operation per output element for the others.
+ */
+double EstimateFlops(const std::string& op_type,
+                     const std::vector<shape_t>& in_shapes,
+                     const std::vector<shape_t>& out_shapes) {
+  if (out_shapes.empty()) return 0;
+  double out_numel = Numel(out_shapes[0]);
+  if ((op_type == "matmul" || op_type == "mul" || op_type == "mulbias") && in_shapes.size() >= 2) {
+    // (B x M x K) * (B x K x N) -> (B x M x N), whatever the transposes are.
+    auto& out    = out_shapes[0];
+    double batch = out.size() > 2 ? out_numel / (out[out.size() - 2] * out[out.size() - 1]) : 1;
+    double k     = std::sqrt(Numel(in_shapes[0]) * Numel(in_shapes[1]) / out_numel / batch);
+    return 2 * out_numel * k;
+  }
+  if ((op_type == "conv2d" || op_type == "depthwise_conv2d") && in_shapes.size() >= 2 && !in_shapes[1].empty()) {
+    // The weights are of the output channels x the input channels of a group x the kernel size.
+    return 2 * out_numel * Numel(in_shapes[1]) / in_shapes[1][0];
+  }
+  return out_numel;
+}
+
+}  // namespace
+
 void GraphCompiler::PrintFunc() {
   auto [nodes, edges] = graph_->topological_order();
   for (auto& n : nodes) {
@@ -21,10 +57,31 @@ void GraphCompiler::PrintFunc() {
 }
 
 std::unique_ptr<Program> GraphCompiler::Build(const std::string& code) {
+  // The code given is compiled as a whole, the kernels in it are not shared.
+  bool use_cache = FLAGS_cinn_kernel_cache && code.empty();
+  // The kernels to compile in this module, by key.
+  std::unordered_map<std::string, std::string> fn_names;
+  // The functions of the kernels reused from the cache, they are only printed with the source of this module.
+  std::vector<ir::LoweredFunc> reused_funcs;
+
   auto [nodes, edges] = graph_->topological_order();
   for (auto& n : nodes) {
     auto* node = n->safe_as<Node>();
     if (node) {
+      if (use_cache) {
+        auto key                 = GetOpKernelKey(node);
+        kernel_keys_[node->id()] = key;
+        if (kernels_.count(key) || fn_names.count(key)) continue;
+        auto kernel = KernelCache::Global().Lookup(key);
+        if (kernel.fn) {
+          VLOG(3) << "Reuse the cached kernel " << kernel.func->name << " of node " << node->id();
+          kernels_[key] = kernel.fn;
+          kernel_compilers_.push_back(kernel.compiler);
+          reused_funcs.push_back(kernel.func);
+          continue;
+        }
+        fn_names[key] = GenOpFuncName(node);
+      }
       auto lowered_func = GetOpFunc(node);
       m_builder_.AddFunction(lowered_func);
     }
@@ -36,6 +93,26 @@ std::unique_ptr<Program> GraphCompiler::Build(const std::string& code) {
 
   auto build_module = m_builder_.Build();
 
+  if (!use_cache || !fn_names.empty()) {
+    utils::ProfileTimer timer("backend.Build");
+    compiler_->Build(build_module, code);
+  }
+
+  std::unordered_map<std::string, ir::LoweredFunc> funcs;
+  for (auto& func : build_module.functions()) funcs[func->name] = func;
+  for (auto& [key, fn_name] : fn_names) {
+    auto* fn = compiler_->Lookup(fn_name);
+    CHECK(fn) << "Failed to compile the kernel " << fn_name;
+    kernels_[key] = fn;
+    KernelCache::Global().Insert(key, KernelCache::Kernel{fn, compiler_, funcs.at(fn_name)});
+  }
+
+  // The module is compiled, add the reused functions so it holds all the functions of the graph. A function reused by
+  // several nodes, or named as a function compiled here by the graph it is from, is added once.
+  for (auto& func : reused_funcs) {
+    if (funcs.emplace(func->name, func).second) m_builder_.AddFunction(func);
+  }
+
   if (this->target_.arch == Target::Arch::X86) {
     CodeGenCX86 codegen(this->target_, CodeGenCX86::Feature::AVX512);
     codegen.SetInlineBuiltinCodes(false);
@@ -43,8 +120,6 @@ std::unique_ptr<Program> GraphCompiler::Build(const std::string& code) {
     LOG(INFO) << "[X86] C Code is:\n" << out;
   }
 
-  compiler_->Build(build_module, code);
-
   return std::unique_ptr<Program>(new Program(scope_, BuildInstructions()));
 }
 
@@ -57,16 +132,48 @@ std::vector<std::unique_ptr<Instruction>> GraphCompiler::BuildInstructions() {
     if (node) {
       auto instr = std::unique_ptr<Instruction>(
           new Instruction(target_, scope_.get(), OpGetInputNames(node), OpGetOutputNames(node)));
-      auto* fn = compiler_->Lookup(GenOpFuncName(node));
+      auto it  = kernel_keys_.find(node->id());
+      auto* fn = it != kernel_keys_.end() ? kernels_.at(it->second) : compiler_->Lookup(GenOpFuncName(node));
       CHECK(fn);
       instr->SetLoweredFunc(fn);
+      instr->SetProfileInfo(GetOpProfileInfo(node));
       instructions.push_back(std::move(instr));
     }
   }
   return instructions;
 }
 
+RuntimeProfiler::InstructionInfo GraphCompiler::GetOpProfileInfo(const Node* node) const {
+  auto& shape_dict = graph_->GetAttrs<std::unordered_map<std::string, shape_t>>("infershape");
+  RuntimeProfiler::InstructionInfo info;
+  info.name    = node->id();
+  info.op_type = node->op()->name;
+  for (auto& id : OpGetInputNames(node)) info.in_shapes.push_back(shape_dict.at(id));
+  for (auto& id : OpGetOutputNames(node)) info.out_shapes.push_back(shape_dict.at(id));
+  info.flops = EstimateFlops(info.op_type, info.in_shapes, info.out_shapes);
+  return info;
+}
+
+std::string GraphCompiler::GetOpKernelKey(const Node* node) const {
+  auto& shape_dict = graph_->GetAttrs<std::unordered_map<std::string, shape_t>>("infershape");
+  auto& dtype_dict = graph_->GetAttrs<std::unordered_map<std::string, Type>>("inferdtype");
+  std::vector<std::vector<int>> in_shapes, out_shapes;
+  std::vector<Type> in_types, out_types;
+  for (auto& id : OpGetInputNames(node)) {
+    in_shapes.push_back(shape_dict.at(id));
+    in_types.push_back(dtype_dict.at(id));
+  }
+  for (auto& id : OpGetOutputNames(node)) {
+    out_shapes.push_back(shape_dict.at(id));
+    out_types.push_back(dtype_dict.at(id));
+  }
+  return KernelCache::Key(
+      node->op()->name, node->attrs.attr_store, in_shapes, in_types, out_shapes, out_types, target_);
+}
+
 ir::LoweredFunc GraphCompiler::GetOpFunc(const Node* node) {
+  utils::ProfileOpScope op_scope(node->id());
+  utils::ProfileTimer timer("op.GetOpFunc");
   auto& strategy   = Operator::GetAttrs<StrategyFunction>("CINNStrategy");
   auto& shape_dict = graph_->GetAttrs<std::unordered_map<std::string, shape_t>>("infershape");
   auto& dtype_dict = graph_->GetAttrs<std::unordered_map<std::string, Type>>("inferdtype");
@@ -94,15 +201,22 @@ ir::LoweredFunc GraphCompiler::GetOpFunc(const Node* node) {
   }
   auto impl = OpStrategy::SelectImpl(strategy[node->op()](node->attrs, inputs, out_types, output_shapes, target_));
 
-  common::CINNValuePack C = impl->fcompute(common::CINNValuePack{cinn_inputs});
-  poly::StageMap stages   = C.back();
+  // CINNValuePack has no default constructor, time the compute in a lambda.
+  common::CINNValuePack C = [&] {
+    utils::ProfileTimer timer("op.compute");
+    return impl->fcompute(common::CINNValuePack{cinn_inputs});
+  }();
+  poly::StageMap stages = C.back();
   // make sure all the tensors in the stages before schedule launch.
   for (int i = 0; i < C->size() - 1; i++) {
     ir::Expr temp = C[i];
     stages->InsertLazily(temp.as_tensor_ref());
   }
 
-  C = impl->fschedule(C);
+  {
+    utils::ProfileTimer timer("op.schedule");
+    C = impl->fschedule(C);
+  }
   for (int i = 0; i < C->size() - 1; i++) {
     ir::Expr temp = C[i];
     inputs.push_back(temp.as_tensor_ref());
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -55,17 +56,22 @@ class Program {
     }
   }
 
+  /**
+   * Time the program, the per-instruction details are printed if the RuntimeProfiler is enabled.
+   */
   void ExecuteTest(int repeat_) {
     cinn::utils::Timer timer1;
     for (int i = 0; i < 100; i++) {
       for (auto& ins : instrs_) {
-        ins->RunTest(repeat_);
+        ins->Run();
       }
     }
+    // The summary is of the timed runs only, the events recorded before are kept for the others.
+    uint64_t num_events = RuntimeProfiler::Global().num_events();
     timer1.Start();
     for (int i = 0; i < repeat_; i++) {
       for (auto& ins : instrs_) {
-        ins->RunTest(repeat_);
+        ins->Run();
       }
     }
 #ifdef CINN_WITH_CUDA
@@ -73,12 +79,15 @@ class Program {
 #endif
     double test_op_time = timer1.Stop() / repeat_;
     LOG(INFO) << "Repeat times: [" << repeat_ << "], average op time: [" << test_op_time << "] ms";
+    if (RuntimeProfiler::Global().enabled()) LOG(INFO) << "\n" << RuntimeProfiler::Global().SummaryTable(num_events);
   }
   /**
    * Get the number of instructions.
    */
   size_t size() const { return instrs_.size(); }
 
+  const std::vector<std::unique_ptr<Instruction>>& GetRunInstructions() const { return instrs_; }
+
  private:
   // We need to hold scope to assure tensors alive used in instructions.
   std::shared_ptr<Scope> scope_;
@@ -102,6 +111,12 @@ class GraphCompiler final {
  private:
   ir::LoweredFunc GetOpFunc(const Node* node);
 
+  //! Get the signature of the kernel of \p node in the KernelCache.
+  std::string GetOpKernelKey(const Node* node) const;
+
+  //! Get the description of the Instruction of \p node in the RuntimeProfiler.
+  RuntimeProfiler::InstructionInfo GetOpProfileInfo(const Node* node) const;
+
   std::string GenOpFuncName(const Node* node) const { return "fn_" + node->id(); }
 
   // TODO(haozech) add implementation
@@ -116,7 +131,14 @@ class GraphCompiler final {
   std::shared_ptr<Graph> graph_;
   std::shared_ptr<Scope> scope_;
 
-  std::unique_ptr<backends::Compiler> compiler_;
+  std::shared_ptr<backends::Compiler> compiler_;
+
+  //! The kernel keys of the nodes, empty if the kernel cache is not used.
+  std::unordered_map<std::string, std::string> kernel_keys_;
+  //! The kernels of this graph by key.
+  std::unordered_map<std::string, lower_func_ptr_t> kernels_;
+  //! The compilers holding the kernels reused from the KernelCache.
+  std::vector<std::shared_ptr<backends::Compiler>> kernel_compilers_;
 
   ir::Module::Builder m_builder_;
 
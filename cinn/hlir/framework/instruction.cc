@@ -24,6 +24,23 @@ std::vector<cinn_pod_value_t>& Instruction::PreparePodArgs() {
   return args_cached_;
 }
 
+void Instruction::RunProfiled(std::vector<cinn_pod_value_t>* pod_args) {
+  auto& profiler = RuntimeProfiler::Global();
+  if (profile_id_ < 0) {
+    if (profile_info_.name.empty()) profile_info_.name = utils::Join(out_args_, ", ");
+    if (profile_info_.op_type.empty()) profile_info_.op_type = "-";
+    profile_id_ = profiler.RegisterInstruction(profile_info_);
+  }
+  auto start_counts = profiler.ReadHardwareCounters();
+  int64_t start_ns  = profiler.Now();
+  fn_(pod_args->data(), pod_args->size());
+#ifdef CINN_WITH_CUDA
+  CUDA_CALL(cudaDeviceSynchronize());
+#endif
+  int64_t end_ns = profiler.Now();
+  profiler.Record(profile_id_, start_ns, end_ns, profiler.ReadHardwareCounters().Since(start_counts));
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
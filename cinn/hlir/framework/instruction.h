@@ -5,6 +5,7 @@
 
 #include "cinn/backends/cuda_util.h"
 #include "cinn/common/test_helper.h"
+#include "cinn/hlir/framework/runtime_profiler.h"
 #include "cinn/hlir/framework/scope.h"
 #include "cinn/utils/timer.h"
 
@@ -40,19 +41,25 @@ class Instruction {
    * @param fn The JIT compiled function address.
    */
   void SetLoweredFunc(lower_func_ptr_t fn) { fn_ = fn; }
+  lower_func_ptr_t GetLoweredFunc() const { return fn_; }
+
+  //! Set the description of this Instruction in the RuntimeProfiler.
+  void SetProfileInfo(const RuntimeProfiler::InstructionInfo& info) { profile_info_ = info; }
 
   void RunTest(int repeat_) {
-    CHECK(fn_) << "The LoweredFunc address should be set first by calling SetLoweredFunc method";
-    auto& pod_args = PreparePodArgs();
-    fn_(pod_args.data(), pod_args.size());
+    for (int i = 0; i < repeat_; i++) Run();
   }
 
   /**
-   * Run the Instruction.
+   * Run the Instruction, the run is recorded if the RuntimeProfiler is enabled.
    */
   void Run() {
     CHECK(fn_) << "The LoweredFunc address should be set first by calling SetLoweredFunc method";
     auto& pod_args = PreparePodArgs();
+    if (RuntimeProfiler::Global().enabled()) {
+      RunProfiled(&pod_args);
+      return;
+    }
     fn_(pod_args.data(), pod_args.size());
   }
   std::vector<std::string> GetInArgs() { return in_args_; }
@@ -61,6 +68,8 @@ class Instruction {
  protected:
   std::vector<cinn_pod_value_t>& PreparePodArgs();
 
+  void RunProfiled(std::vector<cinn_pod_value_t>* pod_args);
+
  private:
   Scope* scope_{};
   std::vector<std::string> in_args_;
@@ -71,6 +80,10 @@ class Instruction {
   Target target_;
 
   lower_func_ptr_t fn_{};
+
+  RuntimeProfiler::InstructionInfo profile_info_;
+  //! The id in the RuntimeProfiler, it is registered on the first profiled run.
+  int profile_id_{-1};
 };
 
 }  // namespace framework
@@ -77,6 +77,30 @@ TEST(Instruction, basic) {
   }
 }
 
+TEST(Instruction, profile) {
+  Scope scope;
+  for (auto& name : std::vector<std::string>({"x", "y", "z"})) {
+    auto tensor = std::get<Tensor>(*scope.Var<Tensor>(name));
+    tensor->Resize(Shape{{10, 20}});
+    tensor->mutable_data<float>(common::DefaultHostTarget());
+  }
+  Instruction instr(common::DefaultHostTarget(), &scope, {"x", "y"}, {"z"});
+  auto jit = GetLoweredFunc(10, 20);
+  instr.SetLoweredFunc(reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn")));
+  instr.SetProfileInfo({"add_0", "elementwise_add", {{10, 20}, {10, 20}}, {{10, 20}}, 200});
+
+  auto& profiler = RuntimeProfiler::Global();
+  profiler.Clear();
+  profiler.set_enabled(true);
+  instr.RunTest(3);
+  profiler.set_enabled(false);
+  instr.Run();
+
+  auto stats = profiler.Aggregate();
+  ASSERT_EQ(stats.at("elementwise_add").calls, 3);
+  profiler.Clear();
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -0,0 +1,149 @@
+#include "cinn/hlir/framework/kernel_cache.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include "cinn/backends/llvm/llvm_vector_math.h"
+#include "cinn/lang/auto_compute_at.h"
+#include "cinn/optim/insert_loop_profile.h"
+#include "cinn/optim/partition_loops.h"
+#include "cinn/optim/reduce_index_strength.h"
+#include "cinn/optim/vectorize_loops.h"
+#include "cinn/poly/dependence.h"
+#include "cinn/utils/profiler.h"
+
+DEFINE_bool(cinn_kernel_cache,
+            false,
+            "Whether to share the compiled kernels between the nodes of the same op signature in the process");
+
+DEFINE_int32(cinn_kernel_cache_capacity, 1024, "The maximum number of the kernels kept by the kernel cache");
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+
+template <typename T>
+void PrintValue(std::ostream& os, const T& x) {
+  os << x;
+}
+void PrintValue(std::ostream& os, const std::string& x) { os << x.size() << ':' << x; }
+template <typename T>
+void PrintValue(std::ostream& os, const std::vector<T>& x) {
+  os << '[';
+  for (auto& v : x) {
+    PrintValue(os, v);
+    os << ',';
+  }
+  os << ']';
+}
+void PrintValue(std::ostream& os, const std::vector<bool>& x) {
+  os << '[';
+  for (bool v : x) os << v << ',';
+  os << ']';
+}
+
+void PrintTensors(std::ostream& os, const std::vector<std::vector<int>>& shapes, const std::vector<Type>& types) {
+  CHECK_EQ(shapes.size(), types.size());
+  for (int i = 0; i < shapes.size(); i++) {
+    os << types[i] << '[';
+    for (int dim : shapes[i]) os << dim << ',';
+    os << "];";
+  }
+}
+
+}  // namespace
+
+KernelCache& KernelCache::Global() {
+  static KernelCache x;
+  return x;
+}
+
+std::string KernelCache::Key(const std::string& op_name,
+                             const std::unordered_map<std::string, AttrType>& attrs,
+                             const std::vector<std::vector<int>>& in_shapes,
+                             const std::vector<Type>& in_types,
+                             const std::vector<std::vector<int>>& out_shapes,
+                             const std::vector<Type>& out_types,
+                             const Target& target) {
+  std::stringstream os;
+  // Print the floats exactly, and the attributes in a stable order.
+  os << std::hexfloat;
+  os << op_name << '|';
+  std::map<std::string, const AttrType*> sorted_attrs;
+  for (auto& item : attrs) sorted_attrs.emplace(item.first, &item.second);
+  for (auto& [name, attr] : sorted_attrs) {
+    os << name << '=' << attr->index() << ':';
+    std::visit([&](auto& x) { PrintValue(os, x); }, *attr);
+    os << ';';
+  }
+  os << "|in:";
+  PrintTensors(os, in_shapes, in_types);
+  os << "|out:";
+  PrintTensors(os, out_shapes, out_types);
+  os << "|target:" << static_cast<int>(target.os) << ',' << static_cast<int>(target.arch) << ','
+     << static_cast<int>(target.bits);
+  for (auto feature : target.features) os << ',' << static_cast<int>(feature);
+  // The flags of the lowering and the code generation, the same op compiles to a different kernel under them.
+  os << "|flags:" << FLAGS_cinn_auto_compute_at << ',' << FLAGS_cinn_auto_compute_at_cache_bytes << ','
+     << FLAGS_cinn_partition_loops << ',' << FLAGS_cinn_reduce_index_strength << ',' << FLAGS_cinn_loop_profile_depth
+     << ',' << FLAGS_cinn_llvm_vector_math << ',' << FLAGS_cinn_llvm_vector_math_max_ulp << ','
+     << FLAGS_cinn_auto_parallel << ',' << FLAGS_cinn_auto_vectorize;
+  return os.str();
+}
+
+KernelCache::Kernel KernelCache::Lookup(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = kernels_.find(key);
+  if (it == kernels_.end()) {
+    num_misses_++;
+    return Kernel();
+  }
+  num_hits_++;
+  if (utils::CompileProfiler::Global().enabled()) utils::CompileProfiler::Global().AddCount("kernel_cache.hits", 1);
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void KernelCache::Insert(const std::string& key, Kernel kernel) {
+  CHECK(kernel.fn) << "The kernel of " << key << " is not compiled";
+  std::lock_guard<std::mutex> lock(mu_);
+  if (kernels_.count(key)) return;
+  entries_.emplace_front(key, std::move(kernel));
+  kernels_[key] = entries_.begin();
+  while (entries_.size() > static_cast<size_t>(std::max(FLAGS_cinn_kernel_cache_capacity, 1))) {
+    VLOG(3) << "Evict the kernel " << entries_.back().first;
+    kernels_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+size_t KernelCache::size() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return kernels_.size();
+}
+
+size_t KernelCache::num_hits() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return num_hits_;
+}
+
+size_t KernelCache::num_misses() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return num_misses_;
+}
+
+void KernelCache::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  kernels_.clear();
+  entries_.clear();
+  num_hits_   = 0;
+  num_misses_ = 0;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
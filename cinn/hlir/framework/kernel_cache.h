@@ -0,0 +1,93 @@
+#pragma once
+
+#include <gflags/gflags.h>
+
+#include <list>
+#include <memory>
+#include <mutex>  //NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/backends/compiler.h"
+#include "cinn/common/target.h"
+#include "cinn/common/type.h"
+#include "cinn/hlir/framework/node.h"
+
+DECLARE_bool(cinn_kernel_cache);
+DECLARE_int32(cinn_kernel_cache_capacity);
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The process-wide cache of the compiled op kernels.
+ *
+ * A kernel is keyed by its signature: the op name, the attributes, the shapes and dtypes of the inputs and outputs, the
+ * target and the flags changing the generated code. The op strategies select the compute and schedule only by them, so
+ * the nodes with the same signature lower to the same function and share one compiled kernel, in one graph or across
+ * the GraphCompilers of the process. A kernel keeps the Compiler holding its code alive, so the cache keeps at most
+ * `cinn_kernel_cache_capacity` kernels and evicts the least recently used one. It is enabled by the flag
+ * `cinn_kernel_cache`.
+ */
+class KernelCache {
+ public:
+  struct Kernel {
+    lower_func_ptr_t fn{};
+    //! The compiler owning the code of `fn`.
+    std::shared_ptr<backends::Compiler> compiler;
+    //! The optimized function compiled to `fn`, to print the source of the graphs reusing it.
+    ir::LoweredFunc func;
+  };
+
+  static KernelCache& Global();
+
+  /**
+   * Get the signature of a kernel.
+   * @param op_name The name of the op.
+   * @param attrs The attributes of the op.
+   * @param in_shapes The shapes of the inputs.
+   * @param in_types The dtypes of the inputs.
+   * @param out_shapes The shapes of the outputs.
+   * @param out_types The dtypes of the outputs.
+   * @param target The target the kernel runs on.
+   */
+  static std::string Key(const std::string& op_name,
+                         const std::unordered_map<std::string, AttrType>& attrs,
+                         const std::vector<std::vector<int>>& in_shapes,
+                         const std::vector<Type>& in_types,
+                         const std::vector<std::vector<int>>& out_shapes,
+                         const std::vector<Type>& out_types,
+                         const Target& target);
+
+  //! Get the kernel of \p key, the `fn` is null if it is not cached.
+  Kernel Lookup(const std::string& key);
+
+  //! Cache a kernel, the kernel cached before with the same key is kept. The least recently used kernel is evicted if
+  //! the cache is full.
+  void Insert(const std::string& key, Kernel kernel);
+
+  size_t size() const;
+  size_t num_hits() const;
+  size_t num_misses() const;
+
+  //! Drop all the kernels, the compilers no more referenced get released.
+  void Clear();
+
+ private:
+  KernelCache() = default;
+
+  using Entry = std::pair<std::string, Kernel>;
+
+  mutable std::mutex mu_;
+  //! The kernels from the most recently used.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> kernels_;
+  size_t num_hits_{};
+  size_t num_misses_{};
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,157 @@
+#include "cinn/hlir/framework/kernel_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/frontend/syntax.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinn/optim/insert_loop_profile.h"
+#include "cinn/poly/dependence.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+
+Tensor GetTensor(const std::shared_ptr<Scope>& scope, const std::string& name) {
+  auto* var = scope->Var<Tensor>(name);
+  return std::get<Tensor>(*var);
+}
+
+void SetRandData(Tensor tensor, Target target) {
+  auto* data = tensor->mutable_data<float>(target);
+  for (size_t j = 0; j < tensor->shape().numel(); j++) {
+    data[j] = (rand() * 1.f) / RAND_MAX;  // All random data
+  }
+}
+
+//! Build and run `e = c + (c + B)` with `c = A + B`, the three adds share the same signature.
+void RunAdds(const Target& target) {
+  frontend::Program prog;
+  frontend::Variable a("A");
+  frontend::Variable b("B");
+  a->shape = {100, 32};
+  b->shape = {100, 32};
+  a->type  = Float(32);
+  b->type  = Float(32);
+  auto c   = prog.add(a, b);
+  auto d   = prog.add(c, b);
+  auto e   = prog.add(c, d);
+  auto g   = std::make_shared<Graph>(prog);
+  ApplyPass(g.get(), "InferShape");
+
+  auto scope = BuildScope(target, g);
+  GraphCompiler gc(target, scope, g);
+  auto program = gc.Build();
+  ASSERT_EQ(program->size(), 3UL);
+
+  auto A = GetTensor(scope, "A");
+  auto B = GetTensor(scope, "B");
+  SetRandData(A, target);
+  SetRandData(B, target);
+  program->Execute();
+
+  auto* A_data = A->data<float>();
+  auto* B_data = B->data<float>();
+  auto* E_data = GetTensor(scope, e->id)->data<float>();
+  for (int i = 0; i < 100 * 32; i++) {
+    ASSERT_NEAR(2 * A_data[i] + 3 * B_data[i], E_data[i], 1e-5);
+  }
+}
+
+}  // namespace
+
+TEST(KernelCache, Key) {
+  Target target(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {});
+  std::unordered_map<std::string, AttrType> attrs{{"axis", -1}, {"stride", std::vector<int>{1, 2}}};
+
+  auto key = KernelCache::Key("elementwise_add", attrs, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target);
+  ASSERT_EQ(key, KernelCache::Key("elementwise_add", attrs, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+
+  ASSERT_NE(key, KernelCache::Key("elementwise_mul", attrs, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+  ASSERT_NE(key, KernelCache::Key("elementwise_add", attrs, {{20, 10}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+  ASSERT_NE(key, KernelCache::Key("elementwise_add", {}, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+  attrs["axis"] = 0;
+  ASSERT_NE(key, KernelCache::Key("elementwise_add", attrs, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+}
+
+TEST(KernelCache, key_of_flags) {
+  gflags::FlagSaver flag_saver;
+  Target target(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {});
+  auto key = KernelCache::Key("elementwise_add", {}, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target);
+  FLAGS_cinn_loop_profile_depth++;
+  ASSERT_NE(key, KernelCache::Key("elementwise_add", {}, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+
+  key = KernelCache::Key("elementwise_add", {}, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target);
+  FLAGS_cinn_auto_parallel = !FLAGS_cinn_auto_parallel;
+  ASSERT_NE(key, KernelCache::Key("elementwise_add", {}, {{10, 20}}, {Float(32)}, {{10, 20}}, {Float(32)}, target));
+}
+
+TEST(KernelCache, evict_least_recently_used) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_kernel_cache_capacity = 2;
+  auto& cache = KernelCache::Global();
+  cache.Clear();
+
+  // Any non-null pointer stands for a kernel, it is not called.
+  auto fn = reinterpret_cast<lower_func_ptr_t>(&SetRandData);
+  cache.Insert("a", KernelCache::Kernel{fn});
+  cache.Insert("b", KernelCache::Kernel{fn});
+  ASSERT_TRUE(cache.Lookup("a").fn);
+  cache.Insert("c", KernelCache::Kernel{fn});
+  ASSERT_EQ(cache.size(), 2UL);
+  ASSERT_TRUE(cache.Lookup("a").fn);
+  ASSERT_FALSE(cache.Lookup("b").fn);
+  ASSERT_TRUE(cache.Lookup("c").fn);
+
+  cache.Clear();
+}
+
+TEST(KernelCache, share_kernels) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_kernel_cache = true;
+  Target target(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {});
+  auto& cache = KernelCache::Global();
+  cache.Clear();
+
+  // The adds of the same signature in a graph share one kernel.
+  RunAdds(target);
+  ASSERT_EQ(cache.size(), 1UL);
+  ASSERT_EQ(cache.num_hits(), 0UL);
+
+  // The kernel is reused by the graphs compiled later.
+  RunAdds(target);
+  ASSERT_EQ(cache.size(), 1UL);
+  ASSERT_EQ(cache.num_hits(), 1UL);
+
+  cache.Clear();
+}
+
+TEST(KernelCache, miss_on_auto_parallel) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_kernel_cache = true;
+  Target target(Target::OS::Linux, Target::Arch::X86, Target::Bit::k64, {});
+  auto& cache = KernelCache::Global();
+  cache.Clear();
+
+  RunAdds(target);
+  ASSERT_EQ(cache.size(), 1UL);
+  size_t num_misses = cache.num_misses();
+
+  // The kernel compiled with the loops parallel or serial is not reused by the other.
+  FLAGS_cinn_auto_parallel = !FLAGS_cinn_auto_parallel;
+  RunAdds(target);
+  ASSERT_EQ(cache.size(), 2UL);
+  ASSERT_EQ(cache.num_hits(), 0UL);
+  ASSERT_GT(cache.num_misses(), num_misses);
+
+  cache.Clear();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
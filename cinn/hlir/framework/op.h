@@ -22,6 +22,9 @@ class Operator;
 using shape_t = std::vector<int32_t>;
 using dim_t   = shape_t ::value_type;
 
+//! A dimension known only at runtime, such as the batch size of the inputs of a frontend::Interpreter.
+constexpr dim_t kDynamicDim = -1;
+
 struct OpRegistry : public Registry<Operator> {
   std::recursive_mutex mutex;
   std::atomic<int> op_counter{0};
@@ -1,6 +1,7 @@
 #include "cinn/hlir/framework/pass.h"
 
 #include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace hlir {
@@ -22,6 +23,7 @@ void ApplyPasses(Graph* g, const std::vector<std::string>& passes) {
         CHECK(!pass_dep) << "And the attribute is provided by pass [" << pass_dep->name << "].";
       }
     }
+    utils::ProfileTimer timer("graph_pass." + r->name);
     r->body(g);
   }
 }
@@ -0,0 +1,285 @@
+#include "cinn/hlir/framework/runtime_profiler.h"
+
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+namespace {
+
+std::atomic<int> num_threads{0};
+
+//! A small id of the current thread for the trace.
+int GetThreadId() {
+  thread_local int id = num_threads.fetch_add(1);
+  return id;
+}
+
+#ifdef __linux__
+//! The hardware counters of the current thread opened by perf_event_open, a descriptor is -1 if unavailable.
+struct ThreadHardwareCounters {
+  ThreadHardwareCounters() {
+    instructions = Open(PERF_COUNT_HW_INSTRUCTIONS);
+    cache_misses = Open(PERF_COUNT_HW_CACHE_MISSES);
+    if (instructions < 0 || cache_misses < 0) {
+      LOG_FIRST_N(WARNING, 1) << "Failed to open the hardware counters: " << std::strerror(errno);
+    }
+  }
+
+  ~ThreadHardwareCounters() {
+    if (instructions >= 0) close(instructions);
+    if (cache_misses >= 0) close(cache_misses);
+  }
+
+  //! Count the user space events of type \p config on the current thread.
+  static int Open(uint64_t config) {
+    perf_event_attr attr{};
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  static int64_t Read(int fd) {
+    int64_t value;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+    return value;
+  }
+
+  int instructions{-1};
+  int cache_misses{-1};
+};
+#endif
+
+std::string JsonString(const std::string& s) {
+  std::string res = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') res += '\\';
+    res += c;
+  }
+  return res + "\"";
+}
+
+std::string ShapesToString(const std::vector<std::vector<int>>& shapes) {
+  std::vector<std::string> res;
+  for (auto& shape : shapes) res.push_back("[" + utils::Join(shape, ", ") + "]");
+  return utils::Join(res, ", ");
+}
+
+//! Get the value at the quantile \p q of the sorted \p values.
+double Quantile(const std::vector<double>& values, double q) {
+  int i = std::min<int>(values.size() - 1, static_cast<int>(q * values.size()));
+  return values[i];
+}
+
+}  // namespace
+
+RuntimeProfiler::RuntimeProfiler() {
+  epoch_ns_       = Now();
+  const char* env = std::getenv("CINN_RUNTIME_PROFILE");
+  if (env && *env && std::string(env) != "0") {
+    enabled_    = true;
+    trace_path_ = std::string(env) == "1" ? "cinn_runtime_trace.json" : env;
+  }
+  const char* hw_env = std::getenv("CINN_RUNTIME_PROFILE_HW");
+  hardware_counters_ = hw_env && *hw_env && std::string(hw_env) != "0";
+}
+
+RuntimeProfiler::~RuntimeProfiler() {
+  if (!trace_path_.empty()) {
+    std::cerr << SummaryTable();
+    std::ofstream os(trace_path_);
+    if (os) {
+      os << ToChromeTrace();
+    } else {
+      std::cerr << "Failed to write the runtime trace to " << trace_path_ << std::endl;
+    }
+  }
+  delete[] slots_.load();
+}
+
+RuntimeProfiler& RuntimeProfiler::Global() {
+  static RuntimeProfiler x;
+  return x;
+}
+
+int RuntimeProfiler::RegisterInstruction(const InstructionInfo& info) {
+  std::lock_guard<std::mutex> lock(mu_);
+  instructions_.push_back(info);
+  return instructions_.size() - 1;
+}
+
+int64_t RuntimeProfiler::Now() const {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() - epoch_ns_;
+}
+
+RuntimeProfiler::HardwareCounts RuntimeProfiler::ReadHardwareCounters() const {
+  HardwareCounts res;
+#ifdef __linux__
+  if (!hardware_counters()) return res;
+  thread_local ThreadHardwareCounters counters;
+  res.instructions = ThreadHardwareCounters::Read(counters.instructions);
+  res.cache_misses = ThreadHardwareCounters::Read(counters.cache_misses);
+#endif
+  return res;
+}
+
+RuntimeProfiler::Slot* RuntimeProfiler::GetSlots() {
+  Slot* slots = slots_.load(std::memory_order_acquire);
+  if (slots) return slots;
+  std::lock_guard<std::mutex> lock(mu_);
+  slots = slots_.load(std::memory_order_relaxed);
+  if (!slots) {
+    slots = new Slot[kCapacity];
+    slots_.store(slots, std::memory_order_release);
+  }
+  return slots;
+}
+
+void RuntimeProfiler::Record(int instruction, int64_t start_ns, int64_t end_ns, const HardwareCounts& counts) {
+  Slot* slots = GetSlots();
+  uint64_t i  = num_events_.fetch_add(1, std::memory_order_relaxed);
+  auto& slot  = slots[i % kCapacity];
+  slot.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.instruction.store(instruction, std::memory_order_relaxed);
+  slot.thread.store(GetThreadId(), std::memory_order_relaxed);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.end_ns.store(end_ns, std::memory_order_relaxed);
+  slot.instructions.store(counts.instructions, std::memory_order_relaxed);
+  slot.cache_misses.store(counts.cache_misses, std::memory_order_relaxed);
+  slot.seq.store(i + 1, std::memory_order_release);
+}
+
+void RuntimeProfiler::Record(int instruction, int64_t start_ns, int64_t end_ns) {
+  Record(instruction, start_ns, end_ns, HardwareCounts());
+}
+
+std::vector<RuntimeProfiler::Event> RuntimeProfiler::GetEvents(uint64_t since) const {
+  std::vector<Event> res;
+  const Slot* slots = slots_.load(std::memory_order_acquire);
+  if (!slots) return res;
+  uint64_t end   = num_events_.load(std::memory_order_acquire);
+  uint64_t begin = std::max({begin_.load(std::memory_order_relaxed), since, end > kCapacity ? end - kCapacity : 0});
+  for (uint64_t i = begin; i < end; i++) {
+    auto& slot = slots[i % kCapacity];
+    // The events being written or overwritten by the concurrent runs are skipped.
+    if (slot.seq.load(std::memory_order_acquire) != i + 1) continue;
+    Event event{slot.instruction.load(std::memory_order_relaxed),
+                slot.thread.load(std::memory_order_relaxed),
+                slot.start_ns.load(std::memory_order_relaxed),
+                slot.end_ns.load(std::memory_order_relaxed),
+                HardwareCounts{slot.instructions.load(std::memory_order_relaxed),
+                               slot.cache_misses.load(std::memory_order_relaxed)}};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != i + 1) continue;
+    res.push_back(event);
+  }
+  return res;
+}
+
+std::map<std::string, RuntimeProfiler::OpStats> RuntimeProfiler::Aggregate(uint64_t since) const {
+  auto events = GetEvents(since);
+  std::lock_guard<std::mutex> lock(mu_);
+  std::map<std::string, std::vector<double>> durations;
+  std::map<std::string, double> flops;
+  std::map<std::string, OpStats> res;
+  for (auto& event : events) {
+    auto& info = instructions_[event.instruction];
+    durations[info.op_type].push_back((event.end_ns - event.start_ns) / 1e3);
+    flops[info.op_type] += info.flops;
+    if (event.counts.instructions >= 0 && event.counts.cache_misses >= 0) {
+      auto& stats = res[info.op_type];
+      stats.sampled_calls++;
+      stats.instructions += event.counts.instructions;
+      stats.cache_misses += event.counts.cache_misses;
+    }
+  }
+
+  for (auto& [op_type, values] : durations) {
+    std::sort(values.begin(), values.end());
+    auto& stats    = res[op_type];
+    stats.calls    = values.size();
+    stats.total_us = 0;
+    for (double x : values) stats.total_us += x;
+    stats.min_us  = values.front();
+    stats.mean_us = stats.total_us / stats.calls;
+    stats.p50_us  = Quantile(values, 0.5);
+    stats.p99_us  = Quantile(values, 0.99);
+    stats.max_us  = values.back();
+    if (stats.total_us > 0) stats.gflops = flops[op_type] / stats.total_us / 1e3;
+  }
+  return res;
+}
+
+void RuntimeProfiler::Clear() { begin_.store(num_events_.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+std::string RuntimeProfiler::SummaryTable(uint64_t since) const {
+  auto stats = Aggregate(since);
+  std::stringstream os;
+  os << "======================== CINN runtime profile ========================\n";
+  os << std::left << std::setw(24) << "op" << std::right << std::setw(10) << "calls" << std::setw(14) << "total(us)"
+     << std::setw(12) << "min(us)" << std::setw(12) << "mean(us)" << std::setw(12) << "p50(us)" << std::setw(12)
+     << "p99(us)" << std::setw(12) << "GFLOP/s";
+  if (hardware_counters()) os << std::setw(14) << "instr/call" << std::setw(14) << "misses/call";
+  os << "\n";
+  for (auto& [op_type, x] : stats) {
+    os << std::left << std::setw(24) << op_type << std::right << std::setw(10) << x.calls << std::fixed
+       << std::setprecision(3) << std::setw(14) << x.total_us << std::setw(12) << x.min_us << std::setw(12)
+       << x.mean_us << std::setw(12) << x.p50_us << std::setw(12) << x.p99_us << std::setw(12) << x.gflops;
+    if (hardware_counters() && x.sampled_calls > 0) {
+      os << std::setw(14) << x.instructions / x.sampled_calls << std::setw(14) << x.cache_misses / x.sampled_calls;
+    } else if (hardware_counters()) {
+      os << std::setw(14) << "-" << std::setw(14) << "-";
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
+std::string RuntimeProfiler::ToChromeTrace() const {
+  auto events = GetEvents();
+  std::lock_guard<std::mutex> lock(mu_);
+  std::stringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\": [";
+  for (int i = 0; i < events.size(); i++) {
+    auto& event = events[i];
+    auto& info  = instructions_[event.instruction];
+    os << (i ? ",\n" : "\n") << "{\"name\": " << JsonString(info.name) << ", \"cat\": " << JsonString(info.op_type)
+       << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << event.thread << ", \"ts\": " << event.start_ns / 1e3
+       << ", \"dur\": " << (event.end_ns - event.start_ns) / 1e3
+       << ", \"args\": {\"inputs\": " << JsonString(ShapesToString(info.in_shapes))
+       << ", \"outputs\": " << JsonString(ShapesToString(info.out_shapes)) << ", \"flops\": " << info.flops;
+    if (event.counts.instructions >= 0) os << ", \"instructions\": " << event.counts.instructions;
+    if (event.counts.cache_misses >= 0) os << ", \"cache_misses\": " << event.counts.cache_misses;
+    os << "}}";
+  }
+  os << "\n], \"displayTimeUnit\": \"ms\"}\n";
+  return os.str();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
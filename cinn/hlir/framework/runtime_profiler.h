@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  //NOLINT
+#include <string>
+#include <vector>
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+/**
+ * The registry of the runs of the Instructions, the runtime counterpart of `utils::CompileProfiler`.
+ *
+ * The start and end timestamps of each run are recorded with the thread running it into a lock-free ring buffer, so
+ * the oldest runs are overwritten once the buffer is full. The buffer is allocated on the first record. The runs are
+ * aggregated by op type, or exported as a Chrome trace (chrome://tracing or Perfetto) with the op names, shapes and
+ * FLOP estimates.
+ *
+ * It is enabled by the environment variable `CINN_RUNTIME_PROFILE`, then the summary table is printed to stderr at
+ * exit and the trace is written to the path given by the variable, or to `cinn_runtime_trace.json` if its value is
+ * "1". The hardware counters of the runs are sampled by `perf_event_open` on Linux if `CINN_RUNTIME_PROFILE_HW` is set
+ * too.
+ */
+class RuntimeProfiler {
+ public:
+  //! The description of an Instruction, it is registered on the first profiled run.
+  struct InstructionInfo {
+    std::string name;
+    std::string op_type;
+    std::vector<std::vector<int>> in_shapes;
+    std::vector<std::vector<int>> out_shapes;
+    //! The estimated floating point operations of a run.
+    double flops{};
+  };
+
+  //! The hardware counters of a run, -1 if they are not sampled.
+  struct HardwareCounts {
+    int64_t instructions{-1};
+    int64_t cache_misses{-1};
+
+    //! Get the counts since \p start.
+    HardwareCounts Since(const HardwareCounts& start) const {
+      HardwareCounts res;
+      if (instructions >= 0 && start.instructions >= 0) res.instructions = instructions - start.instructions;
+      if (cache_misses >= 0 && start.cache_misses >= 0) res.cache_misses = cache_misses - start.cache_misses;
+      return res;
+    }
+  };
+
+  struct Event {
+    int instruction;
+    int thread;
+    //! The timestamps in nanoseconds since the profiler is created.
+    int64_t start_ns;
+    int64_t end_ns;
+    HardwareCounts counts;
+  };
+
+  struct OpStats {
+    int64_t calls{};
+    double total_us{};
+    double min_us{};
+    double mean_us{};
+    double p50_us{};
+    double p99_us{};
+    double max_us{};
+    //! The estimated GFLOP/s over all the calls.
+    double gflops{};
+    //! The number of the calls with the hardware counters sampled.
+    int64_t sampled_calls{};
+    //! The hardware counters summed over the sampled calls.
+    int64_t instructions{};
+    int64_t cache_misses{};
+  };
+
+  //! The number of the events kept in the ring buffer.
+  static constexpr int kCapacity = 1 << 16;
+
+  static RuntimeProfiler& Global();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool x) { enabled_.store(x, std::memory_order_relaxed); }
+
+  bool hardware_counters() const { return hardware_counters_.load(std::memory_order_relaxed); }
+  void set_hardware_counters(bool x) { hardware_counters_.store(x, std::memory_order_relaxed); }
+
+  //! Read the hardware counters of the current thread, they are -1 if disabled or unavailable.
+  HardwareCounts ReadHardwareCounters() const;
+
+  //! Register an Instruction, get its id for the events.
+  int RegisterInstruction(const InstructionInfo& info);
+
+  //! The current timestamp in nanoseconds.
+  int64_t Now() const;
+
+  //! Record a run of the Instruction \p instruction, it is lock-free.
+  void Record(int instruction, int64_t start_ns, int64_t end_ns, const HardwareCounts& counts);
+  void Record(int instruction, int64_t start_ns, int64_t end_ns);
+
+  //! The number of the events recorded so far, pass it as the \p since below to skip them.
+  uint64_t num_events() const { return num_events_.load(std::memory_order_acquire); }
+
+  //! Get the events kept in the ring buffer, from the oldest, skipping the first \p since events ever recorded.
+  std::vector<Event> GetEvents(uint64_t since = 0) const;
+
+  //! Get the statistics of the runs kept, by op type, skipping the first \p since events ever recorded.
+  std::map<std::string, OpStats> Aggregate(uint64_t since = 0) const;
+
+  //! Clear the events, the Instructions stay registered.
+  void Clear();
+
+  std::string SummaryTable(uint64_t since = 0) const;
+  std::string ToChromeTrace() const;
+
+  ~RuntimeProfiler();
+
+ private:
+  RuntimeProfiler();
+
+  //! A slot of the ring buffer, \p seq is one plus the index of the event written, or zero while it is written.
+  struct Slot {
+    std::atomic<uint64_t> seq{};
+    std::atomic<int> instruction{};
+    std::atomic<int> thread{};
+    std::atomic<int64_t> start_ns{};
+    std::atomic<int64_t> end_ns{};
+    std::atomic<int64_t> instructions{};
+    std::atomic<int64_t> cache_misses{};
+  };
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> hardware_counters_{false};
+  std::string trace_path_;
+  int64_t epoch_ns_{};
+
+  //! Get the ring buffer, it is allocated on the first record.
+  Slot* GetSlots();
+
+  //! The ring buffer of `kCapacity` slots, null until an event is recorded.
+  std::atomic<Slot*> slots_{};
+  std::atomic<uint64_t> num_events_{};
+  //! The index of the first event after the last clearing.
+  std::atomic<uint64_t> begin_{};
+
+  mutable std::mutex mu_;
+  std::vector<InstructionInfo> instructions_;
+};
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,94 @@
+#include "cinn/hlir/framework/runtime_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>  //NOLINT
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+TEST(RuntimeProfiler, record) {
+  auto& profiler = RuntimeProfiler::Global();
+  profiler.Clear();
+  // No event is recorded yet, the ring buffer is not allocated.
+  ASSERT_TRUE(profiler.GetEvents().empty());
+
+  int add = profiler.RegisterInstruction({"elementwise_add_0", "elementwise_add", {{4, 8}, {4, 8}}, {{4, 8}}, 32});
+  int mul = profiler.RegisterInstruction({"mul_0", "mul", {{4, 8}, {8, 2}}, {{4, 2}}, 128});
+  for (int i = 1; i <= 100; i++) profiler.Record(add, 1000, 1000 + i * 1000);
+  std::thread([&] { profiler.Record(mul, 0, 2000); }).join();
+
+  auto stats = profiler.Aggregate();
+  ASSERT_EQ(stats.size(), 2UL);
+  auto& add_stats = stats.at("elementwise_add");
+  ASSERT_EQ(add_stats.calls, 100);
+  ASSERT_NEAR(add_stats.min_us, 1, 1e-6);
+  ASSERT_NEAR(add_stats.mean_us, 50.5, 1e-6);
+  ASSERT_NEAR(add_stats.p50_us, 51, 1e-6);
+  ASSERT_NEAR(add_stats.p99_us, 100, 1e-6);
+  ASSERT_NEAR(stats.at("mul").gflops, 0.064, 1e-6);
+
+  auto events = profiler.GetEvents();
+  ASSERT_EQ(events.size(), 101UL);
+  ASSERT_NE(events.front().thread, events.back().thread);
+
+  ASSERT_NE(profiler.SummaryTable().find("elementwise_add"), std::string::npos);
+  auto trace = profiler.ToChromeTrace();
+  ASSERT_NE(trace.find("{\"name\": \"mul_0\", \"cat\": \"mul\", \"ph\": \"X\""), std::string::npos);
+  ASSERT_NE(trace.find("\"inputs\": \"[4, 8], [8, 2]\", \"outputs\": \"[4, 2]\", \"flops\": 128.000"),
+            std::string::npos);
+
+  // Only the latest events are kept.
+  for (int i = 0; i < RuntimeProfiler::kCapacity + 10; i++) profiler.Record(mul, i, i + 1);
+  ASSERT_EQ(profiler.GetEvents().size(), RuntimeProfiler::kCapacity);
+  ASSERT_EQ(profiler.GetEvents().front().start_ns, 10);
+
+  // The events before a mark are skipped without clearing them.
+  uint64_t mark = profiler.num_events();
+  profiler.Record(add, 0, 1000);
+  ASSERT_EQ(profiler.GetEvents(mark).size(), 1UL);
+  ASSERT_EQ(profiler.Aggregate(mark).size(), 1UL);
+  ASSERT_EQ(profiler.Aggregate(mark).at("elementwise_add").calls, 1);
+  ASSERT_EQ(profiler.GetEvents().size(), RuntimeProfiler::kCapacity);
+
+  profiler.Clear();
+  ASSERT_TRUE(profiler.GetEvents().empty());
+  ASSERT_TRUE(profiler.Aggregate().empty());
+}
+
+TEST(RuntimeProfiler, hardware_counters) {
+  auto& profiler = RuntimeProfiler::Global();
+  profiler.Clear();
+
+  int relu = profiler.RegisterInstruction({"relu_0", "relu", {{16}}, {{16}}, 16});
+  profiler.Record(relu, 0, 1000, {1000, 10});
+  profiler.Record(relu, 1000, 2000, {3000, 30});
+  // The counts not sampled are skipped.
+  profiler.Record(relu, 2000, 3000);
+  auto stats = profiler.Aggregate().at("relu");
+  ASSERT_EQ(stats.calls, 3);
+  ASSERT_EQ(stats.instructions, 4000);
+  ASSERT_EQ(stats.cache_misses, 40);
+  ASSERT_EQ(stats.sampled_calls, 2);
+  auto trace = profiler.ToChromeTrace();
+  ASSERT_NE(trace.find("\"flops\": 16.000, \"instructions\": 3000, \"cache_misses\": 30}"), std::string::npos);
+
+  bool hardware_counters = profiler.hardware_counters();
+  // The counts per call are averaged over the sampled calls.
+  profiler.set_hardware_counters(true);
+  ASSERT_NE(profiler.SummaryTable().find("          2000            20\n"), std::string::npos);
+  profiler.set_hardware_counters(false);
+  ASSERT_EQ(profiler.ReadHardwareCounters().instructions, -1);
+  // The counters might be unavailable, e.g. in the containers, then they are -1 too.
+  profiler.set_hardware_counters(true);
+  auto start = profiler.ReadHardwareCounters();
+  auto count = profiler.ReadHardwareCounters().Since(start);
+  if (start.instructions >= 0) ASSERT_GT(count.instructions, 0);
+  profiler.set_hardware_counters(hardware_counters);
+  profiler.Clear();
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
@@ -64,6 +64,12 @@ class _Tensor_ : public Object {
 
   cinn_buffer_t* buffer() { return buffer_->data(); }
 
+  //! Share the memory and the type of \p other, the shape stays.
+  void ShareBufferWith(const _Tensor_* other) {
+    buffer_ = other->buffer_;
+    type_   = other->type_;
+  }
+
   const char* type_info() const override { return __type_info__; }
 
  private:
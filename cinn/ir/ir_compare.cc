@@ -0,0 +1,425 @@
+#include "cinn/ir/ir_compare.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/ir/buffer.h"
+#include "cinn/ir/lowered_func.h"
+#include "cinn/ir/module.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+size_t HashCombine(size_t seed, size_t v) { return seed ^ (v + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+
+size_t HashType(const Type& t) {
+  size_t h = static_cast<size_t>(t.type());
+  h        = HashCombine(h, t.bits());
+  return HashCombine(h, t.lanes());
+}
+
+/**
+ * The expression fields of a node, in three parts: the fields evaluated out of the scope of the variables the node
+ * binds, the bound variables, and the fields in their scope.
+ */
+struct NodeFields {
+  std::vector<const Expr*> outer;
+  std::vector<const _Var_*> binders;
+  std::vector<const Expr*> inner;
+};
+
+NodeFields GetFields(const Expr& e) {
+  NodeFields res;
+  auto add_all = [](std::vector<const Expr*>* fields, const std::vector<Expr>& exprs) {
+    for (auto& x : exprs) fields->push_back(&x);
+  };
+
+  switch (e->node_type()) {
+#define __(op__) case IrNodeTy::op__:
+    NODETY_OP_FOR_EACH(__)
+    __(Cast)
+    __(FracOp)
+    __(Power)
+    __(Product)
+    __(Sum)
+#undef __
+    add_all(&res.outer, e->operands);
+    break;
+    case IrNodeTy::Select: {
+      auto* x   = e.As<Select>();
+      res.outer = {&x->condition, &x->true_value, &x->false_value};
+      break;
+    }
+    case IrNodeTy::IfThenElse: {
+      auto* x   = e.As<IfThenElse>();
+      res.outer = {&x->condition, &x->true_case, &x->false_case};
+      break;
+    }
+    case IrNodeTy::Block:
+      add_all(&res.outer, e.As<Block>()->stmts);
+      break;
+    case IrNodeTy::Call:
+      add_all(&res.outer, e.As<Call>()->read_args);
+      add_all(&res.outer, e.As<Call>()->write_args);
+      break;
+    case IrNodeTy::Load:
+      res.outer.push_back(&e.As<Load>()->tensor);
+      add_all(&res.outer, e.As<Load>()->indices);
+      break;
+    case IrNodeTy::Store:
+      res.outer = {&e.As<Store>()->tensor, &e.As<Store>()->value};
+      add_all(&res.outer, e.As<Store>()->indices);
+      break;
+    case IrNodeTy::Alloc: {
+      auto* x = e.As<Alloc>();
+      res.outer.push_back(&x->destination);
+      add_all(&res.outer, x->extents);
+      res.outer.push_back(&x->condition);
+      res.outer.push_back(&x->body);
+      break;
+    }
+    case IrNodeTy::Free:
+      res.outer.push_back(&e.As<Free>()->destination);
+      break;
+    case IrNodeTy::Let:
+      res.outer = {&e.As<Let>()->symbol, &e.As<Let>()->body};
+      break;
+    case IrNodeTy::Reduce: {
+      auto* x   = e.As<Reduce>();
+      res.outer = {&x->init};
+      for (auto& axis : x->reduce_axis) res.binders.push_back(axis.get());
+      res.inner = {&x->body};
+      break;
+    }
+    case IrNodeTy::For: {
+      auto* x     = e.As<For>();
+      res.outer   = {&x->min, &x->extent};
+      res.binders = {x->loop_var.get()};
+      res.inner   = {&x->body};
+      break;
+    }
+    case IrNodeTy::PolyFor: {
+      auto* x     = e.As<PolyFor>();
+      res.outer   = {&x->init};
+      res.binders = {x->iterator.get()};
+      res.inner   = {&x->condition, &x->inc, &x->body};
+      break;
+    }
+    case IrNodeTy::Ramp:
+      res.outer = {&e.As<Ramp>()->base, &e.As<Ramp>()->stride};
+      break;
+    case IrNodeTy::Broadcast:
+      res.outer = {&e.As<Broadcast>()->value};
+      break;
+    case IrNodeTy::PrimitiveNode:
+      for (auto& args : e.As<PrimitiveNode>()->arguments) add_all(&res.outer, args);
+      break;
+    default:
+      // The immediates, variables and the nodes compared by name or identity have no fields to compare.
+      break;
+  }
+  return res;
+}
+
+//! Hash the fields of \p e other than its expression fields.
+size_t HashAttrs(const Expr& e) {
+  size_t h = HashCombine(static_cast<size_t>(e->node_type()), HashType(e.type()));
+  switch (e->node_type()) {
+    case IrNodeTy::IntImm:
+      return HashCombine(HashCombine(h, HashType(e.type())), std::hash<int64_t>()(e.As<IntImm>()->value));
+    case IrNodeTy::UIntImm:
+      return HashCombine(HashCombine(h, HashType(e.type())), std::hash<int64_t>()(e.As<UIntImm>()->value));
+    case IrNodeTy::FloatImm:
+      return HashCombine(HashCombine(h, HashType(e.type())), std::hash<double>()(e.As<FloatImm>()->value));
+    case IrNodeTy::StringImm:
+      return HashCombine(h, std::hash<std::string>()(e.As<StringImm>()->value));
+    case IrNodeTy::Cast:
+      return HashCombine(h, HashType(e.As<Cast>()->type()));
+    case IrNodeTy::Call:
+      h = HashCombine(h, std::hash<std::string>()(e.As<Call>()->name));
+      h = HashCombine(h, e.As<Call>()->read_args.size());
+      return HashCombine(h, static_cast<size_t>(e.As<Call>()->call_type));
+    case IrNodeTy::Alloc:
+      return HashCombine(h, HashType(e.As<Alloc>()->type()));
+    case IrNodeTy::Reduce:
+      return HashCombine(h, static_cast<size_t>(e.As<Reduce>()->reduce_type));
+    case IrNodeTy::For:
+      return HashCombine(h, static_cast<size_t>(e.As<For>()->for_type()));
+    case IrNodeTy::PolyFor:
+      return HashCombine(h, static_cast<size_t>(e.As<PolyFor>()->for_type()));
+    case IrNodeTy::Ramp:
+      return HashCombine(h, e.As<Ramp>()->lanes);
+    case IrNodeTy::Broadcast:
+      return HashCombine(h, e.As<Broadcast>()->lanes);
+    case IrNodeTy::_Tensor_:
+      return HashCombine(h, std::hash<std::string>()(e.As<_Tensor_>()->name));
+    case IrNodeTy::_Buffer_:
+      return HashCombine(h, std::hash<std::string>()(e.As<_Buffer_>()->name));
+    case IrNodeTy::_LoweredFunc_:
+      return HashCombine(h, std::hash<std::string>()(e.As<_LoweredFunc_>()->name));
+    case IrNodeTy::_Module_:
+      return HashCombine(h, std::hash<std::string>()(e.As<_Module_>()->name));
+    case IrNodeTy::PrimitiveNode:
+      return HashCombine(h, std::hash<std::string>()(e.As<PrimitiveNode>()->name));
+    case IrNodeTy::IntrinsicOp:
+      return HashCombine(h, std::hash<const void*>()(e.get()));
+    default:
+      return h;
+  }
+}
+
+//! Compare the fields of \p a and \p b other than the expression fields and variable names, they are of the same kind.
+bool AttrsEqual(const Expr& a, const Expr& b) {
+  if (a.type() != b.type()) return false;
+  switch (a->node_type()) {
+    case IrNodeTy::IntImm:
+      return a.type() == b.type() && a.As<IntImm>()->value == b.As<IntImm>()->value;
+    case IrNodeTy::UIntImm:
+      return a.type() == b.type() && a.As<UIntImm>()->value == b.As<UIntImm>()->value;
+    case IrNodeTy::FloatImm:
+      return a.type() == b.type() && a.As<FloatImm>()->value == b.As<FloatImm>()->value;
+    case IrNodeTy::StringImm:
+      return a.As<StringImm>()->value == b.As<StringImm>()->value;
+    case IrNodeTy::Cast:
+      return a.As<Cast>()->type() == b.As<Cast>()->type();
+    case IrNodeTy::Call: {
+      auto *x = a.As<Call>(), *y = b.As<Call>();
+      return x->name == y->name && x->call_type == y->call_type && x->value_index == y->value_index &&
+             x->type() == y->type() && x->read_args.size() == y->read_args.size() &&
+             x->write_args.size() == y->write_args.size();
+    }
+    case IrNodeTy::Alloc:
+      return a.As<Alloc>()->type() == b.As<Alloc>()->type() &&
+             a.As<Alloc>()->extents.size() == b.As<Alloc>()->extents.size();
+    case IrNodeTy::Reduce:
+      return a.As<Reduce>()->reduce_type == b.As<Reduce>()->reduce_type;
+    case IrNodeTy::For: {
+      auto *x = a.As<For>(), *y = b.As<For>();
+      return x->for_type() == y->for_type() && x->device_api == y->device_api &&
+             x->vectorize_info().level == y->vectorize_info().level &&
+             x->vectorize_info().factor == y->vectorize_info().factor;
+    }
+    case IrNodeTy::PolyFor: {
+      auto *x = a.As<PolyFor>(), *y = b.As<PolyFor>();
+      return x->for_type() == y->for_type() && x->device_api == y->device_api;
+    }
+    case IrNodeTy::Ramp:
+      return a.As<Ramp>()->lanes == b.As<Ramp>()->lanes;
+    case IrNodeTy::Broadcast:
+      return a.As<Broadcast>()->lanes == b.As<Broadcast>()->lanes;
+    case IrNodeTy::_Tensor_:
+      return a.As<_Tensor_>()->name == b.As<_Tensor_>()->name;
+    case IrNodeTy::_Buffer_:
+      return a.As<_Buffer_>()->name == b.As<_Buffer_>()->name;
+    case IrNodeTy::_LoweredFunc_:
+      return a.As<_LoweredFunc_>()->name == b.As<_LoweredFunc_>()->name;
+    case IrNodeTy::_Module_:
+      return a.As<_Module_>()->name == b.As<_Module_>()->name;
+    case IrNodeTy::PrimitiveNode: {
+      auto *x = a.As<PrimitiveNode>(), *y = b.As<PrimitiveNode>();
+      if (x->name != y->name || x->attrs != y->attrs || x->arguments.size() != y->arguments.size()) return false;
+      for (int i = 0; i < x->arguments.size(); i++) {
+        if (x->arguments[i].size() != y->arguments[i].size()) return false;
+      }
+      return true;
+    }
+    case IrNodeTy::IntrinsicOp:
+      return a.get() == b.get();
+    default:
+      return true;
+  }
+}
+
+class StructuralComparator {
+ public:
+  bool Equal(const Expr& a, const Expr& b) {
+    if (!a.defined() || !b.defined()) return a.defined() == b.defined();
+    // The same node might refer to the variables bound differently, the shortcut only holds with no variable bound.
+    if (a.get() == b.get() && bound_.empty()) return true;
+    if (a->node_type() != b->node_type() || a.type() != b.type()) return false;
+
+    if (a->node_type() == IrNodeTy::_Var_) {
+      auto *x = a.As<_Var_>(), *y = b.As<_Var_>();
+      int i = FindBound(x->name, true), j = FindBound(y->name, false);
+      if (i != j) return false;
+      return i >= 0 || x->name == y->name;
+    }
+    if (!AttrsEqual(a, b)) return false;
+
+    auto fa = GetFields(a), fb = GetFields(b);
+    if (fa.outer.size() != fb.outer.size() || fa.binders.size() != fb.binders.size() ||
+        fa.inner.size() != fb.inner.size()) {
+      return false;
+    }
+    for (int i = 0; i < fa.outer.size(); i++) {
+      if (!Equal(*fa.outer[i], *fb.outer[i])) return false;
+    }
+    for (int i = 0; i < fa.binders.size(); i++) {
+      bound_.emplace_back(&fa.binders[i]->name, &fb.binders[i]->name);
+    }
+    bool res = true;
+    for (int i = 0; i < fa.inner.size() && res; i++) {
+      res = Equal(*fa.inner[i], *fb.inner[i]);
+    }
+    bound_.resize(bound_.size() - fa.binders.size());
+    return res;
+  }
+
+ private:
+  //! Find the innermost binding of the variable called \p name in the lhs or rhs, returns -1 if it is free.
+  int FindBound(const std::string& name, bool lhs) const {
+    for (int i = bound_.size() - 1; i >= 0; i--) {
+      if (*(lhs ? bound_[i].first : bound_[i].second) == name) return i;
+    }
+    return -1;
+  }
+
+  std::vector<std::pair<const std::string*, const std::string*>> bound_;
+};
+
+class StructuralHasher {
+ public:
+  size_t Hash(const Expr& e) {
+    if (!e.defined()) return 0;
+    if (e->node_type() == IrNodeTy::_Var_) {
+      auto& name = e.As<_Var_>()->name;
+      size_t h   = HashCombine(static_cast<size_t>(IrNodeTy::_Var_), HashType(e.type()));
+      for (int i = bound_.size() - 1; i >= 0; i--) {
+        if (*bound_[i] == name) return HashCombine(h, i);
+      }
+      return HashCombine(h, std::hash<std::string>()(name));
+    }
+
+    size_t h    = HashAttrs(e);
+    auto fields = GetFields(e);
+    for (auto* x : fields.outer) h = HashCombine(h, Hash(*x));
+    for (auto* x : fields.binders) bound_.push_back(&x->name);
+    for (auto* x : fields.inner) h = HashCombine(h, Hash(*x));
+    bound_.resize(bound_.size() - fields.binders.size());
+    return h;
+  }
+
+ private:
+  std::vector<const std::string*> bound_;
+};
+
+//! The expressions that bind no variable and are not statements, they can be shared once interned.
+bool IsInternable(const Expr& e) {
+  switch (e->node_type()) {
+#define __(op__) case IrNodeTy::op__:
+    NODETY_PRIMITIVE_TYPE_FOR_EACH(__)
+    NODETY_OP_FOR_EACH(__)
+    __(Cast)
+    __(FracOp)
+    __(Power)
+    __(Product)
+    __(Sum)
+    __(Select)
+    __(Call)
+    __(_Var_)
+    __(Load)
+    __(Ramp)
+    __(Broadcast)
+#undef __
+    return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+bool StructuralEqual(const Expr& a, const Expr& b) { return StructuralComparator().Equal(a, b); }
+
+size_t StructuralHash(const Expr& e) { return StructuralHasher().Hash(e); }
+
+bool ExprTable::InternChildren(Expr* e) {
+  switch ((*e)->node_type()) {
+    // The referenced objects are not part of the expression.
+    case IrNodeTy::_Tensor_:
+    case IrNodeTy::_Buffer_:
+    case IrNodeTy::_Module_:
+    case IrNodeTy::IntrinsicOp:
+      return false;
+    default:
+      break;
+  }
+
+  auto fields = GetFields(*e);
+  for (auto* x : fields.outer) {
+    if (x->defined()) *const_cast<Expr*>(x) = Intern(*x);
+  }
+  for (auto* x : fields.inner) {
+    if (x->defined()) *const_cast<Expr*>(x) = Intern(*x);
+  }
+  if ((*e)->node_type() == IrNodeTy::_LoweredFunc_) {
+    auto* fn = e->as_lowered_func();
+    fn->body = Intern(fn->body);
+  }
+  return IsInternable(*e);
+}
+
+size_t ExprTable::ShallowHash(const Expr& e) const {
+  if (e->node_type() == IrNodeTy::_Var_) {
+    size_t h = HashCombine(static_cast<size_t>(IrNodeTy::_Var_), HashType(e.type()));
+    return HashCombine(h, std::hash<std::string>()(e.As<_Var_>()->name));
+  }
+  size_t h    = HashAttrs(e);
+  auto fields = GetFields(e);
+  for (auto* x : fields.outer) {
+    if (!x->defined()) {
+      h = HashCombine(h, 0);
+      continue;
+    }
+    auto it = hashes_.find(x->get());
+    // The children not interned are the tensors and buffers referenced, they hash by name.
+    h = HashCombine(h, it != hashes_.end() ? it->second : HashAttrs(*x));
+  }
+  return h;
+}
+
+bool ExprTable::ShallowEqual(const Expr& e, const Expr& x) const {
+  if (e->node_type() != x->node_type()) return false;
+  if (e->node_type() == IrNodeTy::_Var_) return e.type() == x.type() && e.As<_Var_>()->name == x.As<_Var_>()->name;
+  if (!AttrsEqual(e, x)) return false;
+  auto fe = GetFields(e), fx = GetFields(x);
+  if (fe.outer.size() != fx.outer.size()) return false;
+  for (int i = 0; i < fe.outer.size(); i++) {
+    auto &a = *fe.outer[i], &b = *fx.outer[i];
+    if (a.get() == b.get()) continue;
+    if (!a.defined() || !b.defined() || hashes_.count(a.get()) || hashes_.count(b.get())) return false;
+    if (!StructuralEqual(a, b)) return false;
+  }
+  return true;
+}
+
+Expr ExprTable::Intern(Expr e) {
+  if (!e.defined() || hashes_.count(e.get())) return e;
+  if (!InternChildren(&e)) return e;
+
+  size_t h   = ShallowHash(e);
+  auto range = table_.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (ShallowEqual(e, it->second)) {
+      num_hits_++;
+      return it->second;
+    }
+  }
+  table_.emplace(h, e);
+  hashes_[e.get()] = h;
+  return e;
+}
+
+void ExprTable::Clear() {
+  table_.clear();
+  hashes_.clear();
+  num_hits_ = 0;
+}
+
+}  // namespace ir
+}  // namespace cinn
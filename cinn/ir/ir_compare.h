@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+
+namespace cinn {
+namespace ir {
+
+/**
+ * Structural equality of two expressions: they have the same node kinds, types, fields and operands.
+ *
+ * - The variables bound in the expressions (the loop variables of For and PolyFor, the reduce axis of Reduce) compare
+ *   by their binding positions, so `for (i, 0, n) { A[i] }` equals `for (j, 0, n) { A[j] }`.
+ * - The free variables compare by name and type.
+ * - The tensors, buffers, functions and modules referenced compare by name, they are not compared field by field.
+ * - IntrinsicOp nodes compare by identity.
+ */
+bool StructuralEqual(const Expr& a, const Expr& b);
+
+//! Structural hash of an expression, consistent with `StructuralEqual`.
+size_t StructuralHash(const Expr& e);
+
+struct ExprStructuralHash {
+  size_t operator()(const Expr& e) const { return StructuralHash(e); }
+};
+struct ExprStructuralEqual {
+  bool operator()(const Expr& a, const Expr& b) const { return StructuralEqual(a, b); }
+};
+
+/**
+ * A hash-consing table of expressions.
+ *
+ * `Intern` replaces every expression (non-statement) subtree with the canonical node structurally equal to it, so the
+ * identical subexpressions built separately share one node. The subtrees are interned bottom up, a node is looked up
+ * by its own fields and the identities of its canonical children, so interning costs O(1) per node.
+ *
+ * NOTE the canonical nodes are shared by all the expressions interned, they must not be mutated in place. Intern the
+ * expressions that are read only (such as the keys of a memo table), and IRCopy an interned expression before passing
+ * it to a mutator.
+ */
+class ExprTable {
+ public:
+  //! Intern \p e and its subexpressions in place, returns the canonical node of \p e.
+  Expr Intern(Expr e);
+
+  //! Whether \p e is a canonical node of the table, the statements and the binding nodes are never interned.
+  bool interned(const Expr& e) const { return hashes_.count(e.get()); }
+
+  size_t size() const { return hashes_.size(); }
+  //! The number of the subexpressions interned that were found in the table already.
+  size_t num_hits() const { return num_hits_; }
+
+  void Clear();
+
+ private:
+  //! Intern the children of \p e in place, returns whether \p e is an expression to intern itself.
+  bool InternChildren(Expr* e);
+  //! Hash \p e by its own fields and the hashes of its canonical children.
+  size_t ShallowHash(const Expr& e) const;
+  //! Whether \p e equals the canonical node \p x, both having the canonical children.
+  bool ShallowEqual(const Expr& e, const Expr& x) const;
+
+  //! The canonical nodes, keyed by their hashes.
+  std::unordered_multimap<size_t, Expr> table_;
+  std::unordered_map<const IrNode*, size_t> hashes_;
+  size_t num_hits_{};
+};
+
+}  // namespace ir
+}  // namespace cinn
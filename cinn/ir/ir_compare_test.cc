@@ -0,0 +1,86 @@
+#include "cinn/ir/ir_compare.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/ir_operators.h"
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+Expr MakeLoop(const std::string& iter, Placeholder<float>& A, Placeholder<float>& B) {
+  Var i(iter);
+  Expr body = Store::Make(ir::Tensor(B), Load::Make(ir::Tensor(A), {Expr(i)}) + Expr(1.f), {Expr(i)});
+  return For::Make(i, Expr(0), Expr(100), ForType::Serial, DeviceAPI::Host, Block::Make({body}));
+}
+
+}  // namespace
+
+TEST(StructuralEqual, expr) {
+  Var x("x"), y("y");
+  Expr a = x * 2 + y;
+  Expr b = x * 2 + y;
+  ASSERT_TRUE(StructuralEqual(a, b));
+  ASSERT_EQ(StructuralHash(a), StructuralHash(b));
+
+  // The free variables compare by name.
+  ASSERT_FALSE(StructuralEqual(a, Expr(y * 2 + x)));
+  // The immediates compare by type and value.
+  ASSERT_FALSE(StructuralEqual(Expr(1), Expr(2)));
+  ASSERT_FALSE(StructuralEqual(Expr(1), Expr(1.f)));
+  ASSERT_FALSE(StructuralEqual(a, Expr(x * 2 - y)));
+
+  // The calls compare their read and write arguments apart.
+  Expr call0 = Call::Make(Void(), "f", {Expr(x), Expr(y)}, {}, CallType::Extern, FunctionRef(), 0);
+  Expr call1 = Call::Make(Void(), "f", {Expr(x)}, {Expr(y)}, CallType::Extern, FunctionRef(), 0);
+  ASSERT_FALSE(StructuralEqual(call0, call1));
+}
+
+TEST(StructuralEqual, bound_variables) {
+  Placeholder<float> A("A", {Expr(100)});
+  Placeholder<float> B("B", {Expr(100)});
+
+  Expr loop_i = MakeLoop("i", A, B);
+  Expr loop_j = MakeLoop("j", A, B);
+  LOG(INFO) << "loop_i:\n" << loop_i;
+
+  // The loops differ only in the name of the loop variable.
+  ASSERT_TRUE(StructuralEqual(loop_i, loop_j));
+  ASSERT_EQ(StructuralHash(loop_i), StructuralHash(loop_j));
+
+  Placeholder<float> C("C", {Expr(100)});
+  ASSERT_FALSE(StructuralEqual(loop_i, MakeLoop("i", A, C)));
+}
+
+TEST(ExprTable, intern) {
+  Var x("x"), y("y");
+  Expr a = (x + 1) * (x + 1);
+  Expr b = (x + 1) * y;
+
+  ExprTable table;
+  a = table.Intern(a);
+  b = table.Intern(b);
+
+  // The subexpressions `x + 1` and `x` are shared.
+  auto* mul_a = a.As<Mul>();
+  auto* mul_b = b.As<Mul>();
+  ASSERT_TRUE(mul_a->a().same_as(mul_a->b()));
+  ASSERT_TRUE(mul_a->a().same_as(mul_b->a()));
+  ASSERT_GT(table.num_hits(), 0UL);
+
+  // Interning an equal expression returns the canonical node.
+  size_t size = table.size();
+  Expr c      = table.Intern((x + 1) * y);
+  ASSERT_TRUE(c.same_as(b));
+  ASSERT_TRUE(table.interned(c));
+  ASSERT_EQ(table.size(), size);
+
+  table.Clear();
+  ASSERT_EQ(table.size(), 0UL);
+  ASSERT_EQ(table.num_hits(), 0UL);
+}
+
+}  // namespace ir
+}  // namespace cinn
@@ -0,0 +1,170 @@
+#include "cinn/lang/auto_compute_at.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/poly/compute_at_transform.h"
+#include "cinn/poly/isl_utils.h"
+
+DEFINE_bool(cinn_auto_compute_at,
+            false,
+            "Whether to fuse the temporary tensors into the loops of their consumers on CPU by default");
+DEFINE_int32(cinn_auto_compute_at_cache_bytes,
+             256 * 1024,
+             "The maximum size of the buffer of a temporary tensor fused into its consumer");
+
+namespace cinn {
+namespace lang {
+
+using poly::Stage;
+
+namespace {
+
+//! The maximum ratio of the elements computed after fused to before, the elements read by several iterations of the
+//! consumer loop are computed repeatedly.
+constexpr double kMaxRecomputeRatio = 1.25;
+
+bool GetConstantExtent(const isl::set& set, int pos, int64_t* extent) {
+  if (isl_set_dim_is_bounded(set.get(), isl_dim_set, pos) != isl_bool_true) return false;
+  auto [min_val, max_val] = poly::isl_set_get_axis_range(set.get(), pos);  // NOLINT
+  if (!isl_val_is_int(min_val.get()) || !isl_val_is_int(max_val.get())) return false;
+  *extent = max_val.num_si() - min_val.num_si() + 1;
+  return true;
+}
+
+bool IsIdentity(const isl::map& transform) { return isl_map_is_identity(transform.get()) == isl_bool_true; }
+
+//! Tell whether the sets \p a and \p b are equal in the dimensions no more inner than \p level, ignoring the params.
+bool SameOuterLoops(const isl::set& a, const isl::set& b, int level) {
+  std::vector<int> dims;
+  for (int i = 0; i <= level; i++) dims.push_back(i);
+  auto outer = [&](const isl::set& x) {
+    auto res    = isl::manage(isl_set_set_tuple_name(poly::SetGetDims(x, dims).release(), ""));
+    int nparams = isl_set_dim(res.get(), isl_dim_param);
+    return isl::manage(isl_set_remove_dims(res.release(), isl_dim_param, 0, nparams));
+  };
+  return isl_set_is_equal(outer(a).get(), outer(b).get()) == isl_bool_true;
+}
+
+//! Tell whether the user has scheduled the loops of \p stage.
+bool IsScheduled(Stage* stage) {
+  return !IsIdentity(stage->transform()) || !stage->forloop_infos().empty() || stage->vectorize_info().valid() ||
+         !stage->unroll_info().empty() || !stage->parallel_info().empty();
+}
+
+/**
+ * Pick the level of \p consumer to compute \p producer at.
+ * @return The level, or -1 if no level fits.
+ */
+int PickComputeAtLevel(Stage* producer, Stage* consumer, int cache_bytes) {
+  auto* ptensor = producer->tensor();
+  auto* ctensor = consumer->tensor();
+
+  int64_t num_elements = 1;
+  for (auto& dim : ptensor->shape) {
+    if (!dim.is_constant()) return -1;
+    num_elements *= dim.as_int32();
+  }
+
+  // The reduction loops are the innermost ones of an untransformed consumer, never compute at them.
+  int num_levels = consumer->n_out_dims();
+  if (ctensor->is_reduce_tensor()) {
+    if (!IsIdentity(consumer->transform())) return -1;
+    num_levels = ctensor->axis().size();
+  }
+
+  isl::set cdomain = consumer->transformed_domain();
+  std::vector<int64_t> extents(consumer->n_out_dims());
+  for (int i = 0; i < extents.size(); i++) {
+    if (!GetConstantExtent(cdomain, i, &extents[i])) return -1;
+  }
+
+  isl_map* access_raw = GatherAccesses(consumer, ptensor->name);
+  if (!access_raw) return -1;
+  isl::map access = isl::manage(access_raw);
+
+  int64_t num_iterations = 1;
+  for (int level = 0; level < num_levels; level++) {
+    num_iterations *= extents[level];
+    poly::ComputeAtTransform transform(
+        producer->domain(), consumer->domain(), access, producer->transform(), consumer->transform(), level);
+    transform();
+    // The producer must iterate the same outer loops as the consumer, see ComputeAtRelation::IsCompatible.
+    auto ptransformed = transform.adjusted_pdomain().apply(transform.adjusted_ptransform());
+    if (!SameOuterLoops(ptransformed, cdomain, level)) continue;
+    int64_t footprint = 1;
+    for (int dim : transform.GetProducerAdjustedShape()) footprint *= dim;
+
+    VLOG(3) << "compute " << ptensor->name << " at level " << level << " of " << ctensor->name
+            << ", footprint: " << footprint << ", iterations: " << num_iterations;
+    if (footprint * ptensor->type().bytes() <= cache_bytes &&
+        footprint * num_iterations <= kMaxRecomputeRatio * num_elements) {
+      return level;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+int AutoComputeAt(poly::StageMap stages,
+                  const std::vector<ir::Tensor>& tensor_args,
+                  const Target& target,
+                  int cache_bytes) {
+  if (target.arch != Target::Arch::X86) return 0;
+
+  std::set<std::string> arg_names;
+  for (auto& t : tensor_args) arg_names.insert(t->name);
+
+  // Sort the stages by name to schedule deterministically.
+  std::map<std::string, Stage*> sorted_stages;
+  for (auto& item : stages) sorted_stages[item.first] = item.second.get();
+
+  std::map<std::string, std::set<std::string>> readers;
+  for (auto& [name, stage] : sorted_stages) {
+    auto* tensor = stage->tensor();
+    if (!tensor || tensor->is_placeholder_node() || tensor->is_buffer_shared_node()) continue;
+    // The readers of the tensors are unknown.
+    if (!tensor->is_compute_node() && !tensor->is_call_node()) return 0;
+
+    auto tensors = ir::CollectIRNodes(tensor->body(), [](const Expr* x) { return x->as_tensor(); });
+    for (auto& x : tensors) {
+      if (x.as_tensor()->name != name) readers[x.as_tensor()->name].insert(name);
+    }
+    for (auto& x : stage->ctrl_depends()) readers[x->name].insert(name);
+  }
+
+  int num_fused = 0;
+  for (auto& [name, producer] : sorted_stages) {
+    auto* tensor = producer->tensor();
+    if (!tensor || !tensor->is_compute_node() || tensor->is_reduce_tensor() || tensor->is_tuple()) continue;
+    if (arg_names.count(name) || producer->inlined() || IsScheduled(producer)) continue;
+    if (!producer->meta.tensors_to_share_buffer_with.empty() || producer->meta.read_cache_relation ||
+        producer->meta.write_cache_relation || !producer->ctrl_depends().empty()) {
+      continue;
+    }
+    // Not a consumer or a producer fused.
+    if (!producer->compute_ats().empty() || !producer->meta.compute_at_infos.empty()) continue;
+
+    auto it = readers.find(name);
+    if (it == readers.end() || it->second.size() != 1) continue;
+    auto* consumer = stages->Lookup(*it->second.begin());
+    if (!consumer || !consumer->tensor() || !consumer->tensor()->is_compute_node() || consumer->inlined()) continue;
+    if (!consumer->compute_ats().empty() || !consumer->forloop_infos().empty() ||
+        consumer->meta.read_cache_relation || consumer->meta.write_cache_relation) {
+      continue;
+    }
+
+    int level = PickComputeAtLevel(producer, consumer, cache_bytes);
+    if (level < 0) continue;
+    VLOG(2) << "Auto compute " << name << " at level " << level << " of " << consumer->id();
+    producer->ComputeAt(consumer, level);
+    num_fused++;
+  }
+  return num_fused;
+}
+
+}  // namespace lang
+}  // namespace cinn
@@ -0,0 +1,39 @@
+//! \file This file implements a pass to schedule the temporary tensors `compute_at` their consumers automatically.
+#pragma once
+#include <gflags/gflags.h>
+
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/poly/stage.h"
+
+DECLARE_bool(cinn_auto_compute_at);
+DECLARE_int32(cinn_auto_compute_at_cache_bytes);
+
+namespace cinn {
+namespace lang {
+
+/**
+ * \brief Fuse the loops of the temporary tensors into the loops of their consumers by `ComputeAt`.
+ *
+ * A temporary tensor computed at the level of its consumer only computes the part read by an iteration of the consumer
+ * loop, and its buffer shrinks to that part, so it stays in the cache instead of being streamed through the memory.
+ *
+ * A temporary tensor is fused if it is read by a single stage and none of them has been scheduled by `ComputeAt`. For
+ * each fused tensor, the outermost level is picked where the shrunk buffer fits \p cache_bytes and the total elements
+ * computed do not exceed the unfused computation by more than a small fraction.
+ *
+ * @param stages The stages to lower.
+ * @param tensor_args The arguments of the function, their buffers are never shrunk.
+ * @param target The target of the function, only the CPU functions are scheduled.
+ * @param cache_bytes The maximum size of a buffer shrunk.
+ * @return The number of the tensors fused.
+ */
+int AutoComputeAt(poly::StageMap stages,
+                  const std::vector<ir::Tensor>& tensor_args,
+                  const Target& target,
+                  int cache_bytes);
+
+}  // namespace lang
+}  // namespace cinn
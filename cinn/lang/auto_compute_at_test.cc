@@ -0,0 +1,102 @@
+#include "cinn/lang/auto_compute_at.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/backends/llvm/simple_jit.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/ir/collect_ir_nodes.h"
+
+namespace cinn {
+namespace lang {
+
+TEST(AutoComputeAt, pick_level) {
+  Expr bs(4), M(32), N(32);
+  Placeholder<float> A("A", {bs, M, N});
+
+  auto build = [&](int cache_bytes, int* level) {
+    auto suffix = std::to_string(cache_bytes);
+    auto A1     = Compute(
+        {bs, M, N}, [&](Expr k, Expr i, Expr j) { return A(k, i, j) * 2.f; }, "A1_" + suffix);
+    auto B = Compute(
+        {bs, M, N}, [&](Expr k, Expr i, Expr j) { return A1(k, i, j) + 1.f; }, "B_" + suffix);
+    auto stages = CreateStages({B});
+    int num_fused = AutoComputeAt(stages, {A, B}, common::DefaultHostTarget(), cache_bytes);
+    *level        = stages[A1]->compute_ats().empty() ? -1 : stages[A1]->compute_ats().front().level;
+    return num_fused;
+  };
+
+  // The outermost level fits the cache.
+  int level;
+  ASSERT_EQ(build(256 * 1024, &level), 1);
+  ASSERT_EQ(level, 0);
+  // The buffer shrinks to a row for a smaller cache.
+  ASSERT_EQ(build(512, &level), 1);
+  ASSERT_EQ(level, 1);
+}
+
+TEST(AutoComputeAt, skip) {
+  Expr bs(4), M(32), M1(33), N(32);
+  Placeholder<float> A("A", {bs, M1, N});
+
+  // A row of A1 is read by two iterations of B's loop over i, computing A1 at that level computes it twice.
+  auto A1 = Compute(
+      {bs, M1, N}, [&](Expr k, Expr i, Expr j) { return A(k, i, j) * 2.f; }, "A1");
+  auto B = Compute(
+      {bs, M, N}, [&](Expr k, Expr i, Expr j) { return A1(k, i, j) + A1(k, i + 1, j); }, "B");
+  auto stages = CreateStages({B});
+  ASSERT_EQ(AutoComputeAt(stages, {A, B}, common::DefaultHostTarget(), 512), 0);
+
+  // The arguments keep their buffers.
+  ASSERT_EQ(AutoComputeAt(stages, {A, A1, B}, common::DefaultHostTarget(), 256 * 1024), 0);
+  ASSERT_EQ(AutoComputeAt(stages, {A, B}, common::DefaultHostTarget(), 256 * 1024), 1);
+}
+
+TEST(AutoComputeAt, lower) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_auto_compute_at = true;
+
+  Expr bs(4), M(32), N(16);
+  Placeholder<float> A("A", {bs, M, N});
+  auto A1 = Compute(
+      {bs, M, N}, [&](Expr k, Expr i, Expr j) { return A(k, i, j) * 2.f; }, "A1");
+  auto B = Compute(
+      {bs, M, N}, [&](Expr k, Expr i, Expr j) { return A1(k, i, j) + 1.f; }, "B");
+  auto stages = CreateStages({B});
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  auto fn = Lower("fn", stages, {A, B}, {}, {}, &builder);
+  LOG(INFO) << "fn:\n" << fn;
+  // The schedule is applied to a copy of the stages.
+  ASSERT_TRUE(stages[A1]->compute_ats().empty());
+  ASSERT_TRUE(stages[B]->meta.compute_at_infos.empty());
+
+  // A1 is computed in the loop of B over the batch, instead of in a loop nest of its own.
+  auto stores_to = [](const Expr& x, const std::string& name) {
+    return !ir::CollectIRNodes(x, [&](const Expr* n) {
+              return n->As<ir::Store>() && n->As<ir::Store>()->tensor.as_tensor()->name == name;
+            }).empty();
+  };
+  auto fused_loops = ir::CollectIRNodes(fn->body, [&](const Expr* x) {
+    return x->As<ir::For>() && stores_to(x->As<ir::For>()->body, "A1") && stores_to(x->As<ir::For>()->body, "B");
+  });
+  ASSERT_FALSE(fused_loops.empty());
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build(), false);
+  auto* fn_handler = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn"));
+
+  auto A_buf    = common::BufferBuilder(Float(32), {4, 32, 16}).set_random().Build();
+  auto B_buf    = common::BufferBuilder(Float(32), {4, 32, 16}).set_zero().Build();
+  auto arg_pack = common::ArgsBuilder().Add(A_buf).Add(B_buf).Build();
+  fn_handler(arg_pack.data(), arg_pack.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  for (int i = 0; i < 4 * 32 * 16; i++) {
+    ASSERT_NEAR(A_data[i] * 2.f + 1.f, B_data[i], 1e-5);
+  }
+}
+
+}  // namespace lang
+}  // namespace cinn
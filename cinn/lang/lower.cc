@@ -1,5 +1,6 @@
 #include "cinn/lang/lower.h"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <set>
@@ -7,10 +8,15 @@
 #include <unordered_set>
 #include <utility>
 
+#include "cinn/common/arena.h"
+#include "cinn/common/cas.h"
 #include "cinn/ir/buffer.h"
 #include "cinn/ir/ir_printer.h"
+#include "cinn/lang/auto_compute_at.h"
 #include "cinn/lang/lower_impl.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/optim/optimize.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace lang {
@@ -56,6 +62,50 @@ std::set<ir::Tensor> CollectTempTensorsFromCtrlDepends(StageMap stages, const st
   return res;
 }
 
+/**
+ * Place the "local" temporary buffers of a CPU function in the arrays on its stack, the accesses with the constant
+ * indices, e.g. the accumulators of an unrolled and jammed loop, are promoted to registers by the backend compilers.
+ * The buffers are placed from the smallest while they fit the limits of a buffer and of the function, the others are
+ * left on the heap.
+ *
+ * The buffers are shared by the tensors of all the functions lowered from the stages, so the ones of this function are
+ * replaced by the copies placed.
+ */
+void PlaceLocalBuffersOnStack(std::vector<ir::Buffer>* temp_buffers) {
+  constexpr int64_t kMaxStackBufferBytes = 64 * 1024;
+  constexpr int64_t kMaxStackBytes       = 128 * 1024;
+  std::vector<std::pair<int64_t, int>> sizes;
+  for (int i = 0; i < temp_buffers->size(); i++) {
+    auto& buffer = (*temp_buffers)[i];
+    if (buffer->memory_type != ir::MemoryType::GPULocal) continue;
+    int64_t bytes = buffer->dtype.bits() / 8;
+    for (auto& dim : buffer->shape) {
+      Expr extent = common::AutoSimplify(dim);
+      if (!extent.As<ir::IntImm>() || extent.as_int32() <= 0) {
+        bytes = 0;
+        break;
+      }
+      bytes *= extent.as_int32();
+    }
+    sizes.emplace_back(bytes > 0 ? bytes : kMaxStackBytes + 1, i);
+  }
+  std::sort(sizes.begin(), sizes.end());
+
+  int64_t stack_bytes = 0;
+  for (auto& [bytes, i] : sizes) {
+    auto& buffer = (*temp_buffers)[i];
+    auto copy    = optim::IRCopy(buffer).as_buffer_ref();
+    if (bytes <= kMaxStackBufferBytes && stack_bytes + bytes <= kMaxStackBytes) {
+      copy->memory_type = ir::MemoryType::Stack;
+      stack_bytes += bytes;
+    } else {
+      VLOG(3) << "Local buffer " << buffer->name << " of " << bytes << " bytes is left on the heap";
+      copy->memory_type = ir::MemoryType::Heap;
+    }
+    buffer = copy;
+  }
+}
+
 void InitReduceTensor(StageMap stages, const Tensor& tensor, const Target& target) {
   if (tensor->is_reduce_tensor() && !tensor->IsReduceInited(stages)) {
     tensor->InitReduction(stages, target);
@@ -78,10 +128,22 @@ ir::LoweredFunc Lower(const std::string& name,
                       const std::vector<Tensor>& temp_tensors,
                       Module::Builder* b,
                       const Target& target) {
+  utils::ProfileTimer timer("lang.Lower");
+  // Lowering creates and copies lots of IR nodes on this thread, allocate them in an arena.
+  common::ArenaScope arena_scope;
+  // The same index expressions get simplified many times in the passes.
+  common::CasSimplifyMemo cas_memo;
   // Init the reduce tensors first before any process.
   for (auto& t : tensor_args) InitReduceTensor(stages, t, target);
   for (auto& t : temp_tensors) InitReduceTensor(stages, t, target);
 
+  if (FLAGS_cinn_auto_compute_at) {
+    utils::ProfileTimer timer("lang.AutoComputeAt");
+    // Schedule a copy, the stages of the caller are left as they were scheduled.
+    stages = stages->Copy();
+    AutoComputeAt(stages, tensor_args, target, FLAGS_cinn_auto_compute_at_cache_bytes);
+  }
+
   // Merge the ctrl_deps with the given temp_tensors ang get a new temp_tensors
   auto ctrl_deps = CollectTempTensorsFromCtrlDepends(stages, tensor_args);
   ctrl_deps.insert(temp_tensors.begin(), temp_tensors.end());
@@ -92,11 +154,6 @@ ir::LoweredFunc Lower(const std::string& name,
   auto res = lower_impl_instance();
 
   auto temp_buffers = GetTempBuffers(tensor_args, stages, res->body);
-  if (b) {
-    for (auto& temp_buffer : temp_buffers) {
-      b->AddBuffer(temp_buffer);
-    }
-  }
 
   {  // set function device_api
     bool contains_gpu = false;
@@ -111,6 +168,16 @@ ir::LoweredFunc Lower(const std::string& name,
 
     if (contains_gpu) {
       res->device_api = ir::DeviceAPI::GPU;
+    } else {
+      PlaceLocalBuffersOnStack(&temp_buffers);
+    }
+  }
+
+  if (b) {
+    for (auto& temp_buffer : temp_buffers) {
+      // The stack buffers are allocated in the function.
+      if (temp_buffer->memory_type == ir::MemoryType::Stack) continue;
+      b->AddBuffer(temp_buffer);
     }
   }
 
@@ -120,6 +187,15 @@ ir::LoweredFunc Lower(const std::string& name,
 
   res->temp_bufs = temp_buffers;
 
+  if (utils::CompileProfiler::Global().enabled()) {
+    int64_t num_nodes = 0;
+    ir::CollectIRNodes(res->body, [&](const Expr*) {
+      num_nodes++;
+      return false;
+    });
+    utils::CompileProfiler::Global().AddCount("ir_nodes.lowered", num_nodes);
+  }
+
   return res;
 }
 
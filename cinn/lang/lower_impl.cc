@@ -4,12 +4,17 @@
 #include <queue>
 #include <unordered_set>
 
+#include "cinn/common/cas.h"
 #include "cinn/common/ir_util.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/compute_at_postprocess.h"
 #include "cinn/optim/cache_read_write_replace.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/optim/replace_var_with_expr.h"
+#include "cinn/poly/dependence.h"
 #include "cinn/poly/stage.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace lang {
@@ -29,6 +34,161 @@ void CheckNoIslCallRemains(Expr* expr) {
   }
 }
 
+namespace {
+
+//! Collect the PolyFors of the statement of each stage, from the outermost to the innermost.
+struct CollectStatementForloops : public ir::IRMutator<Expr*> {
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+  void Visit(const ir::PolyFor* op, Expr* expr) override {
+    stack.push_back(expr->As<ir::PolyFor>());
+    ir::IRMutator<>::Visit(op, expr);
+    stack.pop_back();
+  }
+
+  void Visit(const ir::Store* op, Expr* expr) override {
+    auto* tensor_n = op->tensor.As<ir::_Tensor_>();
+    CHECK(tensor_n);
+    forloops[tensor_n->name] = stack;
+    stores[tensor_n->name]   = op;
+  }
+
+  std::vector<ir::PolyFor*> stack;
+  std::map<std::string, std::vector<ir::PolyFor*>> forloops;
+  std::map<std::string, const ir::Store*> stores;
+};
+
+//! Get the distance of \p index between two adjacent iterations of \p var, return -1 if it is not a constant.
+int GetStride(const Expr& index, const Var& var) {
+  auto uses = ir::CollectIRNodes(index, [&](const Expr* x) { return x->as_var() && x->as_var()->name == var->name; });
+  if (uses.empty()) return 0;
+  Expr next = optim::IRCopy(index);
+  optim::ReplaceVarWithExpr(&next, var, ir::Add::Make(Expr(var), Expr(1)));
+  Expr stride = common::AutoSimplify(ir::Sub::Make(next, index));
+  return stride.As<ir::IntImm>() ? stride.As<ir::IntImm>()->value : -1;
+}
+
+/**
+ * Get the vectorize factor of the innermost loop \p forloop of the statement \p store, return 0 if the loop can't be
+ * vectorized, that is the store is not its only statement, its extent is not known or the accesses are not contiguous.
+ */
+int GetAutoVectorizeFactor(ir::PolyFor* forloop, const ir::Store* store) {
+  auto* block = forloop->body.As<ir::Block>();
+  Expr stmt   = block && block->stmts.size() == 1 ? block->stmts.front() : forloop->body;
+  if (stmt.As<ir::Store>() != store) return 0;
+
+  if (!forloop->init.As<ir::IntImm>() || forloop->init.As<ir::IntImm>()->value != 0) return 0;
+  auto* lt_n = forloop->condition.As<ir::LT>();
+  auto* le_n = forloop->condition.As<ir::LE>();
+  Expr lhs   = lt_n ? lt_n->a() : le_n ? le_n->a() : Expr();
+  Expr rhs   = lt_n ? lt_n->b() : le_n ? le_n->b() : Expr();
+  if (!lhs.defined() || !lhs.as_var() || lhs.as_var()->name != forloop->iterator->name) return 0;
+  if (!rhs.As<ir::IntImm>()) return 0;
+  int extent = rhs.As<ir::IntImm>()->value + (le_n ? 1 : 0);
+
+  // The vectorizer and the backends support the arithmetics and the contiguous accesses well.
+  auto unsupported = ir::CollectIRNodes(store->value, [](const Expr* x) {
+    return x->As<ir::Call>() || x->As<ir::Let>() || x->As<ir::Select>() || x->As<ir::IfThenElse>();
+  });
+  if (!unsupported.empty()) return 0;
+
+  auto contiguous = [&](const std::vector<Expr>& indices, bool is_store) {
+    for (int i = 0; i < indices.size(); i++) {
+      int stride = GetStride(indices[i], forloop->iterator);
+      if (i + 1 < indices.size() ? stride != 0 : !(stride == 1 || (stride == 0 && !is_store))) return false;
+    }
+    return !indices.empty();
+  };
+  if (!contiguous(store->indices, true)) return 0;
+  auto loads = ir::CollectIRNodes(store->value, [](const Expr* x) { return x->As<ir::Load>(); });
+  for (auto& load : loads) {
+    if (!contiguous(load.As<ir::Load>()->indices, false)) return 0;
+  }
+
+  // Fill a 256-bit vector register, with no remainder iterations.
+  int bits = store->value.type().bits();
+  if (bits <= 0 || bits > 64) return 0;
+  for (int factor = 256 / bits; factor > 1; factor /= 2) {
+    if (extent % factor == 0) return factor;
+  }
+  return 0;
+}
+
+bool StageContainsGPUInfo(poly::Stage* stage) {
+  for (auto& info : stage->forloop_infos()) {
+    if (info.second.device == ir::DeviceAPI::GPU) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+void AnalyzeParallelLoops(const poly::ScheduleGroup& group,
+                          const std::vector<poly::Stage*>& stages,
+                          Expr* expr,
+                          std::map<std::string, std::set<int>>* parallels,
+                          std::map<std::string, ir::VectorizeInfo>* vectorizes) {
+  bool on_cpu = std::none_of(stages.begin(), stages.end(), [](poly::Stage* x) { return StageContainsGPUInfo(x); });
+  bool jam    = std::any_of(stages.begin(), stages.end(), [](poly::Stage* x) { return !x->unroll_and_jams().empty(); });
+
+  bool verify          = FLAGS_cinn_verify_parallel && !parallels->empty();
+  bool infer_parallel  = FLAGS_cinn_auto_parallel && on_cpu;
+  bool infer_vectorize = FLAGS_cinn_auto_vectorize && on_cpu;
+  if (!verify && !infer_parallel && !infer_vectorize && !jam) return;
+
+  utils::ProfileTimer timer("poly.DependenceAnalysis");
+  poly::DependenceAnalysis analysis(stages, group);
+
+  if (verify) {
+    for (auto* stage : stages) {
+      for (int level : stage->parallel_info()) {
+        CHECK(analysis.IsParallel(stage, level))
+            << "The loop " << level << " of stage " << stage->id()
+            << " is scheduled Parallel, but it carries dependences between the iterations";
+      }
+    }
+  }
+  for (auto* stage : stages) {
+    auto axis_names = stage->axis_names();
+    for (auto& [outer, inner] : stage->unroll_and_jams()) {
+      auto outer_it = std::find(axis_names.begin(), axis_names.end(), outer);
+      auto inner_it = std::find(axis_names.begin(), axis_names.end(), inner);
+      // The iterators are renamed by the transforms after the jam.
+      if (outer_it == axis_names.end() || inner_it == axis_names.end()) continue;
+      CHECK(analysis.IsJamLegal(stage, outer_it - axis_names.begin(), inner_it - axis_names.begin()))
+          << "The loop " << inner << " of stage " << stage->id()
+          << " is unrolled and jammed, but it might reverse dependences between the iterations";
+    }
+  }
+  if (!infer_parallel && !infer_vectorize) return;
+
+  CollectStatementForloops collector;
+  collector(expr);
+  for (auto* stage : stages) {
+    int n_levels = stage->n_out_dims();
+    auto it      = collector.forloops.find(stage->id());
+    if (n_levels == 0 || it == collector.forloops.end() || it->second.size() != n_levels) continue;
+
+    if (infer_parallel && stage->parallel_info().empty()) {
+      for (int level = 0; level < n_levels; level++) {
+        if (analysis.IsParallel(stage, level)) {
+          VLOG(3) << "Infer the loop " << level << " of stage " << stage->id() << " parallel";
+          (*parallels)[stage->id()].insert(level);
+          break;
+        }
+      }
+    }
+
+    int innermost = n_levels - 1;
+    if (!infer_vectorize || stage->vectorize_info().valid() || stage->unroll_info().count(innermost)) continue;
+    int factor = GetAutoVectorizeFactor(it->second.back(), collector.stores.at(stage->id()));
+    if (factor > 0 && analysis.IsParallel(stage, innermost)) {
+      VLOG(3) << "Infer the loop " << innermost << " of stage " << stage->id() << " vectorized by " << factor;
+      (*vectorizes)[stage->id()] = ir::VectorizeInfo(innermost, factor);
+    }
+  }
+}
+
 Expr LowerGroup(const poly::ScheduleGroup& group,
                 const std::map<std::string, Expr>& tuple_to_expr,
                 std::map<std::string, ir::Tensor>* global_tensor_map,
@@ -49,9 +209,12 @@ Expr LowerGroup(const poly::ScheduleGroup& group,
   // get isl generated expression
   isl::set context(Context::Global().isl_ctx(), "{:}");
   poly::AstGen gen(context, stages, group);
-  isl::ast_node ast = gen.Build();
   ir::Expr e;
-  poly::IslAstNodeToCinnExpr(ast, &e);
+  {
+    utils::ProfileTimer timer("poly.AstGen");
+    isl::ast_node ast = gen.Build();
+    poly::IslAstNodeToCinnExpr(ast, &e);
+  }
   // now we get a workable expression, but the statement are something like `B(((16 * po0) + po1), po2)`, we need to
   // transform this to some realworld statement in CINN.
 
@@ -72,7 +235,7 @@ Expr LowerGroup(const poly::ScheduleGroup& group,
     Expr statement_candi_expr = tuple_to_expr.at(statement.first);
 
     VLOG(3) << "replacing " << statement.first << " to " << statement_candi_expr;
-    optim::ReplaceIslCallWithExpr(&e, statement.first, statement_candi_expr, axis_expr_map);
+    optim::ReplaceIslCallWithExpr(&e, gen.StatementName(statement.first), statement_candi_expr, axis_expr_map);
   }
   CheckNoIslCallRemains(&e);
 
@@ -81,14 +244,20 @@ Expr LowerGroup(const poly::ScheduleGroup& group,
   // deal with the compute_at relations
   ProcessComputeAtInfo(&e, stage_map);
 
+  std::map<std::string, ir::VectorizeInfo> vectorizes;
+  std::map<std::string, std::set<int>> parallels;
+  for (auto& node : group.nodes) {
+    if (node->stage->vectorize_info().valid()) {
+      vectorizes[node->stage->id()] = node->stage->vectorize_info();
+    }
+    if (!node->stage->parallel_info().empty()) {
+      parallels[node->stage->id()] = node->stage->parallel_info();
+    }
+  }
+  AnalyzeParallelLoops(group, stages, &e, &parallels, &vectorizes);
+
   // mark vectorize.
   {
-    std::map<std::string, ir::VectorizeInfo> vectorizes;
-    for (auto& node : group.nodes) {
-      if (node->stage->vectorize_info().valid()) {
-        vectorizes[node->stage->id()] = node->stage->vectorize_info();
-      }
-    }
     MarkVectorizeMutator mutator(vectorizes);
     mutator(&e);
   }
@@ -105,6 +274,12 @@ Expr LowerGroup(const poly::ScheduleGroup& group,
     mutator(&e);
   }
 
+  // mark parallel.
+  {
+    MarkParallelMutator mutator(parallels);
+    mutator(&e);
+  }
+
   // mark gpu threads
 #ifdef CINN_WITH_CUDA
   {
@@ -384,9 +559,13 @@ ir::LoweredFunc LowerImpl::operator()() {
     if (!stages_[t]->inlined()) stages.push_back(stages_[t]);
   }
 
-  auto deps     = CollectExtraDependencies();
-  auto schedule = poly::CreateSchedule(
-      stages, poly::ScheduleKind::Poly, std::vector<std::pair<std::string, std::string>>(deps.begin(), deps.end()));
+  auto deps = CollectExtraDependencies();
+  std::unique_ptr<poly::Schedule> schedule;
+  {
+    utils::ProfileTimer timer("poly.CreateSchedule");
+    schedule = poly::CreateSchedule(
+        stages, poly::ScheduleKind::Poly, std::vector<std::pair<std::string, std::string>>(deps.begin(), deps.end()));
+  }
 
   auto func_body = GenerateFunctionBody(schedule.get());
 
@@ -241,6 +241,61 @@ struct MarkUnrollMutator : public ir::IRMutator<Expr*> {
   std::vector<ir::PolyFor*> stack;
 };
 
+/**
+ * Mark the PolyFor as parallel if it is scheduled Parallel in Stage.
+ */
+struct MarkParallelMutator : public ir::IRMutator<Expr*> {
+  std::map<std::string, std::set<int> /*level*/> parallels;
+
+  explicit MarkParallelMutator(const std::map<std::string, std::set<int>>& parallels) : parallels(parallels) {}
+
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+  void Visit(const ir::PolyFor* op, Expr* expr) override {
+    auto* node = expr->As<ir::PolyFor>();
+    stack.push_back(node);
+    ir::IRMutator<>::Visit(op, expr);
+    stack.pop_back();
+  }
+
+  // each statement in ISL is bound to a Store node.
+  void Visit(const ir::Store* op, Expr* expr) override {
+    auto* tensor_n = op->tensor.As<ir::_Tensor_>();
+    CHECK(tensor_n);
+    auto it = parallels.find(tensor_n->name);
+    if (it != parallels.end()) {
+      for (int level : it->second) {
+        VLOG(1) << "Mark " << level << " Parallel";
+        CHECK_LT(level, stack.size());
+        stack[level]->set_parallel();
+      }
+    }
+  }
+
+  std::vector<ir::PolyFor*> stack;
+};
+
+/**
+ * \brief Analyze the dependences between the stages of a group to decide the parallel loops.
+ *
+ * Check the unrolled and jammed loops reverse no dependence. If FLAGS_cinn_verify_parallel, check the loops scheduled
+ * Parallel carry no dependence. The stages without GPU schedules get a default CPU schedule: if
+ * FLAGS_cinn_auto_parallel, the outermost loop proven to carry no dependence runs in parallel, and if
+ * FLAGS_cinn_auto_vectorize, the innermost loop is vectorized if it carries no dependence and accesses the memory
+ * contiguously.
+ *
+ * @param group The schedule group.
+ * @param stages The stages of the group with expressions.
+ * @param expr The expression generated for the group.
+ * @param parallels The levels of the loops to run in parallel of each stage.
+ * @param vectorizes The loops to vectorize of each stage.
+ */
+void AnalyzeParallelLoops(const poly::ScheduleGroup& group,
+                          const std::vector<poly::Stage*>& stages,
+                          Expr* expr,
+                          std::map<std::string, std::set<int>>* parallels,
+                          std::map<std::string, ir::VectorizeInfo>* vectorizes);
+
 }  // namespace detail
 }  // namespace lang
 }  // namespace cinn
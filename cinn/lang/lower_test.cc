@@ -6,6 +6,7 @@
 #include "cinn/lang/buffer.h"
 #include "cinn/lang/compute.h"
 #include "cinn/lang/placeholder.h"
+#include "cinn/utils/profiler.h"
 #include "cinn/utils/string.h"
 
 namespace cinn {
@@ -44,6 +45,36 @@ TEST(lower, basic) {
   TEST_SOUTPUT(lower_funcs->body, out);
 }
 
+TEST(lower, isl_ast_cache) {
+  auto& profiler = utils::CompileProfiler::Global();
+  bool enabled   = profiler.enabled();
+  profiler.set_enabled(true);
+  profiler.Clear();
+
+  // The computations of the same shape share the isl AST built.
+  auto lower = [](const std::string& prefix) {
+    Placeholder<float> A(prefix + "A", {Expr(32), Expr(16)});
+    auto B = Compute(
+        {Expr(32), Expr(16)}, [=](Var i, Var j) -> Expr { return A(i, j) * 2.f; }, prefix + "B");
+    auto stages = CreateStages({B});
+    stages[B]->Split(0, 4);
+    return Lower(prefix + "fn", stages, {A, B});
+  };
+  auto fn0 = lower("x_");
+  auto fn1 = lower("y_");
+  ASSERT_GE(profiler.GetCount("-", "isl.ast_cache_hits"), 1);
+
+  // The statements are renamed back to the tensors of each function.
+  auto body0 = utils::GetStreamCnt(fn0->body);
+  auto body1 = utils::GetStreamCnt(fn1->body);
+  ASSERT_EQ(body1.find("x_"), std::string::npos) << body1;
+  utils::Replace(&body0, "x_", "y_");
+  ASSERT_EQ(body0, body1);
+
+  profiler.Clear();
+  profiler.set_enabled(enabled);
+}
+
 TEST(lower, more_complex) {
   Expr M(100);
   Expr N(15);
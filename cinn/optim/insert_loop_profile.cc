@@ -0,0 +1,82 @@
+#include "cinn/optim/insert_loop_profile.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/runtime/cpu/loop_profiler.h"
+#include "cinn/runtime/intrinsic.h"
+
+DEFINE_int32(cinn_loop_profile_depth,
+             -1,
+             "Instrument the CPU kernels with the cycle counters of their bodies and their forloops nested no deeper "
+             "than it, -1 to disable");
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+struct LoopProfileInserter : public ir::IRMutator<> {
+  explicit LoopProfileInserter(int max_depth) : max_depth_(max_depth) {}
+
+  void operator()(Expr* expr) {
+    auto* func = expr->As<ir::_LoweredFunc_>();
+    if (!func) return;
+    auto* body = func->body.As<ir::Block>();
+    CHECK(body);
+    names_        = {runtime::cpu::LoopProfiler::Global().NewFunctionName(func->name)};
+    num_siblings_ = {0};
+    ir::IRMutator<>::Visit(&func->body, &func->body);
+
+    auto [begin, end] = CreateCounterCalls(names_.front());
+    body->stmts.insert(body->stmts.begin(), begin);
+    body->stmts.push_back(end);
+  }
+
+ private:
+  void Visit(const ir::For* op, Expr* expr) override {
+    if (names_.size() > max_depth_) {
+      ir::IRMutator<>::Visit(op, expr);
+      return;
+    }
+    int index = num_siblings_.back()++;
+    names_.push_back(names_.back() + "/" + std::to_string(index) + ":" + op->loop_var->name);
+    num_siblings_.push_back(0);
+    ir::IRMutator<>::Visit(op, expr);
+    auto [begin, end] = CreateCounterCalls(names_.back());
+    names_.pop_back();
+    num_siblings_.pop_back();
+
+    *expr = ir::Block::Make({begin, *expr, end});
+  }
+
+  //! Create the calls to start and end a call of the counter \p name.
+  std::tuple<Expr, Expr> CreateCounterCalls(const std::string& name) {
+    Expr counter(runtime::cpu::LoopProfiler::Global().GetCounterId(name));
+    Var start(Context::Global().NewName("profile_start"), Int(64));
+    Expr begin = ir::Call::Make(
+        Int(64), runtime::intrisic::profile_begin, {counter}, {}, ir::CallType::Extern, ir::FunctionRef(), 0);
+    Expr end   = ir::Call::Make(
+        Void(), runtime::intrisic::profile_end, {counter, Expr(start)}, {}, ir::CallType::Extern, ir::FunctionRef(), 0);
+    return std::make_tuple(ir::Let::Make(start, begin), end);
+  }
+
+  int max_depth_;
+  //! The names of the counters of the function and the enclosing forloops.
+  std::vector<std::string> names_;
+  //! The numbers of the forloops visited at each level.
+  std::vector<int> num_siblings_;
+};
+
+}  // namespace
+
+void InsertLoopProfile(Expr* expr, int max_depth) {
+  LoopProfileInserter inserter(max_depth);
+  inserter(expr);
+}
+
+}  // namespace optim
+}  // namespace cinn
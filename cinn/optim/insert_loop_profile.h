@@ -0,0 +1,48 @@
+#pragma once
+#include <gflags/gflags.h>
+
+#include "cinn/ir/ir.h"
+
+DECLARE_int32(cinn_loop_profile_depth);
+
+namespace cinn {
+namespace optim {
+
+/**
+ * Instrument a lowered function with the cycle counters of `runtime::cpu::LoopProfiler`. The body of the function and
+ * the forloops nested no deeper than \p max_depth are timed, e.g. with \p max_depth 1
+ *
+ * \code
+ * function fn (_A, _B)
+ * {
+ *   for (i, 0, 32) {
+ *     ...
+ *   }
+ * }
+ * \endcode
+ *
+ * is transformed to
+ *
+ * \code
+ * function fn (_A, _B)
+ * {
+ *   int64 profile_start_1 = cinn_profile_begin(0)
+ *   {
+ *     int64 profile_start_0 = cinn_profile_begin(1)
+ *     for (i, 0, 32) {
+ *       ...
+ *     }
+ *     cinn_profile_end(1, profile_start_0)
+ *   }
+ *   cinn_profile_end(0, profile_start_1)
+ * }
+ * \endcode
+ *
+ * where the counters 0 and 1 are `fn` and `fn/0:i`, or `fn#<n>` and `fn#<n>/0:i` if a function `fn` is instrumented
+ * before. The counters are read by the time stamp counter, they are meant
+ * for the shares of the loop nests in a kernel rather than the absolute time.
+ */
+void InsertLoopProfile(Expr* expr, int max_depth);
+
+}  // namespace optim
+}  // namespace cinn
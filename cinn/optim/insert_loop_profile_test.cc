@@ -0,0 +1,92 @@
+#include "cinn/optim/insert_loop_profile.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/backends/llvm/simple_jit.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/runtime/cpu/loop_profiler.h"
+#include "cinn/runtime/cpu/use_extern_funcs.h"
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace optim {
+
+TEST(InsertLoopProfile, lower) {
+  int profile_depth             = FLAGS_cinn_loop_profile_depth;
+  FLAGS_cinn_loop_profile_depth = 1;
+
+  Expr M(8), N(32);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Expr i, Expr j) { return A(i, j) + 1.f; }, "B");
+  auto C = Compute(
+      {M, N}, [&](Expr i, Expr j) { return A(i, j) * 2.f; }, "C");
+  auto stages = CreateStages({B, C});
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  auto fn = Lower("fn_loop_profile", stages, {A, B, C}, {}, {}, &builder);
+  LOG(INFO) << "fn:\n" << fn;
+  FLAGS_cinn_loop_profile_depth = profile_depth;
+  ASSERT_NE(utils::GetStreamCnt(fn).find("cinn_profile_begin"), std::string::npos);
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build(), false);
+  auto* fn_handler = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn_loop_profile"));
+
+  auto A_buf    = common::BufferBuilder(Float(32), {8, 32}).set_random().Build();
+  auto B_buf    = common::BufferBuilder(Float(32), {8, 32}).set_zero().Build();
+  auto C_buf    = common::BufferBuilder(Float(32), {8, 32}).set_zero().Build();
+  auto arg_pack = common::ArgsBuilder().Add(A_buf).Add(B_buf).Add(C_buf).Build();
+
+  auto& profiler = runtime::cpu::LoopProfiler::Global();
+  profiler.Reset();
+  fn_handler(arg_pack.data(), arg_pack.size());
+  fn_handler(arg_pack.data(), arg_pack.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* C_data = reinterpret_cast<float*>(C_buf->memory);
+  for (int i = 0; i < 8 * 32; i++) ASSERT_NEAR(C_data[i], A_data[i] * 2.f, 1e-5);
+
+  // The body and the two outermost forloops, the inner forloops are not instrumented.
+  std::vector<runtime::cpu::LoopProfiler::Counter> counters;
+  for (auto& counter : profiler.GetCounters()) {
+    if (utils::Startswith(counter.name, "fn_loop_profile")) counters.push_back(counter);
+  }
+  LOG(INFO) << "\n" << profiler.SummaryTable();
+  ASSERT_EQ(counters.size(), 3UL);
+  ASSERT_EQ(counters[0].name, "fn_loop_profile");
+  ASSERT_TRUE(utils::Startswith(counters[1].name, "fn_loop_profile/0:"));
+  ASSERT_TRUE(utils::Startswith(counters[2].name, "fn_loop_profile/1:"));
+  for (auto& counter : counters) {
+    ASSERT_EQ(counter.calls, 2);
+    ASSERT_GT(counter.cycles, 0);
+  }
+  ASSERT_GE(counters[0].cycles, counters[1].cycles + counters[2].cycles);
+}
+
+TEST(InsertLoopProfile, unique_names) {
+  int profile_depth             = FLAGS_cinn_loop_profile_depth;
+  FLAGS_cinn_loop_profile_depth = 0;
+
+  Expr M(8);
+  Placeholder<float> A("A", {M});
+  auto B = Compute(
+      {M}, [&](Expr i) { return A(i) + 1.f; }, "B");
+  auto stages = CreateStages({B});
+
+  // The functions of the same name in two graphs take two counters.
+  auto fn0 = Lower("fn_loop_profile_unique", stages, {A, B});
+  auto fn1 = Lower("fn_loop_profile_unique", stages, {A, B});
+  FLAGS_cinn_loop_profile_depth = profile_depth;
+
+  std::vector<std::string> names;
+  for (auto& counter : runtime::cpu::LoopProfiler::Global().GetCounters()) {
+    if (utils::Startswith(counter.name, "fn_loop_profile_unique")) names.push_back(counter.name);
+  }
+  ASSERT_EQ(names, (std::vector<std::string>{"fn_loop_profile_unique", "fn_loop_profile_unique#1"}));
+}
+
+}  // namespace optim
+}  // namespace cinn
@@ -6,7 +6,7 @@
 namespace cinn {
 namespace optim {
 
-//! Shallow copy an expression.
+//! Deep copy an expression, so the copy can be mutated in place without changing \p x.
 Expr IRCopy(Expr x);
 
 }  // namespace optim
@@ -7,6 +7,7 @@
 #include "cinn/ir/intrinsic_ops.h"
 #include "cinn/ir/ir_mutator.h"
 #include "cinn/ir/registry.h"
+#include "cinn/optim/vectorize_loops.h"
 
 namespace cinn {
 namespace optim {
@@ -32,6 +33,11 @@ void LowerIntrin(Expr *e, Target target) {
     }
 
     void LowerCpuIntrisicOp(ir::Call *node, Expr *expr) {
+      // The vectorized math calls are emitted inline by the LLVM backend, only lower the arguments.
+      if (IsVectorMathCall(node)) {
+        ir::IRMutator<>::Visit(node, expr);
+        return;
+      }
       if (kIntrinsicCalls.count(node->name)) {
         CHECK(!node->name.empty());
         auto *func_ptr = ir::Registry::Get("lower_cpu_intrinsic_" + node->name);
@@ -27,7 +27,8 @@ void MapExternCall(Expr *e, Target target) {
     }
 
     void DealWithCpuIntrisics(ir::Call *node, Expr *expr) {
-      if (kExternFp32CallsCPU.count(node->name)) {
+      // An extern scalar function can not take vectors, the vectorized calls are left to the backend.
+      if (kExternFp32CallsCPU.count(node->name) && node->type().lanes() == 1) {
         CHECK_GE(node->read_args.size(), 1UL);
         CHECK_EQ(node->read_args.front().type(), Float(32));
         auto out_type = node->type();
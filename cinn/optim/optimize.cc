@@ -11,53 +11,74 @@
 #include "cinn/optim/fold_cinn_call_arguments.h"
 #include "cinn/optim/if_simplify.h"
 #include "cinn/optim/insert_debug_log_callee.h"
+#include "cinn/optim/insert_loop_profile.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/lower_function_call_bind_vars.h"
 #include "cinn/optim/lower_intrin.h"
 #include "cinn/optim/map_extern_call.h"
+#include "cinn/optim/partition_loops.h"
+#include "cinn/optim/reduce_index_strength.h"
 #include "cinn/optim/remove_nested_block.h"
 #include "cinn/optim/replace_const_param_to_integer.h"
 #include "cinn/optim/transform_gpu_forloop.h"
 #include "cinn/optim/transform_polyfor_to_for.h"
 #include "cinn/optim/unroll_loops.h"
 #include "cinn/optim/vectorize_loops.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace optim {
 
+//! Run a pass, timed by the compile profiler.
+#define CINN_OPTIM_RUN_PASS(pass__, ...)              \
+  {                                                   \
+    utils::ProfileTimer pass_timer("optim." #pass__); \
+    pass__(__VA_ARGS__);                              \
+  }
+
 Expr Optimize(Expr e, Target target, bool runtime_debug_info) {
   CHECK(e.defined());
   auto copied = IRCopy(e);
 
-  FoldCINNCallArguments(&copied);
-  TransformPolyForToFor(&copied);
-  CastSimplify(&copied);
-  Simplify(&copied);
-  VectorizeLoops(&copied, Target());
-  EliminateBroadcastInForloop(&copied);
-  UnrollLoop(&copied);
+  CINN_OPTIM_RUN_PASS(FoldCINNCallArguments, &copied);
+  CINN_OPTIM_RUN_PASS(TransformPolyForToFor, &copied);
+  CINN_OPTIM_RUN_PASS(CastSimplify, &copied);
+  CINN_OPTIM_RUN_PASS(Simplify, &copied);
+  if (FLAGS_cinn_partition_loops && target.arch == Target::Arch::X86) {
+    CINN_OPTIM_RUN_PASS(PartitionLoops, &copied);
+    CINN_OPTIM_RUN_PASS(Simplify, &copied);
+  }
+  CINN_OPTIM_RUN_PASS(VectorizeLoops, &copied, target);
+  CINN_OPTIM_RUN_PASS(EliminateBroadcastInForloop, &copied);
+  CINN_OPTIM_RUN_PASS(UnrollLoop, &copied);
 #ifdef CINN_WITH_CUDA
-  RemoveGpuForloopsAxis(&copied);
-  CudaSyncThreadsDropIfThenElse(&copied);
+  CINN_OPTIM_RUN_PASS(RemoveGpuForloopsAxis, &copied);
+  CINN_OPTIM_RUN_PASS(CudaSyncThreadsDropIfThenElse, &copied);
 #endif
   // CacheReadWriteReplace(&copied);
 
-  RemoveNestedBlock(&copied);
+  CINN_OPTIM_RUN_PASS(RemoveNestedBlock, &copied);
 
-  MapExternCall(&copied, target);
-  ExternCallMultiOutputShallowStore(&copied);
+  CINN_OPTIM_RUN_PASS(MapExternCall, &copied, target);
+  CINN_OPTIM_RUN_PASS(ExternCallMultiOutputShallowStore, &copied);
 
-  ReplaceConstParamToInteger(&copied);
-  CastBoolToInt8(&copied, target);
-  CastSimplify(&copied);
-  Simplify(&copied);
-  CompareSimplify(&copied);
-  IfSimplify(&copied);
+  CINN_OPTIM_RUN_PASS(ReplaceConstParamToInteger, &copied);
+  CINN_OPTIM_RUN_PASS(CastBoolToInt8, &copied, target);
+  CINN_OPTIM_RUN_PASS(CastSimplify, &copied);
+  CINN_OPTIM_RUN_PASS(Simplify, &copied);
+  CINN_OPTIM_RUN_PASS(CompareSimplify, &copied);
+  CINN_OPTIM_RUN_PASS(IfSimplify, &copied);
+  if (FLAGS_cinn_reduce_index_strength && target.arch == Target::Arch::X86) {
+    CINN_OPTIM_RUN_PASS(ReduceIndexStrength, &copied);
+  }
+  if (FLAGS_cinn_loop_profile_depth >= 0 && target.arch == Target::Arch::X86) {
+    CINN_OPTIM_RUN_PASS(InsertLoopProfile, &copied, FLAGS_cinn_loop_profile_depth);
+  }
 
   if (runtime_debug_info) {
     LOG(WARNING) << "Turn on runtime debug information output";
-    InsertDebugLogCallee(&copied);
+    CINN_OPTIM_RUN_PASS(InsertDebugLogCallee, &copied);
   }
 
   return copied;
@@ -66,12 +87,14 @@ Expr Optimize(Expr e, Target target, bool runtime_debug_info) {
 ir::Module Optimize(const ir::Module& module, const Target& target) {
   auto copied = IRCopy(Expr(module));
 
-  LowerFunctionCallBindVars(&copied);
-  CallArgListToPodValue(&copied);
-  LowerIntrin(&copied, target);
+  CINN_OPTIM_RUN_PASS(LowerFunctionCallBindVars, &copied);
+  CINN_OPTIM_RUN_PASS(CallArgListToPodValue, &copied);
+  CINN_OPTIM_RUN_PASS(LowerIntrin, &copied, target);
 
   return copied.as_module_ref();
 }
 
+#undef CINN_OPTIM_RUN_PASS
+
 }  // namespace optim
 }  // namespace cinn
@@ -0,0 +1,355 @@
+#include "cinn/optim/partition_loops.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cinn/common/cas.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/optim/replace_var_with_expr.h"
+
+DEFINE_bool(cinn_partition_loops,
+            false,
+            "Whether to partition the CPU forloops to strip the boundary conditions out of their steady states");
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+bool ContainsVar(const Expr& x, const std::string& var) {
+  return !ir::CollectIRNodes(x, [&](const Expr* n) { return n->As<ir::_Var_>() && n->As<ir::_Var_>()->name == var; })
+              .empty();
+}
+
+/**
+ * Decompose the expression \p x to `coef * var + rest`, where the rest is free of \p var.
+ * @return false if \p x is not linear to \p var.
+ */
+bool DecomposeLinear(const Expr& x, const std::string& var, int* coef, Expr* rest) {
+  if (!ContainsVar(x, var)) {
+    *coef = 0;
+    *rest = x;
+    return true;
+  }
+  if (x.As<ir::_Var_>()) {
+    *coef = 1;
+    *rest = Expr(0);
+    return true;
+  }
+
+  int coef_a, coef_b;
+  Expr rest_a, rest_b;
+  if (auto* op = x.As<ir::Add>()) {
+    if (!DecomposeLinear(op->a(), var, &coef_a, &rest_a) || !DecomposeLinear(op->b(), var, &coef_b, &rest_b)) {
+      return false;
+    }
+    *coef = coef_a + coef_b;
+    *rest = rest_a + rest_b;
+    return true;
+  }
+  if (auto* op = x.As<ir::Sub>()) {
+    if (!DecomposeLinear(op->a(), var, &coef_a, &rest_a) || !DecomposeLinear(op->b(), var, &coef_b, &rest_b)) {
+      return false;
+    }
+    *coef = coef_a - coef_b;
+    *rest = rest_a - rest_b;
+    return true;
+  }
+  if (auto* op = x.As<ir::Mul>()) {
+    auto* factor = op->a().As<ir::IntImm>() ? op->a().As<ir::IntImm>() : op->b().As<ir::IntImm>();
+    if (!factor) return false;
+    if (!DecomposeLinear(op->a().As<ir::IntImm>() ? op->b() : op->a(), var, &coef_a, &rest_a)) return false;
+    *coef = coef_a * factor->value;
+    *rest = rest_a * Expr(static_cast<int>(factor->value));
+    return true;
+  }
+  if (auto* op = x.As<ir::Minus>()) {
+    if (!DecomposeLinear(op->v(), var, &coef_a, &rest_a)) return false;
+    *coef = -coef_a;
+    *rest = -rest_a;
+    return true;
+  }
+  return false;
+}
+
+void FlattenAnd(const Expr& x, std::vector<Expr>* conjuncts) {
+  if (auto* op = x.As<ir::And>()) {
+    FlattenAnd(op->a(), conjuncts);
+    FlattenAnd(op->b(), conjuncts);
+  } else {
+    conjuncts->push_back(x);
+  }
+}
+
+Expr FoldMax(Expr a, Expr b) {
+  if (a.As<ir::IntImm>() && b.As<ir::IntImm>()) return Expr(std::max(a.as_int32(), b.as_int32()));
+  return ir::Max::Make(a, b);
+}
+
+Expr FoldMin(Expr a, Expr b) {
+  if (a.As<ir::IntImm>() && b.As<ir::IntImm>()) return Expr(std::min(a.as_int32(), b.as_int32()));
+  return ir::Min::Make(a, b);
+}
+
+Expr FoldSub(Expr a, Expr b) {
+  if (a.As<ir::IntImm>() && b.As<ir::IntImm>()) return Expr(a.as_int32() - b.as_int32());
+  return a - b;
+}
+
+//! A condition linear to the loop variable, which holds in `var >= bound` or `var < bound`.
+struct Atom {
+  Expr bound;
+  bool is_lower;
+};
+
+/**
+ * Collect the conditions solvable for the loop variable in a forloop body, or rewrite the body to the steady state
+ * where all of them are constant.
+ *
+ * The collecting and the rewriting assume the same value for a condition, so the range of the steady state intersected
+ * from the collected bounds implies the conditions folded.
+ */
+class SteadyStateMutator : public ir::IRMutator<> {
+ public:
+  SteadyStateMutator(const ir::For* forloop, bool rewrite) : forloop_(forloop), rewrite_(rewrite) {
+    auto inner = ir::CollectIRNodes(forloop->body, [](const Expr* x) { return x->As<ir::For>() || x->As<ir::Let>(); });
+    for (auto& x : inner) {
+      if (auto* op = x.As<ir::For>()) inner_vars_.insert(op->loop_var->name);
+      if (auto* op = x.As<ir::Let>()) {
+        if (op->symbol.As<ir::_Var_>()) inner_vars_.insert(op->symbol.As<ir::_Var_>()->name);
+      }
+    }
+  }
+
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+  const std::vector<Expr>& lower_bounds() const { return lower_bounds_; }
+  const std::vector<Expr>& upper_bounds() const { return upper_bounds_; }
+
+ private:
+  enum class Truth { kTrue, kFalse, kUnknown };
+
+  void Visit(const ir::IfThenElse* op, Expr* expr) override {
+    auto* node  = expr->As<ir::IfThenElse>();
+    Truth truth = ProcessCondition(&node->condition);
+    if (rewrite_ && truth != Truth::kUnknown) {
+      Expr branch = truth == Truth::kTrue ? node->true_case : node->false_case;
+      *expr       = branch.defined() ? branch : ir::Block::Make({});
+      ir::IRMutator<>::Visit(expr, expr);
+      return;
+    }
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Select* op, Expr* expr) override {
+    auto* node  = expr->As<ir::Select>();
+    Truth truth = ProcessCondition(&node->condition);
+    if (rewrite_ && truth != Truth::kUnknown) {
+      Expr value = truth == Truth::kTrue ? node->true_value : node->false_value;
+      *expr      = value;
+      ir::IRMutator<>::Visit(expr, expr);
+      return;
+    }
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Min* op, Expr* expr) override {
+    if (!ProcessMinMax(ir::LE::Make(op->a(), op->b()), op->a(), op->b(), expr)) ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Max* op, Expr* expr) override {
+    if (!ProcessMinMax(ir::GE::Make(op->a(), op->b()), op->a(), op->b(), expr)) ir::IRMutator<>::Visit(op, expr);
+  }
+
+  /**
+   * Process a condition of `IfThenElse` or `Select`, the conjuncts solvable are assumed true, and a single comparison
+   * might be assumed false if it holds in fewer iterations.
+   * @return The value of the condition in the steady state, the rewriting removes the conjuncts assumed true from it.
+   */
+  Truth ProcessCondition(Expr* cond) {
+    std::vector<Expr> conjuncts;
+    FlattenAnd(*cond, &conjuncts);
+    Atom atom;
+    if (conjuncts.size() == 1) {
+      if (!Solve(conjuncts.front(), &atom)) return Truth::kUnknown;
+      bool value = AssumeTrue(atom, true);
+      Add(atom, value);
+      return value ? Truth::kTrue : Truth::kFalse;
+    }
+
+    std::vector<Expr> left;
+    for (auto& x : conjuncts) {
+      if (Solve(x, &atom)) {
+        Add(atom, true);
+      } else {
+        left.push_back(x);
+      }
+    }
+    if (left.empty()) return Truth::kTrue;
+    if (rewrite_ && left.size() < conjuncts.size()) {
+      *cond = left.front();
+      for (int i = 1; i < left.size(); i++) *cond = ir::And::Make(*cond, left[i]);
+    }
+    return Truth::kUnknown;
+  }
+
+  //! Process `cinn_min(a, b)` or `cinn_max(a, b)` which is `a` if \p cond holds, by default the operand free of the
+  //! loop variable is picked, like the extent of the tail of a split forloop.
+  bool ProcessMinMax(const Expr& cond, Expr a, Expr b, Expr* expr) {
+    Atom atom;
+    if (!Solve(cond, &atom)) return false;
+    bool value = AssumeTrue(atom, !ContainsVar(a, var()) || ContainsVar(b, var()));
+    Add(atom, value);
+    if (!rewrite_) return false;
+    *expr = value ? a : b;
+    ir::IRMutator<>::Visit(expr, expr);
+    return true;
+  }
+
+  const std::string& var() const { return forloop_->loop_var->name; }
+
+  bool IsInvariant(const Expr& x) const {
+    return ir::CollectIRNodes(x, [&](const Expr* n) {
+             auto* v = n->As<ir::_Var_>();
+             return n->As<ir::Load>() || n->As<ir::Call>() || (v && inner_vars_.count(v->name));
+           })
+        .empty();
+  }
+
+  //! Solve the comparison \p cond for the loop variable.
+  bool Solve(const Expr& cond, Atom* atom) const {
+    // cond holds iff diff >= 0.
+    Expr diff;
+    auto is_int32 = [](const Expr& a, const Expr& b) { return a.type() == Int(32) && b.type() == Int(32); };
+    if (auto* op = cond.As<ir::GE>()) {
+      if (is_int32(op->a(), op->b())) diff = op->a() - op->b();
+    } else if (auto* op = cond.As<ir::GT>()) {
+      if (is_int32(op->a(), op->b())) diff = op->a() - op->b() - Expr(1);
+    } else if (auto* op = cond.As<ir::LE>()) {
+      if (is_int32(op->a(), op->b())) diff = op->b() - op->a();
+    } else if (auto* op = cond.As<ir::LT>()) {
+      if (is_int32(op->a(), op->b())) diff = op->b() - op->a() - Expr(1);
+    }
+    if (!diff.defined()) return false;
+
+    int coef;
+    Expr rest;
+    if (!DecomposeLinear(diff, var(), &coef, &rest) || coef == 0 || !IsInvariant(rest)) return false;
+
+    // `coef * var + rest >= 0` holds in `var >= ceil(-rest / coef)` for a positive coef, and in
+    // `var < floor(rest / -coef) + 1` for a negative one. The loop variable is non-negative, the truncated division of
+    // the negative dividends results in bounds no more than 0, which tell the same iterations as the floor division.
+    int k          = std::abs(coef);
+    atom->is_lower = coef > 0;
+    Expr dividend  = common::AutoSimplify(atom->is_lower ? Expr(k - 1) - rest : rest + Expr(k));
+    if (dividend.As<ir::IntImm>()) {
+      atom->bound = Expr(dividend.as_int32() / k);
+    } else {
+      atom->bound = k == 1 ? dividend : ir::Div::Make(dividend, Expr(k));
+    }
+    return true;
+  }
+
+  //! Tell whether to assume the condition true in the steady state, the value holding in more iterations is picked if
+  //! the forloop and the bound are constant.
+  bool AssumeTrue(const Atom& atom, bool by_default) const {
+    auto* extent = forloop_->extent.As<ir::IntImm>();
+    auto* bound  = atom.bound.As<ir::IntImm>();
+    if (!extent || !bound) return by_default;
+    int begin    = forloop_->min.as_int32();
+    int end      = begin + extent->value;
+    int split    = std::min(std::max<int>(bound->value, begin), end);
+    int num_true = atom.is_lower ? end - split : split - begin;
+    return 2 * num_true >= end - begin;
+  }
+
+  void Add(const Atom& atom, bool value) {
+    if (rewrite_) return;
+    // The negation of `var >= bound` is `var < bound`.
+    if (atom.is_lower == value) {
+      lower_bounds_.push_back(atom.bound);
+    } else {
+      upper_bounds_.push_back(atom.bound);
+    }
+  }
+
+  const ir::For* forloop_;
+  bool rewrite_;
+  //! The variables defined in the forloop body, the bounds never refer to them.
+  std::set<std::string> inner_vars_;
+  std::vector<Expr> lower_bounds_;
+  std::vector<Expr> upper_bounds_;
+};
+
+struct LoopPartitioner : public ir::IRMutator<> {
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::For* op, Expr* expr) override {
+    if (!IsPartitionable(op) || !Partition(op, expr)) ir::IRMutator<>::Visit(op, expr);
+  }
+
+  bool IsPartitionable(const ir::For* op) const {
+    int kept_types = static_cast<int>(ir::ForType::Parallel) | static_cast<int>(ir::ForType::Unrolled);
+    if (static_cast<int>(op->for_type()) & ~kept_types) return false;
+    if (op->device_api != ir::DeviceAPI::UNK && op->device_api != ir::DeviceAPI::Host) return false;
+    auto* min = op->min.As<ir::IntImm>();
+    return min && min->value >= 0 && op->extent.type() == Int(32);
+  }
+
+  bool Partition(const ir::For* op, Expr* expr) {
+    Expr body = op->body;
+    SteadyStateMutator collector(op, false);
+    collector(&body);
+    if (collector.lower_bounds().empty() && collector.upper_bounds().empty()) return false;
+
+    Expr begin = op->min;
+    Expr end   = op->extent.As<ir::IntImm>() ? Expr(op->min.as_int32() + op->extent.as_int32()) : op->min + op->extent;
+    Expr steady_begin = begin;
+    for (auto& x : collector.lower_bounds()) steady_begin = FoldMax(steady_begin, x);
+    steady_begin    = FoldMin(steady_begin, end);
+    Expr steady_end = end;
+    for (auto& x : collector.upper_bounds()) steady_end = FoldMin(steady_end, x);
+    steady_end = FoldMax(steady_end, steady_begin);
+
+    Expr steady_extent = FoldSub(steady_end, steady_begin);
+    if (steady_extent.As<ir::IntImm>() && steady_extent.as_int32() <= 0) return false;
+    VLOG(3) << "Partition forloop " << op->loop_var->name << " at " << steady_begin << " and " << steady_end;
+
+    std::vector<Expr> pieces;
+    // The pieces start from 0 to be vectorized or unrolled.
+    auto add_piece = [&](Expr piece_begin, Expr piece_end, Expr piece_body) {
+      Expr extent = FoldSub(piece_end, piece_begin);
+      if (extent.As<ir::IntImm>() && extent.as_int32() <= 0) return;
+      if (!piece_begin.is_constant() || piece_begin.as_int32() != 0) {
+        ReplaceVarWithExpr(&piece_body, op->loop_var, Expr(op->loop_var) + piece_begin);
+      }
+      pieces.push_back(ir::For::Make(
+          op->loop_var, Expr(0), extent, op->for_type(), op->device_api, piece_body, op->vectorize_info()));
+    };
+
+    Expr steady_body = IRCopy(op->body);
+    SteadyStateMutator rewriter(op, true);
+    rewriter(&steady_body);
+    ir::IRMutator<>::Visit(&steady_body, &steady_body);
+
+    add_piece(begin, steady_begin, IRCopy(op->body));
+    add_piece(steady_begin, steady_end, steady_body);
+    add_piece(steady_end, end, IRCopy(op->body));
+    *expr = pieces.size() == 1 ? pieces.front() : ir::Block::Make(pieces);
+    return true;
+  }
+};
+
+}  // namespace
+
+void PartitionLoops(Expr* expr) { LoopPartitioner()(expr); }
+
+}  // namespace optim
+}  // namespace cinn
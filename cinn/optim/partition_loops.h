@@ -0,0 +1,43 @@
+#pragma once
+#include <gflags/gflags.h>
+
+#include "cinn/ir/ir.h"
+
+DECLARE_bool(cinn_partition_loops);
+
+namespace cinn {
+namespace optim {
+
+/**
+ * Partition the forloops to strip the boundary conditions out of their steady states.
+ *
+ * The conditions in a forloop body linear to the loop variable, the conditions of `IfThenElse` and `Select`, and the
+ * comparisons of `cinn_min` and `cinn_max`, hold in a range of the iterations. A forloop is split into a prologue, a
+ * steady state and an epilogue, where all the conditions are constant in the steady state and folded, e.g.
+ *
+ * \code
+ * for (i, 0, 16) {
+ *   B[i] = select(((i >= 1) and (i < 15)), A[i], 0)
+ * }
+ * \endcode
+ *
+ * is partitioned to
+ *
+ * \code
+ * for (i, 0, 1) {
+ *   B[i] = select(((i >= 1) and (i < 15)), A[i], 0)
+ * }
+ * for (i, 0, 14) {
+ *   B[(1 + i)] = A[(1 + i)]
+ * }
+ * for (i, 0, 1) {
+ *   B[(15 + i)] = select((((15 + i) >= 1) and ((15 + i) < 15)), A[(15 + i)], 0)
+ * }
+ * \endcode
+ *
+ * Only the steady states are partitioned recursively, the vectorized forloops and the GPU forloops are kept.
+ */
+void PartitionLoops(Expr* expr);
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,126 @@
+#include "cinn/optim/partition_loops.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/backends/llvm/simple_jit.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/optim/ir_simplify.h"
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+//! Get the forloops in the order of the statements.
+std::vector<const ir::For*> GetForloops(Expr expr) {
+  std::vector<const ir::For*> forloops;
+  if (auto* op = expr.As<ir::For>()) return {op};
+  if (auto* op = expr.As<ir::Block>()) {
+    for (auto& stmt : op->stmts) {
+      auto x = GetForloops(stmt);
+      forloops.insert(forloops.end(), x.begin(), x.end());
+    }
+  }
+  return forloops;
+}
+
+}  // namespace
+
+TEST(PartitionLoops, select) {
+  Placeholder<float> A("A", std::vector<int>{{16}});
+  Placeholder<float> B("B", std::vector<int>{{16}});
+  Var i("i");
+
+  Expr cond  = ir::And::Make(ir::GE::Make(i, Expr(1)), ir::LT::Make(i, Expr(15)));
+  Expr value = ir::Select::Make(cond, ir::Load::Make(ir::Tensor(A), {Expr(i)}), Expr(0.f));
+  Expr body  = ir::Block::Make({ir::Store::Make(ir::Tensor(B), value, {Expr(i)})});
+  Expr expr  = ir::For::Make(i, Expr(0), Expr(16), ir::ForType::Serial, ir::DeviceAPI::Host, body);
+
+  PartitionLoops(&expr);
+  Simplify(&expr);
+  LOG(INFO) << "partitioned:\n" << expr;
+
+  auto forloops = GetForloops(expr);
+  ASSERT_EQ(forloops.size(), 3UL);
+  ASSERT_EQ(forloops[0]->extent.as_int32(), 1);
+  ASSERT_EQ(forloops[1]->extent.as_int32(), 14);
+  ASSERT_EQ(forloops[2]->extent.as_int32(), 1);
+  // The steady state is free of the condition.
+  ASSERT_TRUE(ir::CollectIRNodes(forloops[1]->body, [](const Expr* x) { return x->As<ir::Select>(); }).empty());
+}
+
+TEST(PartitionLoops, split_tail) {
+  Placeholder<float> A("A", std::vector<int>{{100}});
+  Placeholder<float> B("B", std::vector<int>{{100}});
+  Var io("io"), ii("ii");
+
+  // The tail of the forloop over 100 elements split by 16.
+  Expr index = io * 16 + ii;
+  Expr body  = ir::Block::Make({ir::Store::Make(ir::Tensor(B), ir::Load::Make(ir::Tensor(A), {index}), {index})});
+  Expr inner = ir::For::Make(
+      ii, Expr(0), ir::Min::Make(Expr(16), Expr(100) - io * 16), ir::ForType::Serial, ir::DeviceAPI::Host, body);
+  Expr expr = ir::For::Make(io, Expr(0), Expr(7), ir::ForType::Serial, ir::DeviceAPI::Host, ir::Block::Make({inner}));
+
+  PartitionLoops(&expr);
+  Simplify(&expr);
+  LOG(INFO) << "partitioned:\n" << expr;
+
+  auto forloops = GetForloops(expr);
+  ASSERT_EQ(forloops.size(), 2UL);
+  ASSERT_EQ(forloops[0]->extent.as_int32(), 6);
+  ASSERT_EQ(forloops[1]->extent.as_int32(), 1);
+  auto steady_inner = GetForloops(forloops[0]->body);
+  ASSERT_EQ(steady_inner.size(), 1UL);
+  ASSERT_EQ(steady_inner[0]->extent.as_int32(), 16);
+}
+
+TEST(PartitionLoops, lower) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_partition_loops = true;
+
+  Expr M(8), N(32);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N},
+      [&](Expr i, Expr j) {
+        return ir::Select::Make(i >= Expr(1) && j >= Expr(2) && j < Expr(30), A(i, j) * 2.f, Expr(0.f));
+      },
+      "B");
+  auto stages = CreateStages({B});
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  auto fn = Lower("fn", stages, {A, B}, {}, {}, &builder);
+  LOG(INFO) << "fn:\n" << fn;
+
+  // The loop over j is partitioned to 2, 28 and 2 iterations, the steady state of 28 stores A * 2 without the Select.
+  auto steady_loops = ir::CollectIRNodes(fn->body, [](const Expr* x) {
+    auto* forloop = x->As<ir::For>();
+    return forloop && forloop->extent.is_constant() && forloop->extent.as_int32() == 28 &&
+           ir::CollectIRNodes(forloop->body, [](const Expr* n) { return n->As<ir::Select>(); }).empty();
+  });
+  ASSERT_FALSE(steady_loops.empty());
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build(), false);
+  auto* fn_handler = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn"));
+
+  auto A_buf    = common::BufferBuilder(Float(32), {8, 32}).set_random().Build();
+  auto B_buf    = common::BufferBuilder(Float(32), {8, 32}).set_zero().Build();
+  auto arg_pack = common::ArgsBuilder().Add(A_buf).Add(B_buf).Build();
+  fn_handler(arg_pack.data(), arg_pack.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 32; j++) {
+      float expected = i >= 1 && j >= 2 && j < 30 ? A_data[i * 32 + j] * 2.f : 0.f;
+      ASSERT_NEAR(B_data[i * 32 + j], expected, 1e-5);
+    }
+  }
+}
+
+}  // namespace optim
+}  // namespace cinn
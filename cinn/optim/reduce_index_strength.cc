@@ -0,0 +1,251 @@
+#include "cinn/optim/reduce_index_strength.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_compare.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/ir_operators.h"
+
+DEFINE_bool(cinn_reduce_index_strength,
+            false,
+            "Whether to hoist the loop invariant index arithmetic and reduce the division by constants on CPU");
+
+namespace cinn {
+namespace optim {
+
+namespace {
+
+//! A term of a sum, subtracted if `negative`.
+struct Term {
+  Expr x;
+  bool negative;
+};
+
+void FlattenSum(const Expr& x, bool negative, std::vector<Term>* terms) {
+  if (auto* op = x.As<ir::Add>()) {
+    FlattenSum(op->a(), negative, terms);
+    FlattenSum(op->b(), negative, terms);
+  } else if (auto* op = x.As<ir::Sub>()) {
+    FlattenSum(op->a(), negative, terms);
+    FlattenSum(op->b(), !negative, terms);
+  } else {
+    terms->push_back(Term{x, negative});
+  }
+}
+
+Expr MakeSum(const std::vector<Term>& terms) {
+  Expr sum;
+  for (auto& term : terms) {
+    if (!sum.defined()) {
+      sum = term.negative ? ir::Minus::Make(term.x) : term.x;
+    } else {
+      sum = term.negative ? ir::Sub::Make(sum, term.x) : ir::Add::Make(sum, term.x);
+    }
+  }
+  return sum;
+}
+
+/**
+ * Split the indices in a forloop body into the terms invariant to the forloop and the others, the invariant parts are
+ * replaced by the variables of the `Let`s to insert before the forloop.
+ */
+class InvariantExtractor : public ir::IRMutator<> {
+ public:
+  explicit InvariantExtractor(const ir::For* forloop) {
+    bound_vars_.insert(forloop->loop_var->name);
+    auto inner = ir::CollectIRNodes(forloop->body, [](const Expr* x) { return x->As<ir::For>() || x->As<ir::Let>(); });
+    for (auto& x : inner) {
+      if (auto* op = x.As<ir::For>()) bound_vars_.insert(op->loop_var->name);
+      if (auto* op = x.As<ir::Let>()) {
+        if (op->symbol.As<ir::_Var_>()) bound_vars_.insert(op->symbol.As<ir::_Var_>()->name);
+      }
+    }
+  }
+
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+  const std::vector<Expr>& lets() const { return lets_; }
+
+ private:
+  void Visit(const ir::Load* op, Expr* expr) override {
+    auto* node = expr->As<ir::Load>();
+    for (auto& index : node->indices) Extract(&index);
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Store* op, Expr* expr) override {
+    auto* node = expr->As<ir::Store>();
+    for (auto& index : node->indices) Extract(&index);
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Let* op, Expr* expr) override {
+    auto* node = expr->As<ir::Let>();
+    if (node->body.defined()) Extract(&node->body);
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Extract(Expr* index) {
+    if (auto* ramp = index->As<ir::Ramp>()) {
+      Extract(&ramp->base);
+      return;
+    }
+    if (index->type() != Int(32)) return;
+
+    std::vector<Term> terms, invariant, variant;
+    FlattenSum(*index, false, &terms);
+    for (auto& term : terms) (IsInvariant(term.x) ? invariant : variant).push_back(term);
+    if (invariant.empty()) return;
+    // Hoisting a variable or a constant saves nothing.
+    Expr hoisted = MakeSum(invariant);
+    if (hoisted.As<ir::_Var_>() || hoisted.As<ir::IntImm>()) return;
+
+    variant.insert(variant.begin(), Term{Expr(Hoist(hoisted)), false});
+    *index = MakeSum(variant);
+  }
+
+  bool IsInvariant(const Expr& x) const {
+    if (x.type() != Int(32)) return false;
+    // The divisions by variables might be guarded against 0 in the forloop.
+    return ir::CollectIRNodes(x, [&](const Expr* n) {
+             if (n->As<ir::Load>() || n->As<ir::Call>()) return true;
+             if (auto* op = n->As<ir::Div>()) return !op->b().As<ir::IntImm>() || op->b().as_int32() == 0;
+             if (auto* op = n->As<ir::Mod>()) return !op->b().As<ir::IntImm>() || op->b().as_int32() == 0;
+             auto* v = n->As<ir::_Var_>();
+             return v && bound_vars_.count(v->name);
+           })
+        .empty();
+  }
+
+  Var Hoist(const Expr& x) {
+    auto it = hoisted_.find(x);
+    if (it != hoisted_.end()) return it->second;
+    Var var(Context::Global().NewName("idx"), Int(32));
+    lets_.push_back(ir::Let::Make(var, x));
+    hoisted_.emplace(x, var);
+    return var;
+  }
+
+  std::set<std::string> bound_vars_;
+  std::unordered_map<Expr, Var, ir::ExprStructuralHash, ir::ExprStructuralEqual> hoisted_;
+  std::vector<Expr> lets_;
+};
+
+struct IndexHoister : public ir::IRMutator<> {
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::For* op, Expr* expr) override {
+    // Hoist out of the inner forloops first, the `Let`s inserted are hoisted further out of this one.
+    auto* node = expr->As<ir::For>();
+    ir::IRMutator<>::Visit(&node->body, &node->body);
+
+    InvariantExtractor extractor(op);
+    extractor(&node->body);
+    if (extractor.lets().empty()) return;
+    auto stmts = extractor.lets();
+    stmts.push_back(*expr);
+    *expr = ir::Block::Make(stmts);
+  }
+};
+
+/**
+ * Compute the divisions and the modulos of the non-negative int32 dividends by positive constants in the unsigned
+ * arithmetic.
+ */
+class DivModReducer : public ir::IRMutator<> {
+ public:
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::For* op, Expr* expr) override {
+    auto* node = expr->As<ir::For>();
+    ir::IRMutator<>::Visit(&node->min, &node->min);
+    ir::IRMutator<>::Visit(&node->extent, &node->extent);
+    auto& name    = op->loop_var->name;
+    auto it       = non_negative_vars_.find(name);
+    bool shadowed = it != non_negative_vars_.end();
+    bool value    = shadowed && it->second;
+
+    non_negative_vars_[name] = op->min.As<ir::IntImm>() && op->min.as_int32() >= 0;
+    ir::IRMutator<>::Visit(&node->body, &node->body);
+    if (shadowed) {
+      non_negative_vars_[name] = value;
+    } else {
+      non_negative_vars_.erase(name);
+    }
+  }
+
+  void Visit(const ir::Let* op, Expr* expr) override {
+    auto* node = expr->As<ir::Let>();
+    if (node->body.defined() && node->symbol.As<ir::_Var_>()) {
+      non_negative_vars_[node->symbol.As<ir::_Var_>()->name] = IsNonNegative(node->body);
+    }
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
+  void Visit(const ir::Div* op, Expr* expr) override {
+    ir::IRMutator<>::Visit(op, expr);
+    Reduce(expr);
+  }
+
+  void Visit(const ir::Mod* op, Expr* expr) override {
+    ir::IRMutator<>::Visit(op, expr);
+    Reduce(expr);
+  }
+
+  void Reduce(Expr* expr) {
+    if (expr->type() != Int(32)) return;
+    auto* div = expr->As<ir::Div>();
+    auto* mod = expr->As<ir::Mod>();
+    Expr a    = div ? div->a() : mod->a();
+    auto* b   = (div ? div->b() : mod->b()).As<ir::IntImm>();
+    if (!b || b->value <= 1 || !IsNonNegative(a)) return;
+
+    Expr ua = ir::Cast::Make(UInt(32), a);
+    Expr ub(static_cast<uint32_t>(b->value));
+    *expr = ir::Cast::Make(Int(32), div ? ir::Div::Make(ua, ub) : ir::Mod::Make(ua, ub));
+  }
+
+  bool IsNonNegative(const Expr& x) const {
+    if (auto* op = x.As<ir::IntImm>()) return op->value >= 0;
+    if (auto* op = x.As<ir::_Var_>()) {
+      auto it = non_negative_vars_.find(op->name);
+      return it != non_negative_vars_.end() && it->second;
+    }
+    if (auto* op = x.As<ir::Add>()) return IsNonNegative(op->a()) && IsNonNegative(op->b());
+    if (auto* op = x.As<ir::Mul>()) return IsNonNegative(op->a()) && IsNonNegative(op->b());
+    if (auto* op = x.As<ir::Div>()) return IsNonNegative(op->a()) && IsNonNegative(op->b());
+    if (auto* op = x.As<ir::Mod>()) return IsNonNegative(op->a()) && IsNonNegative(op->b());
+    if (auto* op = x.As<ir::Min>()) return IsNonNegative(op->a()) && IsNonNegative(op->b());
+    if (auto* op = x.As<ir::Max>()) return IsNonNegative(op->a()) || IsNonNegative(op->b());
+    // The results of the reduced divisions are no more than the non-negative int32 dividends.
+    if (auto* op = x.As<ir::Cast>()) {
+      auto* div = op->v().As<ir::Div>();
+      auto* mod = op->v().As<ir::Mod>();
+      if (op->v().type() != UInt(32) || (!div && !mod)) return false;
+      auto* b = (div ? div->b() : mod->b()).As<ir::UIntImm>();
+      return b && b->value > 1;
+    }
+    return false;
+  }
+
+  //! Whether the int32 variables in scope are known non-negative.
+  std::map<std::string, bool> non_negative_vars_;
+};
+
+}  // namespace
+
+void ReduceIndexStrength(Expr* expr) {
+  IndexHoister()(expr);
+  DivModReducer()(expr);
+}
+
+}  // namespace optim
+}  // namespace cinn
@@ -0,0 +1,44 @@
+#pragma once
+#include <gflags/gflags.h>
+
+#include "cinn/ir/ir.h"
+
+DECLARE_bool(cinn_reduce_index_strength);
+
+namespace cinn {
+namespace optim {
+
+/**
+ * Reduce the cost of the index arithmetic in the forloops.
+ *
+ * - The terms of an index invariant to a forloop are hoisted out of it by a `Let`, the structurally equal ones share a
+ *   variable. The index left is a loop invariant base plus the terms of the loop variables, which the backend compilers
+ *   turn into incremental pointer bumps, e.g.
+ *
+ * \code
+ * for (i, 0, 32) {
+ *   for (j, 0, 64) {
+ *     B[((i * 512) + (k * 8) + j)] = A[((i * 512) + (k * 8) + j)]
+ *   }
+ * }
+ * \endcode
+ *
+ * is transformed to
+ *
+ * \code
+ * int32 idx_1 = (k * 8)
+ * for (i, 0, 32) {
+ *   int32 idx_0 = (idx_1 + (i * 512))
+ *   for (j, 0, 64) {
+ *     B[(idx_0 + j)] = A[(idx_0 + j)]
+ *   }
+ * }
+ * \endcode
+ *
+ * - The division and the modulo of a non-negative index by a constant are computed in the unsigned arithmetic, which
+ *   the backends lower to shifts, masks or multiply-shift sequences without the fixups for the negative dividends.
+ */
+void ReduceIndexStrength(Expr* expr);
+
+}  // namespace optim
+}  // namespace cinn
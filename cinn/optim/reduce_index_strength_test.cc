@@ -0,0 +1,121 @@
+#include "cinn/optim/reduce_index_strength.h"
+
+#include <gtest/gtest.h>
+
+#include "cinn/backends/llvm/simple_jit.h"
+#include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace optim {
+
+TEST(ReduceIndexStrength, hoist) {
+  Placeholder<float> A("A", std::vector<int>{{32 * 512}});
+  Placeholder<float> B("B", std::vector<int>{{32 * 512}});
+  Var i("i"), j("j"), k("k");
+
+  Expr index = i * 512 + k * 8 + j;
+  Expr body  = ir::Store::Make(ir::Tensor(B), ir::Load::Make(ir::Tensor(A), {index}), {index});
+  Expr inner = ir::For::Make(j, Expr(0), Expr(64), ir::ForType::Serial, ir::DeviceAPI::Host, ir::Block::Make({body}));
+  Expr expr  = ir::For::Make(i, Expr(0), Expr(32), ir::ForType::Serial, ir::DeviceAPI::Host, ir::Block::Make({inner}));
+
+  ReduceIndexStrength(&expr);
+  LOG(INFO) << "reduced:\n" << expr;
+
+  // `k * 8` is hoisted out of both the forloops, `i * 512` out of the inner one.
+  auto lets = ir::CollectIRNodes(expr, [](const Expr* x) { return x->As<ir::Let>(); });
+  ASSERT_EQ(lets.size(), 2UL);
+  auto* block = expr.As<ir::Block>();
+  ASSERT_TRUE(block);
+  ASSERT_EQ(block->stmts.size(), 2UL);
+  ASSERT_TRUE(block->stmts[0].As<ir::Let>());
+  ASSERT_TRUE(block->stmts[1].As<ir::For>());
+
+  auto stores = ir::CollectIRNodes(expr, [](const Expr* x) { return x->As<ir::Store>(); });
+  ASSERT_EQ(stores.size(), 1UL);
+  auto* store = stores.begin()->As<ir::Store>();
+  // The load and the store share the hoisted base.
+  ASSERT_TRUE(ir::CollectIRNodes(store->indices[0], [](const Expr* x) { return x->As<ir::Mul>(); }).empty());
+  auto* load = store->value.As<ir::Load>();
+  ASSERT_EQ(utils::GetStreamCnt(load->indices[0]), utils::GetStreamCnt(store->indices[0]));
+}
+
+TEST(ReduceIndexStrength, div_mod) {
+  Placeholder<float> A("A", std::vector<int>{{64}});
+  Placeholder<float> B("B", std::vector<int>{{64}});
+  Var i("i");
+
+  Expr index    = i / 4 + (i % 4) * 16;
+  Expr shifted  = (i - 1) / 2;
+  Expr value    = ir::Load::Make(ir::Tensor(A), {index}) + ir::Load::Make(ir::Tensor(A), {shifted});
+  Expr body     = ir::Store::Make(ir::Tensor(B), value, {Expr(i)});
+  Expr expr     = ir::For::Make(i, Expr(0), Expr(64), ir::ForType::Serial, ir::DeviceAPI::Host, body);
+  Expr negative = ir::For::Make(i, Expr(-1), Expr(64), ir::ForType::Serial, ir::DeviceAPI::Host, IRCopy(body));
+
+  ReduceIndexStrength(&expr);
+  LOG(INFO) << "reduced:\n" << expr;
+  auto int_divs = [](Expr x) {
+    return ir::CollectIRNodes(x, [](const Expr* n) {
+             return (n->As<ir::Div>() || n->As<ir::Mod>()) && n->type() == Int(32);
+           })
+        .size();
+  };
+  // `(i - 1) / 2` might be negative.
+  ASSERT_EQ(int_divs(expr), 1UL);
+
+  // The loop variable might be negative.
+  ReduceIndexStrength(&negative);
+  ASSERT_EQ(int_divs(negative), 3UL);
+}
+
+TEST(ReduceIndexStrength, lower) {
+  gflags::FlagSaver flag_saver;
+  FLAGS_cinn_reduce_index_strength = true;
+
+  Expr M(8), N(30);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+  auto C = Compute(
+      {M, N}, [&](Expr i, Expr j) { return A(i, j) + B(i, j); }, "C");
+  auto stages = CreateStages({C});
+  stages[C]->Fuse(0, 1);
+  stages[C]->Split(0, 16);
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  auto fn = Lower("fn", stages, {A, B, C}, {}, {}, &builder);
+  LOG(INFO) << "fn:\n" << fn;
+
+  // The fused index is split back by the divisions and the modulos by 30, the loop variables are non-negative so all of
+  // them are unsigned.
+  auto div_mods = [&](Type type) {
+    return ir::CollectIRNodes(fn->body, [&](const Expr* x) {
+             return (x->As<ir::Div>() || x->As<ir::Mod>()) && x->type() == type;
+           })
+        .size();
+  };
+  ASSERT_EQ(div_mods(Int(32)), 0UL);
+  ASSERT_GT(div_mods(UInt(32)), 0UL);
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build(), false);
+  auto* fn_handler = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn"));
+
+  auto A_buf    = common::BufferBuilder(Float(32), {8, 30}).set_random().Build();
+  auto B_buf    = common::BufferBuilder(Float(32), {8, 30}).set_random().Build();
+  auto C_buf    = common::BufferBuilder(Float(32), {8, 30}).set_zero().Build();
+  auto arg_pack = common::ArgsBuilder().Add(A_buf).Add(B_buf).Add(C_buf).Build();
+  fn_handler(arg_pack.data(), arg_pack.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  auto* C_data = reinterpret_cast<float*>(C_buf->memory);
+  for (int i = 0; i < 8 * 30; i++) {
+    ASSERT_NEAR(A_data[i] + B_data[i], C_data[i], 1e-5);
+  }
+}
+
+}  // namespace optim
+}  // namespace cinn
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <map>
+#include <set>
 #include <string>
 
 #include "cinn/common/ir_util.h"
@@ -11,6 +12,10 @@
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/utils/functional.h"
 
+DEFINE_bool(cinn_llvm_vector_math,
+            true,
+            "Whether to emit the SIMD math library inline for the vectorized exp/log/tanh/erf calls");
+
 namespace cinn {
 namespace optim {
 using namespace ir;  // NOLINT
@@ -18,6 +23,23 @@ using common::make_const;
 using common::make_one;
 using common::make_zero;
 
+//! The elementwise math calls that lower to LLVM intrinsics and accept vector arguments.
+static const std::set<std::string> kVectorizableIntrinsicCalls{
+    {"exp", "log", "tanh", "sqrt", "floor", "ceil", "round", "trunc", "fabs"}};
+
+//! The math functions the vector math library of the LLVM backend emits inline.
+static const std::set<std::string> kVectorMathCalls{{"exp", "log", "tanh", "erf"}};
+
+bool IsVectorMathFunction(const std::string &name) {
+  return FLAGS_cinn_llvm_vector_math && kVectorMathCalls.count(name);
+}
+
+bool IsVectorMathCall(const ir::Call *op) {
+  if (!IsVectorMathFunction(op->name)) return false;
+  if (op->read_args.size() != 1 || !op->write_args.empty()) return false;
+  return op->type().lanes() > 1 && op->type().ElementOf() == Float(32);
+}
+
 //! Widen an expression to the given number of lanes.
 Expr Widen(Expr e, int lanes) {
   if (e.type().lanes() == lanes) return e;
@@ -47,8 +69,12 @@ class Vectorizer : public IRMutator<Expr *> {
   //! A suffix to attach to widened variables.
   std::string widen_suffix;
 
+  //! Whether to widen the math calls, only the LLVM backend of X86 computes them lane-wise.
+  bool widen_calls_{false};
+
  public:
-  Vectorizer(const Var &var, int lanes) : var(var), lanes_(lanes) {
+  Vectorizer(const Var &var, int lanes, const Target &target = Target())
+      : var(var), lanes_(lanes), widen_calls_(target.arch == Target::Arch::X86) {
     // the identity ramp.
     ramp_ = Ramp::Make(make_zero(), make_one(), lanes_);
   }
@@ -166,7 +192,33 @@ class Vectorizer : public IRMutator<Expr *> {
     *expr = Store::Make(node->tensor, node->value, new_indices);
   }
 
-  void Visit(const Call *op, Expr *expr) override { LOG(ERROR) << "Ignore widen Call node"; }
+  void Visit(const Call *op, Expr *expr) override {
+    auto *node = expr->As<Call>();
+    if (!IsVectorizableCall(node)) {
+      LOG(ERROR) << "Ignore widen Call node";
+      return;
+    }
+
+    int lanes = 1;
+    for (auto &arg : node->read_args) {
+      Visit(&arg);
+      lanes = std::max(lanes, arg.type().lanes());
+    }
+    if (lanes == 1) return;
+
+    for (auto &arg : node->read_args) {
+      arg = Widen(arg, lanes);
+    }
+    node->set_type(node->type().with_lanes(lanes));
+  }
+
+  //! Tell whether a call is an elementwise math function that the backends can compute lane-wise.
+  bool IsVectorizableCall(const Call *op) {
+    if (!widen_calls_) return false;
+    if (!op->write_args.empty() || op->read_args.size() != 1) return false;
+    if (op->type() != Float(32)) return false;
+    return kVectorizableIntrinsicCalls.count(op->name) || IsVectorMathFunction(op->name);
+  }
 
   void Visit(const Let *op, Expr *expr) override {
     auto *node = expr->As<Let>();
@@ -311,7 +363,7 @@ struct VectorizeLoops_ : public IRMutator<Expr *> {
       VLOG(2) << "Vectorizing " << new_forloop->loop_var << " extent " << extent;
       VLOG(2) << "body:\n" << node->body;
 
-      Vectorizer(new_forloop->loop_var, extent).Visit(&new_forloop->body);
+      Vectorizer(new_forloop->loop_var, extent, target).Visit(&new_forloop->body);
 
       VLOG(2) << "after vectorize body:\n" << node->body;
 
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <gflags/gflags.h>
+
+#include <string>
+
 #include "cinn/ir/ir_mutator.h"
 
+DECLARE_bool(cinn_llvm_vector_math);
+
 namespace cinn {
 namespace optim {
 
@@ -12,6 +18,15 @@ namespace optim {
  */
 void VectorizeLoops(Expr* expr, const Target& target);
 
+//! Tell whether the vector math library of the LLVM backend is enabled and provides the function called \p name.
+bool IsVectorMathFunction(const std::string& name);
+
+/**
+ * Tell whether the call \p op should be emitted inline by the vector math library of the LLVM backend instead of being
+ * lowered to the scalar libm calls. Only the fp32 calls widened by the vectorizer (lanes > 1) are taken.
+ */
+bool IsVectorMathCall(const ir::Call* op);
+
 namespace detail {
 
 //! Vecorize the \p expr by making the \p var has \p lanes lanes.
@@ -7,6 +7,7 @@
 #include "cinn/cinn.h"
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/optimize.h"
@@ -216,5 +217,33 @@ TEST(Vectorize, single_for) {
   LOG(INFO) << "Forloop\n" << forloop;
 }
 
+TEST(Vectorize, math_call) {
+  Placeholder<float> A("A", std::vector<int>{{16}});
+  Placeholder<float> C("C", std::vector<int>{{16}});
+
+  Var loop_var("k0");
+
+  Expr body = Store::Make(ir::Tensor(C), lang::Exp(ir::Load::Make(ir::Tensor(A), {Expr(loop_var)})), {Expr(loop_var)});
+  body      = ir::Block::Make({body});
+
+  VectorizeInfo vectorize_info(0, 16);
+  auto forloop = ir::For::Make(loop_var,
+                               common::make_const(0),
+                               common::make_const(16),
+                               ir::ForType::Vectorized,
+                               ir::DeviceAPI::UNK,
+                               body,
+                               vectorize_info);
+
+  VectorizeLoops(&forloop, common::DefaultHostTarget());
+
+  // The call is widened to take the vectorized load.
+  auto calls = ir::CollectIRNodes(forloop, [](const Expr *x) { return x->As<ir::Call>(); });
+  ASSERT_EQ(calls.size(), 1UL);
+  auto *call = calls.begin()->As<ir::Call>();
+  EXPECT_EQ(call->type(), Float(32).with_lanes(16));
+  EXPECT_EQ(call->read_args.front().type().lanes(), 16);
+}
+
 }  // namespace optim
 }  // namespace cinn
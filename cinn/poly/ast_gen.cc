@@ -1,14 +1,81 @@
 #include "cinn/poly/ast_gen.h"
 
+#include <mutex>  //NOLINT
+#include <sstream>
+#include <unordered_map>
 #include <utility>
 
 #include <llvm/Support/FormatVariadic.h>
 #include "cinn/common/common.h"
 #include "cinn/ir/ir.h"
+#include "cinn/utils/profiler.h"
+
+DEFINE_bool(cinn_isl_ast_cache, true, "Whether to share the isl ASTs built for the schedule groups of the same shape");
 
 namespace cinn {
 namespace poly {
 
+namespace {
+
+//! An isl AST built, the statements are named by the positions of their stages.
+struct AstCacheEntry {
+  isl::ast_node ast;
+  //! The position of a stage -> { axis -> isl_ast }
+  std::map<int, std::map<std::string, isl::ast_expr>> indice_maps;
+};
+
+/**
+ * The isl ASTs built by the global isl context, keyed by the canonical form of the context, build options, iterator
+ * names and the domains, transforms and schedules of the stages.
+ */
+class AstCache {
+ public:
+  static AstCache& Global() {
+    // Never destroyed, the isl objects should not outlive the isl context.
+    static auto* x = new AstCache;
+    return *x;
+  }
+
+  bool Lookup(const std::string& key, AstCacheEntry* entry) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return false;
+    *entry = it->second;
+    return true;
+  }
+
+  void Insert(const std::string& key, AstCacheEntry entry) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (entries_.size() >= kMaxEntries) entries_.clear();
+    entries_.emplace(key, std::move(entry));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4096;
+
+  std::mutex mu_;
+  std::unordered_map<std::string, AstCacheEntry> entries_;
+};
+
+//! Rename the tuples of \p x by \p names.
+isl::set RenameTuples(const isl::set& x, const std::map<std::string, std::string>& names) {
+  const char* name = isl_set_get_tuple_name(x.get());
+  if (!name || !names.count(name)) return x;
+  return isl::manage(isl_set_set_tuple_name(x.copy(), names.at(name).c_str()));
+}
+isl::map RenameTuples(const isl::map& x, const std::map<std::string, std::string>& names) {
+  isl::map res = x;
+  for (auto type : {isl_dim_in, isl_dim_out}) {
+    const char* name = isl_map_get_tuple_name(res.get(), type);
+    if (name && names.count(name)) {
+      res = isl::manage(isl_map_set_tuple_name(res.release(), type, names.at(name).c_str()));
+    }
+  }
+  return res;
+}
+
+}  // namespace
+
 struct AstGen::Impl {
   Impl(const isl::set& context, const poly::ScheduleGroup& schedule_group)
       : context_(context), schedule_group_(schedule_group) {}
@@ -41,6 +108,8 @@ struct AstGen::Impl {
   std::vector<std::string> iterator_names_;
   //! tuple name -> { axis -> isl_ast }
   std::map<std::string, std::map<std::string, isl::ast_expr>> transformed_indice_map_;
+  //! tuple name -> the statement name in the AST.
+  std::map<std::string, std::string> statement_names_;
   isl::union_map build_options_;
 
   friend class AstGen;
@@ -115,13 +184,60 @@ isl::union_set TransIdentityExtentToContextId(isl::union_set set) {
 isl::ast_node AstGen::Build() {
   // Collect schedule from scheduler.
   auto schedule_map = CollectScheduleMapFromGroup(impl_->schedule_group_);
-  std::vector<isl::map> maps;
-  for (auto& stage : impl_->stages_) {
+
+  // Name the statements by the positions of the stages, so the groups of the same shape build the same AST.
+  auto& stages = impl_->stages_;
+  impl_->statement_names_.clear();
+  std::map<std::string, int> statement_positions;
+  for (int i = 0; i < stages.size(); i++) {
+    std::string name                        = kIslStatementPrefix + std::to_string(i);
+    impl_->statement_names_[stages[i]->id()] = name;
+    statement_positions[name]               = i;
+  }
+  std::vector<isl::set> domains;
+  std::vector<isl::map> transforms, maps;
+  for (auto& stage : stages) {
     auto it = schedule_map.find(stage->id());
     CHECK(it != std::end(schedule_map)) << "stage " << stage->id() << " not found in the map";
-    maps.push_back(it->second);
+    domains.push_back(RenameTuples(stage->domain(), impl_->statement_names_));
+    transforms.push_back(RenameTuples(stage->transform(), impl_->statement_names_));
+    maps.push_back(RenameTuples(it->second, impl_->statement_names_));
   }
+
+  // Set iterators names for readable code.
+  auto iterator_names =
+      impl_->iterator_names_.empty() ? impl_->schedule_group_.dimension_names : impl_->iterator_names_;
+  iterator_names = SchedulerBase::WrapIteratorNames(iterator_names);
+
+  // The isl objects of the other contexts might be freed with their contexts, they are not cached.
+  std::string cache_key;
+  if (FLAGS_cinn_isl_ast_cache && ctx().get() == Context::Global().isl_ctx().get()) {
+    std::stringstream os;
+    os << impl_->context_ << "|";
+    if (!impl_->build_options_.is_null()) os << impl_->build_options_;
+    os << "|" << utils::Join(iterator_names, ",");
+    for (int i = 0; i < stages.size(); i++) {
+      os << "|" << domains[i] << "|" << transforms[i] << "|" << maps[i];
+    }
+    cache_key = os.str();
+
+    AstCacheEntry entry;
+    if (AstCache::Global().Lookup(cache_key, &entry)) {
+      if (utils::CompileProfiler::Global().enabled()) {
+        utils::CompileProfiler::Global().AddCount("isl.ast_cache_hits", 1);
+      }
+      for (auto& [pos, indice_map] : entry.indice_maps) {
+        impl_->transformed_indice_map_[stages[pos]->id()] = indice_map;
+      }
+      return entry.ast;
+    }
+  }
+
   auto schedule = isl_maps_to_union_map(maps);
+  if (utils::CompileProfiler::Global().enabled()) {
+    utils::CompileProfiler::Global().AddCount("isl.ast_builds", 1);
+    utils::CompileProfiler::Global().AddCount("isl.ast_build_statements", maps.size());
+  }
 
   // Build it.
   auto ast_build = isl::ast_build::from_context(impl_->context_);
@@ -129,10 +245,6 @@ isl::ast_node AstGen::Build() {
   if (!impl_->build_options_.is_null())
     ast_build = isl::manage(isl_ast_build_set_options(ast_build.release(), impl_->build_options_.release()));
 
-  // Set iterators names for readable code.
-  auto iterator_names =
-      impl_->iterator_names_.empty() ? impl_->schedule_group_.dimension_names : impl_->iterator_names_;
-  iterator_names   = SchedulerBase::WrapIteratorNames(iterator_names);
   isl::id_list ids = isl::manage(isl_id_list_alloc(ctx().get(), iterator_names.size()));
   for (int i = 0; i < iterator_names.size(); i++) {
     ids = isl::manage(isl_id_list_add(ids.release(), isl_id_alloc(ctx().get(), iterator_names[i].c_str(), nullptr)));
@@ -140,33 +252,36 @@ isl::ast_node AstGen::Build() {
   ast_build = isl::manage(isl_ast_build_set_iterators(ast_build.release(), ids.release()));
 
   // collect iterator map
-  auto get_domain_by_name = [this](const std::string& name) -> isl::set {
-    auto ele_it = std::find_if(
-        impl_->stages_.begin(), impl_->stages_.end(), [&name](const Shared<Stage>& ele) { return ele->id() == name; });
-    CHECK(ele_it != std::end(impl_->stages_));
-    return (*ele_it)->domain();
-  };
-
+  AstCacheEntry entry;
   auto collect = [&](isl::ast_node node, isl::ast_build build) -> isl::ast_node {
     auto tuple_name = detail::GetTupleName(node.get());
-    auto indice_map = impl_->ExtractIslTransformedIndiceMap(get_domain_by_name(tuple_name), build.get());
-    impl_->transformed_indice_map_[tuple_name] = indice_map;
+    auto it         = statement_positions.find(tuple_name);
+    CHECK(it != statement_positions.end()) << "statement " << tuple_name << " not found";
+    auto indice_map = impl_->ExtractIslTransformedIndiceMap(domains[it->second], build.get());
+    impl_->transformed_indice_map_[stages[it->second]->id()] = indice_map;
+    entry.indice_maps[it->second]                            = indice_map;
     return node;
   };
 
   ast_build = ast_build.set_at_each_domain(collect);
 
-  isl::union_set new_domain = TransIdentityExtentToContextId(impl_->domain());
+  isl::union_set domain     = isl_sets_to_union_set(domains);
+  isl::union_set new_domain = TransIdentityExtentToContextId(domain);
 
-  isl::union_map transformed_schedule = impl_->transform().apply_range(schedule);
+  isl::union_map transformed_schedule = isl_maps_to_union_map(transforms).apply_range(schedule);
   VLOG(4) << "transformed_schedule: " << transformed_schedule;
   auto schedule_domain = transformed_schedule.intersect_domain(new_domain);
-  VLOG(4) << "domain: " << impl_->domain();
-  VLOG(4) << "transform schedule " << impl_->stages()[0]->transform();
+  VLOG(4) << "domain: " << domain;
+  VLOG(4) << "transform schedule " << transforms[0];
   VLOG(4) << "schedule: " << schedule;
   VLOG(4) << "schedule_domain: " << schedule_domain;
   auto ast = ast_build.node_from_schedule_map(schedule_domain);
   VLOG(2) << "AST:\n" << isl_ast_node_to_C_str(ast.get());
+
+  if (!cache_key.empty()) {
+    entry.ast = ast;
+    AstCache::Global().Insert(cache_key, std::move(entry));
+  }
   return ast;
 }
 
@@ -504,6 +619,12 @@ AstGen::AstGen(const isl::set& context, const std::vector<Stage*>& stages, const
 void AstGen::SetBuildOptions(const isl::union_map& options) { impl_->build_options_ = options; }
 bool AstGen::ContainsStatement(const std::string& name) const { return impl_->transformed_indice_map_.count(name); }
 
+std::string AstGen::StatementName(const std::string& tuple_name) const {
+  auto it = impl_->statement_names_.find(tuple_name);
+  CHECK(it != impl_->statement_names_.end()) << "no statement " << tuple_name;
+  return it->second;
+}
+
 AstGen::~AstGen() {}
 
 }  // namespace poly
@@ -3,6 +3,7 @@
  * schedule.
  */
 #pragma once
+#include <gflags/gflags.h>
 #include <isl/cpp.h>
 
 #include <map>
@@ -16,13 +17,20 @@
 #include "cinn/poly/stage.h"
 #include "cinn/utils/functional.h"
 
+DECLARE_bool(cinn_isl_ast_cache);
+
 namespace cinn {
 namespace poly {
 
 static const char* kIslParamConstPrefix = "_const_";
+static const char* kIslStatementPrefix  = "_stmt_";
 
 /**
  * Generate IR from polyhedral schedule.
+ *
+ * The statements in the AST built are named by the positions of their stages, get the name of a stage's statement by
+ * `StatementName`. So the schedule groups of the same shape up to the tensor names build the same AST, and the ASTs
+ * built by the global isl context are cached and shared by such groups.
  */
 class AstGen {
  public:
@@ -47,6 +55,9 @@ class AstGen {
 
   bool ContainsStatement(const std::string& name) const;
 
+  //! Get the name of the statement of the stage \p tuple_name in the AST built.
+  std::string StatementName(const std::string& tuple_name) const;
+
   void SetBuildOptions(const isl::union_map& options);
 
  private:
@@ -0,0 +1,255 @@
+#include "cinn/poly/dependence.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/poly/isl_utils.h"
+#include "cinn/utils/string.h"
+
+DEFINE_bool(cinn_auto_parallel,
+            true,
+            "Whether to parallelize the outermost loops proven to carry no dependence by default on CPU");
+DEFINE_bool(cinn_auto_vectorize,
+            false,
+            "Whether to vectorize the innermost loops proven to carry no dependence by default on CPU");
+DEFINE_bool(cinn_verify_parallel, false, "Whether to check the loops marked parallel carry no dependence");
+
+namespace cinn {
+namespace poly {
+
+namespace {
+
+/**
+ * Print the affine expression \p x in the isl syntax.
+ * @param x The expression.
+ * @param dims The names of the dimensions the expression can refer to.
+ * @param os The output stream.
+ * @return false if \p x is not affine to \p dims.
+ */
+bool PrintAffine(const Expr& x, const std::vector<std::string>& dims, std::ostream& os) {
+  auto print_binary = [&](const Expr& a, const Expr& b, const char* op) {
+    os << '(';
+    if (!PrintAffine(a, dims, os)) return false;
+    os << ' ' << op << ' ';
+    if (!PrintAffine(b, dims, os)) return false;
+    os << ')';
+    return true;
+  };
+  auto positive_const = [](const Expr& x) { return x.As<ir::IntImm>() && x.As<ir::IntImm>()->value > 0; };
+
+  if (auto* op = x.As<ir::IntImm>()) {
+    os << op->value;
+    return true;
+  }
+  if (auto* op = x.As<ir::_Var_>()) {
+    if (std::find(dims.begin(), dims.end(), op->name) == dims.end()) return false;
+    os << op->name;
+    return true;
+  }
+  if (auto* op = x.As<ir::Add>()) return print_binary(op->a(), op->b(), "+");
+  if (auto* op = x.As<ir::Sub>()) return print_binary(op->a(), op->b(), "-");
+  if (auto* op = x.As<ir::Mul>()) {
+    if (!op->a().As<ir::IntImm>() && !op->b().As<ir::IntImm>()) return false;
+    return print_binary(op->a(), op->b(), "*");
+  }
+  if (auto* op = x.As<ir::Div>()) {
+    // The indices are non-negative, where the integer division equals to the floor division.
+    if (!positive_const(op->b())) return false;
+    os << "floor";
+    return print_binary(op->a(), op->b(), "/");
+  }
+  if (auto* op = x.As<ir::Mod>()) {
+    if (!positive_const(op->b())) return false;
+    return print_binary(op->a(), op->b(), "mod");
+  }
+  return false;
+}
+
+//! Get the access relation from the instances of \p domain to the elements of the buffer \p buffer.
+isl::map AccessMap(const isl::set& domain,
+                   const std::vector<std::string>& dims,
+                   const std::string& buffer,
+                   const std::vector<Expr>& indices) {
+  std::string tuple = isl_set_get_tuple_name(domain.get());
+  std::stringstream os;
+  os << "{ " << tuple << '[' << utils::Join(dims, ", ") << "] -> " << buffer << '[';
+  bool affine = true;
+  for (int i = 0; i < indices.size() && affine; i++) {
+    if (i > 0) os << ", ";
+    affine = PrintAffine(indices[i], dims, os);
+  }
+  os << "] }";
+
+  isl::map access;
+  if (affine) {
+    access = isl::map(domain.ctx(), os.str());
+  } else {
+    // Assume the accesses of non-affine indices to access the whole buffer.
+    std::vector<std::string> out_dims;
+    for (int i = 0; i < indices.size(); i++) out_dims.push_back("o" + std::to_string(i));
+    access = isl::map(domain.ctx(),
+                      utils::StringFormat("{ %s[%s] -> %s[%s] }",
+                                          tuple.c_str(),
+                                          utils::Join(dims, ", ").c_str(),
+                                          buffer.c_str(),
+                                          utils::Join(out_dims, ", ").c_str()));
+  }
+  return access.intersect_domain(domain);
+}
+
+//! Tell if the time space tuples of \p x are not shorter than \p n.
+bool HasTimeDims(const isl::map& x, int n) {
+  return isl_map_dim(x.get(), isl_dim_in) >= n && isl_map_dim(x.get(), isl_dim_out) >= n;
+}
+
+}  // namespace
+
+DependenceAnalysis::DependenceAnalysis(const std::vector<Stage*>& stages, const ScheduleGroup& group) {
+  if (stages.empty()) return;
+
+  auto schedule_map = CollectScheduleMapFromGroup(group);
+  for (auto* stage : stages) {
+    auto it = schedule_map.find(stage->id());
+    CHECK(it != schedule_map.end()) << "stage " << stage->id() << " not found in the schedule";
+    schedules_[stage->id()] = stage->transform().apply_range(it->second);
+
+    // The tensors sharing a buffer, like a reduce tensor and its initialization, access the same memory.
+    std::vector<std::string> tensors(stage->meta.tensors_to_share_buffer_with.begin(),
+                                     stage->meta.tensors_to_share_buffer_with.end());
+    tensors.push_back(stage->id());
+    std::string buffer = *std::min_element(tensors.begin(), tensors.end());
+    for (auto& tensor : tensors) {
+      auto& x = buffer_of_tensor_[tensor];
+      x       = x.empty() ? buffer : std::min(x, buffer);
+    }
+
+    for (auto& info : stage->meta.compute_at_infos) compute_at_level_ = std::max(compute_at_level_, info.level);
+    for (auto& relation : stage->compute_ats()) compute_at_level_ = std::max(compute_at_level_, relation.level);
+  }
+
+  std::vector<std::vector<Access>> accesses(stages.size());
+  for (int i = 0; i < stages.size(); i++) {
+    if (!CollectAccesses(stages[i], &accesses[i])) {
+      opaque_ = true;
+      return;
+    }
+  }
+
+  for (int i = 0; i < stages.size(); i++) {
+    for (int j = 0; j < stages.size(); j++) {
+      for (auto& a : accesses[i]) {
+        if (!a.is_write) continue;
+        for (auto& b : accesses[j]) {
+          if (a.buffer != b.buffer) continue;
+          isl::map dep;
+          if (isl_map_dim(a.map.get(), isl_dim_out) == isl_map_dim(b.map.get(), isl_dim_out)) {
+            dep = a.map.apply_range(isl::manage(isl_map_reverse(b.map.copy())));
+          } else {
+            // The buffer is accessed in different shapes, assume all the instances depend on each other.
+            dep = isl::manage(isl_map_from_domain_and_range(stages[i]->domain().copy(), stages[j]->domain().copy()));
+          }
+          dep = dep.apply_domain(schedules_[stages[i]->id()]).apply_range(schedules_[stages[j]->id()]);
+          if (!dep.is_empty()) dependences_.push_back(dep);
+        }
+      }
+    }
+  }
+}
+
+bool DependenceAnalysis::CollectAccesses(Stage* stage, std::vector<Access>* accesses) {
+  auto* tensor = stage->tensor();
+  if (!tensor || !tensor->is_compute_node() || tensor->is_tuple()) return false;
+
+  std::vector<std::string> dims;
+  for (auto& axis : tensor->axis_with_reduce()) dims.push_back(axis->name);
+  if (static_cast<int>(dims.size()) != isl_set_dim(stage->domain().get(), isl_dim_set)) return false;
+
+  Expr body   = tensor->tensor_store_expanded_body();
+  auto* store = body.As<ir::Store>();
+  if (!store) return false;
+  auto buffer = BufferId(tensor->name);
+  accesses->push_back(Access{buffer, AccessMap(stage->domain(), dims, buffer, store->indices), true});
+
+  auto loads = ir::CollectIRNodes(store->value, [](const Expr* x) { return x->As<ir::Load>(); });
+  for (auto& x : loads) {
+    auto* load = x.As<ir::Load>();
+    if (!load->tensor.as_tensor()) return false;
+    buffer = BufferId(load->tensor.as_tensor()->name);
+    accesses->push_back(Access{buffer, AccessMap(stage->domain(), dims, buffer, load->indices), false});
+  }
+  return true;
+}
+
+std::string DependenceAnalysis::BufferId(const std::string& tensor_name) {
+  auto it         = buffer_of_tensor_.find(tensor_name);
+  auto& buffer    = it == buffer_of_tensor_.end() ? tensor_name : it->second;
+  auto& buffer_id = buffer_ids_[buffer];
+  // Name the buffers in the isl syntax.
+  if (buffer_id.empty()) buffer_id = "_buf_" + std::to_string(buffer_ids_.size() - 1);
+  return buffer_id;
+}
+
+bool DependenceAnalysis::IsParallel(const Stage* stage, int level) const {
+  CHECK_GE(level, 0);
+  CHECK_LT(level, stage->n_out_dims());
+  if (opaque_ || level <= compute_at_level_) return false;
+  int dim = 2 * level + 2;
+  return !HasDependence(stage, dim, dim);
+}
+
+bool DependenceAnalysis::IsJamLegal(const Stage* stage, int outer_level, int level) const {
+  CHECK_GE(outer_level, -1);
+  CHECK_LT(outer_level, level);
+  CHECK_LT(level, stage->n_out_dims());
+  // The loop is not moved, it is just unrolled.
+  if (level == outer_level + 1) return true;
+  // The jam is not proven legal if the dependences are unknown.
+  if (opaque_ || outer_level < compute_at_level_) {
+    VLOG(3) << "Cannot verify the unroll and jam of the loop " << level << " of stage " << stage->id()
+            << ", the dependences are unknown";
+    return false;
+  }
+  return !HasDependence(stage, 2 * outer_level + 3, 2 * level + 2);
+}
+
+bool DependenceAnalysis::HasDependence(const Stage* stage, int shared, int dim) const {
+  auto it = schedules_.find(stage->id());
+  CHECK(it != schedules_.end()) << "stage " << stage->id() << " is not analyzed";
+
+  // The loops are identified by the root and the static times of the levels in the time space, which are fixed for a
+  // stage.
+  isl::set time = stage->domain().apply(it->second);
+  if (isl_set_dim(time.get(), isl_dim_set) <= dim) return true;
+  std::vector<std::string> conds;
+  for (int i = 0; i < shared; i++) {
+    if (i == 0 || i % 2 == 1) {
+      isl::val val = isl::manage(isl_set_plain_get_val_if_fixed(time.get(), isl_dim_set, i));
+      if (!isl_val_is_int(val.get())) return true;
+      conds.push_back(utils::StringFormat("a%d = %ld", i, isl_val_get_num_si(val.get())));
+    }
+    conds.push_back(utils::StringFormat("b%d = a%d", i, i));
+  }
+  conds.push_back(utils::StringFormat("(a%d < b%d or a%d > b%d)", dim, dim, dim, dim));
+
+  for (auto& dep : dependences_) {
+    if (!HasTimeDims(dep, dim + 1)) continue;
+    std::vector<std::string> a, b;
+    for (int i = 0; i < isl_map_dim(dep.get(), isl_dim_in); i++) a.push_back("a" + std::to_string(i));
+    for (int i = 0; i < isl_map_dim(dep.get(), isl_dim_out); i++) b.push_back("b" + std::to_string(i));
+    isl::map carried(dep.ctx(),
+                     utils::StringFormat("{ [%s] -> [%s] : %s }",
+                                         utils::Join(a, ", ").c_str(),
+                                         utils::Join(b, ", ").c_str(),
+                                         utils::Join(conds, " and ").c_str()));
+    if (!dep.intersect(carried).is_empty()) {
+      VLOG(3) << "The time dimension " << dim << " of stage " << stage->id() << " carries the dependence " << dep;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace poly
+}  // namespace cinn
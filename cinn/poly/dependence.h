@@ -0,0 +1,90 @@
+/**
+ * This file implements the dependence analysis of the stages in a schedule group, it tells which loops of the code
+ * generated carry no dependence, so their iterations can run in parallel.
+ */
+#pragma once
+#include <gflags/gflags.h>
+#include <isl/cpp.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "cinn/poly/schedule.h"
+#include "cinn/poly/stage.h"
+
+DECLARE_bool(cinn_auto_parallel);
+DECLARE_bool(cinn_auto_vectorize);
+DECLARE_bool(cinn_verify_parallel);
+
+namespace cinn {
+namespace poly {
+
+/**
+ * Analyze the dependences between the statement instances of the stages in a schedule group.
+ *
+ * Two instances depend on each other if they access the same element of a buffer and at least one of them writes it.
+ * The dependences are mapped to the time space of the group schedule, where the \p level -th loop of a stage is the
+ * dimension `2 * level + 2`, and a loop carries a dependence if it relates two instances in the same iteration of the
+ * outer loops but in different iterations of the loop.
+ *
+ * The accesses whose indices are not affine to the iterators are assumed to access the whole buffer, so the analysis is
+ * conservative, a loop reported parallel is proven to be.
+ */
+class DependenceAnalysis {
+ public:
+  DependenceAnalysis(const std::vector<Stage*>& stages, const ScheduleGroup& group);
+
+  /**
+   * Tell whether the \p level -th loop of \p stage carries no dependence.
+   * @param stage A stage of the group.
+   * @param level The level of the loop in the transformed domain of \p stage.
+   */
+  bool IsParallel(const Stage* stage, int level) const;
+
+  /**
+   * Tell whether the \p level -th loop of \p stage can be unrolled and jammed from right after the \p outer_level -th
+   * loop, i.e. it carries no dependence in an iteration of the loops up to \p outer_level, so moving it across the
+   * loops between reverses none. The jams of the stages with unknown dependences are rejected.
+   * @param stage A stage of the group.
+   * @param outer_level The level of the loop the jammed loop was right after, -1 for none.
+   * @param level The level of the jammed loop in the transformed domain of \p stage.
+   */
+  bool IsJamLegal(const Stage* stage, int outer_level, int level) const;
+
+  //! The dependences in the time space, each relates two instances of the stages.
+  const std::vector<isl::map>& dependences() const { return dependences_; }
+
+ private:
+  struct Access {
+    //! The id of the buffer accessed.
+    std::string buffer;
+    isl::map map;
+    bool is_write{};
+  };
+
+  //! Collect the accesses of \p stage, return false if some accesses are unknown.
+  bool CollectAccesses(Stage* stage, std::vector<Access>* accesses);
+
+  /**
+   * Tell whether a dependence might relate two instances at the same times of the first \p shared dimensions of the
+   * time space of \p stage and at different times of the dimension \p dim.
+   */
+  bool HasDependence(const Stage* stage, int shared, int dim) const;
+
+  //! Get the id of the buffer of the tensor \p tensor_name, the tensors sharing a buffer have the same id.
+  std::string BufferId(const std::string& tensor_name);
+
+  std::map<std::string, isl::map> schedules_;
+  std::vector<isl::map> dependences_;
+  std::map<std::string, std::string> buffer_of_tensor_;
+  std::map<std::string, std::string> buffer_ids_;
+  //! The loops no more outer than this level are shared by the producers computed at their consumers, whose buffers are
+  //! reused by the iterations.
+  int compute_at_level_{-1};
+  //! Some accesses are unknown, no loop is proven parallel.
+  bool opaque_{};
+};
+
+}  // namespace poly
+}  // namespace cinn
@@ -0,0 +1,215 @@
+#include "cinn/poly/dependence.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+
+namespace cinn {
+namespace poly {
+
+namespace {
+
+std::vector<const ir::For*> GetForloops(Expr expr) {
+  std::vector<const ir::For*> forloops;
+  for (auto& x : ir::CollectIRNodes(expr, [](const Expr* x) { return x->As<ir::For>(); })) {
+    forloops.push_back(x.As<ir::For>());
+  }
+  return forloops;
+}
+
+//! Get the forloops not nested in other forloops.
+std::vector<const ir::For*> GetOutermostForloops(Expr expr) {
+  auto forloops = GetForloops(expr);
+  std::vector<const ir::For*> res;
+  for (auto* forloop : forloops) {
+    bool nested = std::any_of(forloops.begin(), forloops.end(), [&](const ir::For* other) {
+      return !ir::CollectIRNodes(other->body, [&](const Expr* x) { return x->As<ir::For>() == forloop; }).empty();
+    });
+    if (!nested) res.push_back(forloop);
+  }
+  return res;
+}
+
+}  // namespace
+
+TEST(DependenceAnalysis, matmul) {
+  Expr M(32), N(64), K(16);
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(K.as_int32(), "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+  auto stages = CreateStages({C});
+
+  auto schedule = CreateSchedule({stages[C]}, ScheduleKind::Poly);
+  ASSERT_EQ(schedule->groups.size(), 1UL);
+  DependenceAnalysis analysis({stages[C]}, schedule->groups.front());
+
+  // The reduction carries the dependences of C[i, j] in the loop over k.
+  ASSERT_FALSE(analysis.dependences().empty());
+  ASSERT_TRUE(analysis.IsParallel(stages[C], 0));
+  ASSERT_TRUE(analysis.IsParallel(stages[C], 1));
+  ASSERT_FALSE(analysis.IsParallel(stages[C], 2));
+}
+
+TEST(DependenceAnalysis, share_buffer) {
+  Expr M(32), N(64);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + 1.f; }, "B");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return B(i, j) * 2.f; }, "C");
+  auto stages = CreateStages({B, C});
+  stages[C]->ShareBufferWith(stages[B]);
+
+  auto schedule = CreateSchedule({stages[B], stages[C]}, ScheduleKind::Poly);
+  for (auto& group : schedule->groups) {
+    std::vector<Stage*> group_stages;
+    for (auto& node : group.nodes) group_stages.push_back(node->stage);
+    DependenceAnalysis analysis(group_stages, group);
+    for (auto* stage : group_stages) {
+      // C updates the buffer of B in place, the accesses to the same elements carry no dependence.
+      ASSERT_TRUE(analysis.IsParallel(stage, 0));
+      ASSERT_TRUE(analysis.IsParallel(stage, 1));
+    }
+  }
+}
+
+TEST(DependenceAnalysis, unroll_and_jam) {
+  Expr M(32), N(64), K(16);
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(K.as_int32(), "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+  auto stages = CreateStages({C});
+  stages[C]->UnrollAndJam(0, 4);
+
+  auto schedule = CreateSchedule({stages[C]}, ScheduleKind::Poly);
+  ASSERT_EQ(schedule->groups.size(), 1UL);
+  DependenceAnalysis analysis({stages[C]}, schedule->groups.front());
+  // The copies over i update different elements of C.
+  ASSERT_TRUE(analysis.IsJamLegal(stages[C], 0, 3));
+}
+
+TEST(DependenceAnalysis, unroll_and_jam_reversed) {
+  Expr M(32), N(64);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + 1.f; }, "B");
+  // C updates the buffer of B in place, C[i, j] is read before it is overwritten by C[i + 1, j - 1].
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return B(i + 1, j - 1) * 2.f; }, "C");
+  auto stages = CreateStages({B, C});
+  stages[C]->ShareBufferWith(stages[B]);
+  stages[C]->UnrollAndJam(0, 2);
+
+  auto schedule = CreateSchedule({stages[B], stages[C]}, ScheduleKind::Poly);
+  for (auto& group : schedule->groups) {
+    std::vector<Stage*> group_stages;
+    for (auto& node : group.nodes) group_stages.push_back(node->stage);
+    if (std::find(group_stages.begin(), group_stages.end(), stages[C]) == group_stages.end()) continue;
+    DependenceAnalysis analysis(group_stages, group);
+    // The jam runs C[i + 1, j - 1] before C[i, j] reads the element.
+    ASSERT_FALSE(analysis.IsJamLegal(stages[C], 0, 2));
+  }
+}
+
+TEST(DependenceAnalysis, unroll_and_jam_unknown) {
+  Expr M(32), N(64), K(16);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + 1.f; }, "B");
+  auto C = Compute(
+      {M, N, K}, [&](Var i, Var j, Var k) { return B(i, j) * 2.f; }, "C");
+  auto stages = CreateStages({C});
+  stages[B]->ComputeAt(stages[C], 1);
+  stages[C]->UnrollAndJam(0, 2);
+
+  auto schedule = CreateSchedule({stages[B], stages[C]}, ScheduleKind::Poly);
+  bool analyzed = false;
+  for (auto& group : schedule->groups) {
+    std::vector<Stage*> group_stages;
+    for (auto& node : group.nodes) group_stages.push_back(node->stage);
+    if (std::find(group_stages.begin(), group_stages.end(), stages[C]) == group_stages.end()) continue;
+    DependenceAnalysis analysis(group_stages, group);
+    // The jam moves the loop over i across the loop over j, which B is computed at, the dependences between the
+    // iterations sharing the buffer of B are unknown.
+    ASSERT_FALSE(analysis.IsJamLegal(stages[C], 0, 3));
+    // Unrolling without moving the loop is always legal.
+    ASSERT_TRUE(analysis.IsJamLegal(stages[C], 2, 3));
+    analyzed = true;
+  }
+  ASSERT_TRUE(analyzed);
+}
+
+TEST(DependenceAnalysis, verify_parallel) {
+  Expr M(32), N(64);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+  auto stages = CreateStages({C});
+  stages[C]->Parallel(0);
+
+  auto func     = Lower("elementwise_parallel", stages, {A, B, C});
+  auto forloops = GetOutermostForloops(func->body);
+  ASSERT_EQ(forloops.size(), 1UL);
+  ASSERT_TRUE(forloops[0]->is_parallel());
+  auto inner_forloops = GetForloops(forloops[0]->body);
+  ASSERT_EQ(inner_forloops.size(), 1UL);
+  ASSERT_FALSE(inner_forloops[0]->is_parallel());
+}
+
+TEST(DependenceAnalysis, auto_parallel) {
+  bool auto_parallel        = FLAGS_cinn_auto_parallel;
+  bool auto_vectorize       = FLAGS_cinn_auto_vectorize;
+  FLAGS_cinn_auto_parallel  = true;
+  FLAGS_cinn_auto_vectorize = true;
+
+  {
+    // The outer loop runs in parallel, the inner loop is vectorized.
+    Expr M(32), N(64);
+    Placeholder<float> A("A", {M, N});
+    Placeholder<float> B("B", {M, N});
+    auto C = Compute(
+        {M, N}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+    auto stages = CreateStages({C});
+
+    auto func = Lower("elementwise_auto_parallel", stages, {A, B, C});
+    LOG(INFO) << "func:\n" << func;
+    auto forloops = GetOutermostForloops(func->body);
+    ASSERT_EQ(forloops.size(), 1UL);
+    ASSERT_TRUE(forloops[0]->is_parallel());
+    ASSERT_FALSE(ir::CollectIRNodes(func->body, [](const Expr* x) { return x->As<ir::Ramp>(); }).empty());
+  }
+
+  {
+    // The loop over the reduce axis carries dependences and is not vectorized.
+    Expr M(32), N(64), K(16);
+    Placeholder<float> A("A", {M, K});
+    Placeholder<float> B("B", {K, N});
+    Var k(K.as_int32(), "k0");
+    auto C = Compute(
+        {M, N}, [&](Var i, Var j) { return ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+    auto stages = CreateStages({C});
+
+    auto func = Lower("matmul_auto_parallel", stages, {A, B, C});
+    LOG(INFO) << "func:\n" << func;
+    for (auto* forloop : GetOutermostForloops(func->body)) ASSERT_TRUE(forloop->is_parallel());
+    auto forloops = GetForloops(func->body);
+    ASSERT_TRUE(std::any_of(forloops.begin(), forloops.end(), [](const ir::For* x) {
+      return x->loop_var->name == "k0" && !x->is_parallel();
+    }));
+  }
+
+  FLAGS_cinn_auto_parallel  = auto_parallel;
+  FLAGS_cinn_auto_vectorize = auto_vectorize;
+}
+
+}  // namespace poly
+}  // namespace cinn
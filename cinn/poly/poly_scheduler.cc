@@ -10,6 +10,7 @@
 #include <unordered_set>
 
 #include "cinn/poly/isl_utils.h"
+#include "cinn/utils/profiler.h"
 
 namespace cinn {
 namespace poly {
@@ -312,6 +313,11 @@ void PolyScheduler::ScheduleAGroup(ScheduleGroup* group) {
     stages.push_back(const_cast<Stage*>(node->stage));
   }
 
+  if (utils::CompileProfiler::Global().enabled()) {
+    utils::CompileProfiler::Global().AddCount("isl.schedule_groups", 1);
+    utils::CompileProfiler::Global().AddCount("isl.schedule_stages", stages.size());
+  }
+
   PolyGroupScheduler scheduler(stages);
   group->nodes           = scheduler.Build();
   group->dimension_names = scheduler.detailed_dimension_names();
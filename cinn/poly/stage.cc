@@ -156,6 +156,34 @@ std::tuple<Iterator, Iterator, Iterator, Iterator> Stage::Tile(const Iterator &l
   return std::make_tuple(level0_outer, level0_inner, level1_outer, level1_inner);
 }
 
+std::tuple<Iterator, Iterator> Stage::UnrollAndJam(int level, int factor) {
+  AssertAxisIsNotLocked(level);
+  return UnrollAndJam(ith_iterator(level), factor);
+}
+
+std::tuple<Iterator, Iterator> Stage::UnrollAndJam(const std::string &level, int factor) {
+  return UnrollAndJam(Iterator(level), factor);
+}
+
+std::tuple<Iterator, Iterator> Stage::UnrollAndJam(const Iterator &level, int factor) {
+  CHECK_GT(factor, 1) << "unroll and jam " << level << " by " << factor;
+  auto [outer, inner] = Split(level, factor);  // NOLINT
+
+  // Sink the inner iterator below all the levels after it and unroll it.
+  auto dim_names = axis_names();
+  auto it        = std::find(dim_names.begin(), dim_names.end(), inner.id);
+  CHECK(it != dim_names.end());
+  std::vector<Iterator> order;
+  for (auto jt = it + 1; jt != dim_names.end(); ++jt) order.emplace_back(*jt);
+  for (int i = std::distance(dim_names.begin(), it); i < dim_names.size(); i++) AssertAxisIsNotLocked(i);
+  order.push_back(inner);
+  if (order.size() > 1) Reorder(order);
+
+  Unroll(inner);
+  unroll_and_jams_.emplace_back(outer.id, inner.id);
+  return std::make_tuple(outer, inner);
+}
+
 void Stage::ComputeAtSchedule(Stage *other, int level, ComputeAtKind kind) {
   // TODO(Superjomn) Check there are data dependency between `self` and `other`, or the `ComputeAt` is meaningless.
   CHECK(other->tensor());
@@ -405,6 +433,21 @@ void Stage::Unroll(int level) {
   unroll_info_.insert(level);
 }
 
+void Stage::Parallel(int level) {
+  AssertAxisIsNotLocked(level);
+  CHECK_LT(level, n_out_dims());
+  parallel_info_.insert(level);
+}
+
+void Stage::Parallel(const std::string &level) {
+  auto dim_names = axis_names();
+  auto it        = std::find(dim_names.begin(), dim_names.end(), level);
+  CHECK(it != dim_names.end()) << "No dimension called " << level;
+  Parallel(std::distance(dim_names.begin(), it));
+}
+
+void Stage::Parallel(const Iterator &level) { Parallel(level.id); }
+
 std::string Stage::ith_dim_name(int level) {
   auto dims = isl_get_dim_names(transformed_domain());
   CHECK_LT(level, dims.size());
@@ -665,6 +708,44 @@ Stage *_StageMap_::InsertLazily(const ir::Tensor &key) {
   return Insert(key, ir::CreateStage(key).get());
 }
 
+StageMap _StageMap_::Copy() const {
+  StageMap res;
+  for (auto &[name, stage] : data_) {
+    auto *x                              = new Stage;
+    x->meta.compute_at_infos             = stage->meta.compute_at_infos;
+    x->meta.compute_inline               = stage->meta.compute_inline;
+    x->meta.tensors_to_share_buffer_with = stage->meta.tensors_to_share_buffer_with;
+    if (stage->meta.read_cache_relation) {
+      x->meta.read_cache_relation.reset(new ReadCacheRelation(*stage->meta.read_cache_relation));
+    }
+    if (stage->meta.write_cache_relation) {
+      x->meta.write_cache_relation.reset(new WriteCacheRelation(*stage->meta.write_cache_relation));
+    }
+    x->domain_          = stage->domain_;
+    x->transform_       = stage->transform_;
+    x->expr_            = stage->expr_;
+    x->compute_ats_     = stage->compute_ats_;
+    x->vectorize_info_  = stage->vectorize_info_;
+    x->unroll_info_     = stage->unroll_info_;
+    x->parallel_info_   = stage->parallel_info_;
+    x->unroll_and_jams_ = stage->unroll_and_jams_;
+    x->forloop_infos_   = stage->forloop_infos_;
+    x->tensor_          = stage->tensor_;
+    x->scope_           = stage->scope_;
+    x->ctrl_depends_    = stage->ctrl_depends_;
+    x->locked_axis_     = stage->locked_axis_;
+    res->data_[name].Reset(x);
+  }
+  // The relations refer to the copies of the stages computed at.
+  for (auto &item : res->data_) {
+    for (auto &[id, relation] : item.second->compute_ats_) {
+      auto it = res->data_.find(relation.stage->id());
+      if (it != res->data_.end()) relation.stage = it->second;
+    }
+  }
+  return res;
+}
+
 StageMap CreateStages(const std::vector<ir::Tensor> &tensors) {
   StageMap stages;
 
@@ -186,6 +186,43 @@ class Stage : public Object {
   void Unroll(const std::string& level);
   void Unroll(const Iterator& level);
 
+  /**
+   * Unroll the loop level \p level by \p factor and jam the copies into the innermost loop, e.g. the register blocking
+   * of a GEMM `C[i, j] += A[i, k] * B[k, j]` by `UnrollAndJam(0, 4)`
+   *
+   * \code
+   * for (i_outer, 0, M/4)
+   *   for (j, 0, N)
+   *     for (k, 0, K)
+   *       C[i_outer*4 + 0, j] += A[i_outer*4 + 0, k] * B[k, j]
+   *       ...
+   *       C[i_outer*4 + 3, j] += A[i_outer*4 + 3, k] * B[k, j]
+   * \endcode
+   *
+   * The copies share the loads of `B` and keep their accumulators in 4 registers once `C` is cached to a "local"
+   * buffer computed at the level `j` of its writer, see `CacheWrite`.
+   * Sinking the copies innermost reorders the iterations, the lowering rejects the jam if it might reverse a
+   * dependence, see `DependenceAnalysis::IsJamLegal`.
+   * @param level the level to unroll.
+   * @param factor the number of the copies.
+   * @return the new outer iterator and the inner unrolled one.
+   */
+  // @{
+  std::tuple<Iterator, Iterator>  //
+  UnrollAndJam(const Iterator& level, int factor);
+  std::tuple<Iterator, Iterator>  //
+  UnrollAndJam(const std::string& level, int factor);
+  std::tuple<Iterator, Iterator>  //
+  UnrollAndJam(int level, int factor);
+  // @}
+
+  /**
+   * Mark a for-loop to run its iterations in parallel.
+   */
+  void Parallel(int level);
+  void Parallel(const std::string& level);
+  void Parallel(const Iterator& level);
+
   void Bind(int level, const std::string& axis);
 
   enum ComputeAtKind {
@@ -233,7 +270,8 @@ class Stage : public Object {
   /**
    * Create a cache for write to the original tensor.
    * @param tensor the tensor to create the cache for.
-   * @param memory_type "share" for CUDA share memory, "local" for CUDA local memory.
+   * @param memory_type "share" for CUDA share memory, "local" for CUDA local memory, or for the arrays on the stack on
+   * CPU when the shape of the cache is constant.
    */
   ir::Tensor CacheWrite(const std::string& memory_type, poly::StageMap stages);
 
@@ -283,6 +321,9 @@ class Stage : public Object {
 
   inline const ir::VectorizeInfo& vectorize_info() const { return vectorize_info_; }
   inline const std::set<int>& unroll_info() const { return unroll_info_; }
+  inline const std::set<int>& parallel_info() const { return parallel_info_; }
+  //! The outer and the inner iterators of the unrolled and jammed loops.
+  inline const std::vector<std::pair<std::string, std::string>>& unroll_and_jams() const { return unroll_and_jams_; }
 
   /*
   const std::set<std::string>& extra_depend_stages() const { return extra_depend_stages_; }
@@ -335,6 +376,9 @@ class Stage : public Object {
   ir::VectorizeInfo vectorize_info_;
   //! The for-loop levels to unroll.
   std::set<int> unroll_info_;
+  //! The for-loop levels to run in parallel.
+  std::set<int> parallel_info_;
+  std::vector<std::pair<std::string, std::string>> unroll_and_jams_;
   //! Record some forloop levels' information.
   std::map<int /*level*/, StageForloopInfo> forloop_infos_;
   //! A weak reference to the tensor.
@@ -348,6 +392,7 @@ class Stage : public Object {
 
   friend isl_map* __isl_give GatherAccesses(Stage* stage, const std::string& tensor_name);
   friend class PolyGroupScheduler;
+  friend class _StageMap_;
 };
 
 std::vector<std::pair<std::string, std::string>> ExtractExtraDepLinksFromStages(const std::vector<Stage*>& stages);
@@ -399,6 +444,9 @@ class _StageMap_ : public Object {
 
   inline size_t size() const { return data_.size(); }
 
+  //! Copy the stages into a new map, the schedules applied to the copies leave the stages of this map unchanged.
+  StageMap Copy() const;
+
   const char* type_info() const override { return __type_info__; }
 
   static constexpr const char* __type_info__ = "StageMap";
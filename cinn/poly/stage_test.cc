@@ -54,6 +54,19 @@ TEST(Stage, tile) {
       "6 = 0 and -3 + i <= 4i_outer <= i and 0 <= i_inner <= 3 and -5 + j <= 6j_outer <= j and 0 <= j_inner <= 5 }");
 }
 
+TEST(Stage, unroll_and_jam) {
+  isl::ctx ctx(isl_ctx_alloc());
+  isl::set domain(ctx, "{ S[i,j,k]: 0<=i,j,k<=99 }");
+  auto ele = Stage::New(domain);
+
+  auto [outer, inner] = ele->UnrollAndJam(Iterator("i"), 4);  // NOLINT
+  LOG(INFO) << ele->transform();
+  EXPECT_EQ(outer.id, "i_outer");
+  EXPECT_EQ(inner.id, "i_inner");
+  EXPECT_EQ(ele->axis_names(), (std::vector<std::string>{"i_outer", "j", "k", "i_inner"}));
+  EXPECT_EQ(ele->unroll_info(), (std::set<int>{3}));
+}
+
 TEST(Stage, reorder) {
   isl::ctx ctx(isl_ctx_alloc());
   isl::set domain(ctx, "{ S[i,j,k]: 0<=i,j,k<=100 }");
@@ -503,6 +516,49 @@ TEST(Unroll, jit_precision_test1) {
   TestElementwiseAddJitPrecession([](ir::Tensor* C, StageMap stages) { stages[*C]->Unroll(0); });
 }
 
+TEST(UnrollAndJam, jit_precision_test) {
+  TestElementwiseAddJitPrecession([](ir::Tensor* C, StageMap stages) { stages[*C]->UnrollAndJam(0, 3); });
+}
+
+TEST(UnrollAndJam, cache_write_local) {
+  Expr M(16), N(32);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) -> Expr { return A(i, j) * 2.f + B(i, j); }, "C");
+  auto stages = CreateStages({C});
+  auto C_out  = stages[C]->CacheWrite("local", stages);
+  stages[C]->UnrollAndJam(0, 4);
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  auto fn = Lower("fn", stages, {A, B, C_out}, {}, {}, &builder);
+  LOG(INFO) << "fn:\n" << fn;
+
+  // The local cache is allocated on the stack of the function rather than in the module.
+  ASSERT_EQ(fn->temp_bufs.size(), 1UL);
+  ASSERT_EQ(fn->temp_bufs[0]->memory_type, ir::MemoryType::Stack);
+  auto module = builder.Build();
+  ASSERT_TRUE(module.buffers().empty());
+
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(module, false);
+  auto* fn_handler = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("fn"));
+
+  auto A_buf    = common::BufferBuilder(Float(32), {16, 32}).set_random().Build();
+  auto B_buf    = common::BufferBuilder(Float(32), {16, 32}).set_random().Build();
+  auto C_buf    = common::BufferBuilder(Float(32), {16, 32}).set_zero().Build();
+  auto arg_pack = common::ArgsBuilder().Add(A_buf).Add(B_buf).Add(C_buf).Build();
+  fn_handler(arg_pack.data(), arg_pack.size());
+
+  auto* A_data = reinterpret_cast<float*>(A_buf->memory);
+  auto* B_data = reinterpret_cast<float*>(B_buf->memory);
+  auto* C_data = reinterpret_cast<float*>(C_buf->memory);
+  for (int i = 0; i < A_buf->num_elements(); i++) {
+    ASSERT_NEAR(A_data[i] * 2.f + B_data[i], C_data[i], 1e-5);
+  }
+}
+
 TEST(ComputeInline, basic) {
   Expr M(100), N(200);
   Placeholder<float> A("A", {M, N});
@@ -604,6 +660,29 @@ function fn (_A, _C, _C1, _C2)
   ASSERT_EQ(utils::Trim(target), utils::Trim(utils::GetStreamCnt(fn)));
 }
 
+TEST(StageMap, Copy) {
+  Expr M(32), N(16);
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Expr i, Expr j) { return A(i, j) * 2.f; }, "B");
+  auto C = Compute(
+      {M, N}, [&](Expr i, Expr j) { return B(i, j) + 1.f; }, "C");
+  auto stages = CreateStages({C});
+  stages[B]->ComputeAt(stages[C], 0);
+
+  auto copy = stages->Copy();
+  ASSERT_NE(copy[B], stages[B]);
+  ASSERT_NE(copy[C], stages[C]);
+  // The relation refers to the copy of the consumer.
+  ASSERT_EQ(copy[B]->compute_ats().size(), 1UL);
+  ASSERT_EQ(copy[B]->compute_ats().front().stage.get(), copy[C]);
+  ASSERT_EQ(copy[C]->meta.compute_at_infos.size(), 1UL);
+
+  copy[C]->Split(1, 4);
+  ASSERT_EQ(copy[C]->n_out_dims(), 3);
+  ASSERT_EQ(stages[C]->n_out_dims(), 2);
+}
+
 TEST(ShareBufferWith, basic) {
   Expr M(100), N(200);
   Placeholder<float> A("A", {M, N});
@@ -0,0 +1,132 @@
+#include "cinn/runtime/cpu/loop_profiler.h"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "cinn/backends/extern_func_jit_register.h"
+
+extern "C" {
+
+int64_t cinn_profile_begin(int counter) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+void cinn_profile_end(int counter, int64_t start) {
+  cinn::runtime::cpu::LoopProfiler::Global().Add(counter, cinn_profile_begin(counter) - start);
+}
+}
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+LoopProfiler::LoopProfiler() : slots_(new Slot[kMaxCounters + 1]) {}
+
+LoopProfiler::~LoopProfiler() {
+  if (!names_.empty()) std::cerr << SummaryTable();
+}
+
+LoopProfiler& LoopProfiler::Global() {
+  static LoopProfiler x;
+  return x;
+}
+
+std::string LoopProfiler::NewFunctionName(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mu_);
+  int n = num_functions_[name]++;
+  return n ? name + "#" + std::to_string(n) : name;
+}
+
+int LoopProfiler::GetCounterId(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = ids_.find(name);
+  if (it != ids_.end()) return it->second;
+  if (names_.size() >= kMaxCounters) {
+    LOG_FIRST_N(WARNING, 1) << "Too many counters of the loop profiler, the ones beyond " << kMaxCounters
+                            << " are summed into " << kOverflowName;
+    overflowed_ = true;
+    return kMaxCounters;
+  }
+  int id = names_.size();
+  names_.push_back(name);
+  ids_[name] = id;
+  return id;
+}
+
+std::vector<LoopProfiler::Counter> LoopProfiler::GetCounters() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  std::vector<Counter> res;
+  for (int i = 0; i < names_.size(); i++) {
+    res.push_back(Counter{names_[i],
+                          slots_[i].calls.load(std::memory_order_relaxed),
+                          slots_[i].cycles.load(std::memory_order_relaxed)});
+  }
+  if (overflowed_) {
+    res.push_back(Counter{kOverflowName,
+                          slots_[kMaxCounters].calls.load(std::memory_order_relaxed),
+                          slots_[kMaxCounters].cycles.load(std::memory_order_relaxed)});
+  }
+  return res;
+}
+
+void LoopProfiler::Reset() {
+  for (int i = 0; i <= kMaxCounters; i++) {
+    slots_[i].calls.store(0, std::memory_order_relaxed);
+    slots_[i].cycles.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::string LoopProfiler::SummaryTable() const {
+  auto counters = GetCounters();
+  std::map<std::string, int64_t> function_cycles;
+  for (auto& counter : counters) {
+    if (counter.name.find('/') == std::string::npos) function_cycles[counter.name] = counter.cycles;
+  }
+
+  std::stringstream os;
+  os << "======================== CINN loop profile ========================\n";
+  os << std::left << std::setw(48) << "counter" << std::right << std::setw(10) << "calls" << std::setw(16) << "cycles"
+     << std::setw(14) << "avg cycles" << std::setw(10) << "share"
+     << "\n";
+  for (auto& counter : counters) {
+    os << std::left << std::setw(48) << counter.name << std::right << std::setw(10) << counter.calls << std::setw(16)
+       << counter.cycles << std::setw(14) << (counter.calls ? counter.cycles / counter.calls : 0);
+    auto it = function_cycles.find(counter.name.substr(0, counter.name.find('/')));
+    if (it != function_cycles.end() && it->second > 0) {
+      os << std::setw(9) << std::fixed << std::setprecision(1) << 100. * counter.cycles / it->second << "%";
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(loop_profiler) {
+  auto host_target = cinn::common::DefaultHostTarget();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_profile_begin, host_target).SetRetType<int64_t>().AddInputType<int>().End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_profile_end, host_target)
+      .SetRetType<void>()
+      .AddInputType<int>()
+      .AddInputType<int64_t>()
+      .End();
+
+  return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+/**
+ * \file This file implements the counter tables of the cycles spent in the loop nests and the bodies of the lowered
+ * functions instrumented by `optim::InsertLoopProfile`.
+ */
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  //NOLINT
+#include <string>
+#include <vector>
+
+extern "C" {
+
+//! Start a call of the counter \p counter of the LoopProfiler, get the cycle counter, the time stamp counter on x86.
+int64_t cinn_profile_begin(int counter);
+
+//! End a call of the counter \p counter, add the cycles since \p start to it.
+void cinn_profile_end(int counter, int64_t start);
+}
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+/**
+ * The counters of the instrumented code, each one sums the calls and the cycles of a function body or a loop nest.
+ *
+ * The counters are created at compile time, the generated code refers to them by id and adds to them atomically. A
+ * counter is named by the function, followed by a "/<index>:<loop var>" for each level of the loop nests, where the
+ * index is the order of the forloop among its siblings, e.g. `fn_conv2d/0:i` and `fn_conv2d/1:i` for the padding and
+ * the compute nests of a convolution. The node ids naming the functions repeat across the graphs, so each
+ * instrumented function takes a name of its own, suffixed by "#<n>" if the name is taken by an earlier one.
+ *
+ * The counters beyond `kMaxCounters` share the last slot, named `kOverflowName`, rather than failing the compilation.
+ */
+class LoopProfiler {
+ public:
+  struct Counter {
+    std::string name;
+    int64_t calls{};
+    int64_t cycles{};
+  };
+
+  static constexpr int kMaxCounters = 4096;
+  static constexpr char kOverflowName[] = "<overflow>";
+
+  static LoopProfiler& Global();
+
+  //! Get a name of the function \p name not taken by the functions instrumented before.
+  std::string NewFunctionName(const std::string& name);
+
+  //! Get the id of the counter \p name, the counter is created on the first call.
+  int GetCounterId(const std::string& name);
+
+  void Add(int counter, int64_t cycles) {
+    auto& slot = slots_[counter];
+    slot.calls.fetch_add(1, std::memory_order_relaxed);
+    slot.cycles.fetch_add(cycles, std::memory_order_relaxed);
+  }
+
+  //! Get the counters in the order of creation.
+  std::vector<Counter> GetCounters() const;
+
+  //! Zero all the counters, they stay created.
+  void Reset();
+
+  //! The counters with the shares of the cycles of their functions.
+  std::string SummaryTable() const;
+
+  //! Print the summary table to stderr if any counter is created.
+  ~LoopProfiler();
+
+ private:
+  LoopProfiler();
+
+  struct Slot {
+    std::atomic<int64_t> calls{};
+    std::atomic<int64_t> cycles{};
+  };
+
+  //! The slots of the counters and the one shared by the counters beyond `kMaxCounters`.
+  std::unique_ptr<Slot[]> slots_;
+
+  mutable std::mutex mu_;
+  std::map<std::string, int> ids_;
+  std::vector<std::string> names_;
+  //! The number of the functions instrumented by name.
+  std::map<std::string, int> num_functions_;
+  bool overflowed_{false};
+};
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -0,0 +1,118 @@
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <condition_variable>  //NOLINT
+#include <mutex>               //NOLINT
+#include <thread>              //NOLINT
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+namespace {
+
+//! Whether the current thread is running a task, the launches from inside a task run serially.
+thread_local bool in_parallel_task = false;
+
+/**
+ * A pool of `hardware_concurrency - 1` workers, the worker `i` runs the task `i + 1` of each launch. The pool is never
+ * destroyed, the workers wait for the next launch until the process exits.
+ */
+class ThreadPool {
+ public:
+  static ThreadPool& Global() {
+    static auto* x = new ThreadPool;
+    return *x;
+  }
+
+  int num_threads() const { return workers_.size() + 1; }
+
+  int Launch(FCINNParallelLambda flambda, void* datas, int num_task) {
+    num_task = std::min(num_task, num_threads());
+    std::unique_lock<std::mutex> launch_lock(launch_mu_, std::try_to_lock);
+    if (num_task <= 1 || in_parallel_task || !launch_lock.owns_lock()) return flambda(0, 1, datas);
+
+    {
+      std::lock_guard<std::mutex> lock(mu_);
+      flambda_  = flambda;
+      datas_    = datas;
+      num_task_ = num_task;
+      pending_  = num_task - 1;
+      ret_      = 0;
+      ++generation_;
+    }
+    start_cv_.notify_all();
+
+    int ret = RunTask(0);
+
+    std::unique_lock<std::mutex> lock(mu_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    return ret ? ret : ret_;
+  }
+
+ private:
+  ThreadPool() {
+    int num_workers = std::max<int>(std::thread::hardware_concurrency(), 1) - 1;
+    for (int i = 0; i < num_workers; i++) {
+      workers_.emplace_back([this, i] { WorkerLoop(i + 1); });
+    }
+  }
+
+  int RunTask(int task_id) {
+    in_parallel_task = true;
+    int ret          = flambda_(task_id, num_task_, datas_);
+    in_parallel_task = false;
+    return ret;
+  }
+
+  void WorkerLoop(int task_id) {
+    uint64_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mu_);
+        start_cv_.wait(lock, [&] { return generation_ != seen; });
+        seen = generation_;
+        if (task_id >= num_task_) continue;
+      }
+
+      int ret = RunTask(task_id);
+
+      std::lock_guard<std::mutex> lock(mu_);
+      if (ret && !ret_) ret_ = ret;
+      if (--pending_ == 0) done_cv_.notify_one();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  //! Held by the thread launching, one launch runs at a time.
+  std::mutex launch_mu_;
+
+  std::mutex mu_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  uint64_t generation_{0};
+  FCINNParallelLambda flambda_{};
+  void* datas_{};
+  int num_task_{0};
+  int pending_{0};
+  int ret_{0};
+};
+
+}  // namespace
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
+
+extern "C" {
+
+int cinn_backend_get_num_threads() { return cinn::runtime::cpu::ThreadPool::Global().num_threads(); }
+
+int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int num_task) {
+  CHECK(flambda);
+  return cinn::runtime::cpu::ThreadPool::Global().Launch(flambda, datas, num_task);
+}
+}
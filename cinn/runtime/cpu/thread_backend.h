@@ -0,0 +1,21 @@
+#pragma once
+/**
+ * \file This file implements the thread pool the CPU code generated for the forloops marked parallel runs on.
+ */
+
+extern "C" {
+
+//! A task of a parallel forloop, it runs the \p task_id -th of the \p num_task chunks of the iterations.
+typedef int (*FCINNParallelLambda)(int task_id, int num_task, void* datas);
+
+//! Get the number of the threads the parallel forloops run on, the calling thread included.
+int cinn_backend_get_num_threads();
+
+/**
+ * Run \p flambda on min(\p num_task, the number of threads) tasks and wait for all of them.
+ *
+ * The calling thread runs the task 0. A launch from inside a task, or one racing with a launch on another thread, runs
+ * as a single task on the calling thread. It returns the first nonzero value returned by the tasks, or 0.
+ */
+int cinn_backend_parallel_launch(FCINNParallelLambda flambda, void* datas, int num_task);
+}
@@ -0,0 +1,53 @@
+#include "cinn/runtime/cpu/thread_backend.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace cinn {
+namespace runtime {
+namespace cpu {
+
+TEST(thread_backend, launch) {
+  std::vector<std::atomic<int>> hits(cinn_backend_get_num_threads());
+  auto task = [](int task_id, int num_task, void* datas) {
+    auto& hits = *reinterpret_cast<std::vector<std::atomic<int>>*>(datas);
+    EXPECT_LE(num_task, hits.size());
+    hits[task_id]++;
+    return 0;
+  };
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(cinn_backend_parallel_launch(task, &hits, 1 << 20), 0);
+  }
+  for (auto& x : hits) {
+    ASSERT_EQ(x.load(), 100);
+  }
+}
+
+int CountSerialTask(int task_id, int num_task, void* datas) {
+  EXPECT_EQ(num_task, 1);
+  (*reinterpret_cast<std::atomic<int>*>(datas))++;
+  return 0;
+}
+
+TEST(thread_backend, nested_launch_runs_serially) {
+  std::atomic<int> inner_tasks{0};
+  auto outer = [](int task_id, int num_task, void* datas) {
+    return cinn_backend_parallel_launch(CountSerialTask, datas, 4);
+  };
+
+  ASSERT_EQ(cinn_backend_parallel_launch(outer, &inner_tasks, 4), 0);
+  ASSERT_EQ(inner_tasks.load(), std::min(4, cinn_backend_get_num_threads()));
+}
+
+TEST(thread_backend, return_value) {
+  auto task = [](int task_id, int num_task, void* datas) { return task_id == num_task - 1 ? 3 : 0; };
+  ASSERT_EQ(cinn_backend_parallel_launch(task, nullptr, 4), 3);
+}
+
+}  // namespace cpu
+}  // namespace runtime
+}  // namespace cinn
@@ -54,6 +54,9 @@ static const char* print_debug_args_repr = "cinn_print_debug_args";
 
 static const char* call_cuda_kernel = "cinn_call_cuda_kernel";
 
+//! Run a parallel forloop outlined to a task on the thread pool.
+static const char* parallel_launch = "cinn_backend_parallel_launch";
+
 static const char* pod_values_to_array_repr = "pod_values_to_array";
 
 static const char* get_address_repr = "get_address";
@@ -67,6 +70,12 @@ static const char* debug_log_repr = "cinn_print_debug_string";
 
 static const char* cuda_sync_threads = "__syncthreads";
 
+//! Names of the extern functions reading the cycle counters of the LoopProfiler.
+// @{
+static const char* profile_begin = "cinn_profile_begin";
+static const char* profile_end   = "cinn_profile_end";
+// @}
+
 }  // namespace intrisic
 
 /**
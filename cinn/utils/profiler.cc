@@ -0,0 +1,179 @@
+#include "cinn/utils/profiler.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+namespace cinn {
+namespace utils {
+
+namespace {
+
+const char* kNoOp = "-";
+
+thread_local std::string current_op = kNoOp;  // NOLINT
+
+std::string JsonString(const std::string& s) {
+  std::string res = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') res += '\\';
+    res += c;
+  }
+  return res + "\"";
+}
+
+void PrintPhases(std::ostream& os, const std::map<std::string, CompileProfiler::PhaseRecord>& phases) {
+  os << std::left << std::setw(40) << "phase" << std::right << std::setw(10) << "calls" << std::setw(14)
+     << "total(ms)" << std::setw(14) << "avg(ms)"
+     << "\n";
+  for (auto& [phase, record] : phases) {
+    os << std::left << std::setw(40) << phase << std::right << std::setw(10) << record.calls << std::setw(14)
+       << std::fixed << std::setprecision(3) << record.total_ms << std::setw(14) << record.total_ms / record.calls
+       << "\n";
+  }
+}
+
+void PrintCounters(std::ostream& os, const std::map<std::string, int64_t>& counters) {
+  if (counters.empty()) return;
+  os << std::left << std::setw(40) << "counter" << std::right << std::setw(10) << "total"
+     << "\n";
+  for (auto& [name, count] : counters) {
+    os << std::left << std::setw(40) << name << std::right << std::setw(10) << count << "\n";
+  }
+}
+
+}  // namespace
+
+CompileProfiler::CompileProfiler() {
+  const char* env = std::getenv("CINN_COMPILE_PROFILE");
+  if (env && *env && std::string(env) != "0") {
+    enabled_   = true;
+    json_path_ = std::string(env) == "1" ? "cinn_compile_profile.json" : env;
+  }
+}
+
+CompileProfiler::~CompileProfiler() {
+  if (json_path_.empty()) return;
+  std::cerr << SummaryTable();
+  std::ofstream os(json_path_);
+  if (os) {
+    os << ToJson();
+  } else {
+    std::cerr << "Failed to write the compile profile to " << json_path_ << std::endl;
+  }
+}
+
+CompileProfiler& CompileProfiler::Global() {
+  static CompileProfiler x;
+  return x;
+}
+
+void CompileProfiler::AddTime(const std::string& phase, double ms) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto& record = phases_[ProfileOpScope::Current()][phase];
+  record.calls++;
+  record.total_ms += ms;
+}
+
+void CompileProfiler::AddCount(const std::string& name, int64_t n) {
+  std::lock_guard<std::mutex> lock(mu_);
+  counters_[ProfileOpScope::Current()][name] += n;
+}
+
+CompileProfiler::PhaseRecord CompileProfiler::GetPhase(const std::string& op, const std::string& phase) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = phases_.find(op);
+  if (it == phases_.end() || !it->second.count(phase)) return {};
+  return it->second.at(phase);
+}
+
+int64_t CompileProfiler::GetCount(const std::string& op, const std::string& name) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = counters_.find(op);
+  if (it == counters_.end() || !it->second.count(name)) return 0;
+  return it->second.at(name);
+}
+
+void CompileProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  phases_.clear();
+  counters_.clear();
+}
+
+std::string CompileProfiler::SummaryTable() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  std::map<std::string, PhaseRecord> total_phases;
+  std::map<std::string, int64_t> total_counters;
+  for (auto& [op, phases] : phases_) {
+    for (auto& [phase, record] : phases) {
+      total_phases[phase].calls += record.calls;
+      total_phases[phase].total_ms += record.total_ms;
+    }
+  }
+  for (auto& [op, counters] : counters_) {
+    for (auto& [name, count] : counters) total_counters[name] += count;
+  }
+
+  std::stringstream os;
+  os << "======================== CINN compile profile ========================\n";
+  PrintPhases(os, total_phases);
+  PrintCounters(os, total_counters);
+
+  std::set<std::string> ops;
+  for (auto& item : phases_) ops.insert(item.first);
+  for (auto& item : counters_) ops.insert(item.first);
+  for (auto& op : ops) {
+    if (op == kNoOp) continue;
+    os << "------------------------ op [" << op << "]\n";
+    if (phases_.count(op)) PrintPhases(os, phases_.at(op));
+    if (counters_.count(op)) PrintCounters(os, counters_.at(op));
+  }
+  return os.str();
+}
+
+std::string CompileProfiler::ToJson() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  std::set<std::string> ops;
+  for (auto& item : phases_) ops.insert(item.first);
+  for (auto& item : counters_) ops.insert(item.first);
+
+  std::stringstream os;
+  os << std::fixed << std::setprecision(6);
+  os << "{\"ops\": {";
+  bool first_op = true;
+  for (auto& op : ops) {
+    os << (first_op ? "" : ", ") << JsonString(op) << ": {\"phases\": {";
+    first_op = false;
+    if (phases_.count(op)) {
+      bool first = true;
+      for (auto& [phase, record] : phases_.at(op)) {
+        os << (first ? "" : ", ") << JsonString(phase) << ": {\"calls\": " << record.calls
+           << ", \"total_ms\": " << record.total_ms << "}";
+        first = false;
+      }
+    }
+    os << "}, \"counters\": {";
+    if (counters_.count(op)) {
+      bool first = true;
+      for (auto& [name, count] : counters_.at(op)) {
+        os << (first ? "" : ", ") << JsonString(name) << ": " << count;
+        first = false;
+      }
+    }
+    os << "}}";
+  }
+  os << "}}\n";
+  return os.str();
+}
+
+ProfileOpScope::ProfileOpScope(const std::string& op) : prev_(current_op) { current_op = op; }
+
+ProfileOpScope::~ProfileOpScope() { current_op = prev_; }
+
+const std::string& ProfileOpScope::Current() { return current_op; }
+
+}  // namespace utils
+}  // namespace cinn
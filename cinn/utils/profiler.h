@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>  //NOLINT
+#include <string>
+#include <utility>
+
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace utils {
+
+/**
+ * The registry of the wall time and counters of the compile pipeline, from the graph passes to the LLVM passes.
+ *
+ * The records are grouped by op, the op being compiled on the current thread is set by `ProfileOpScope`, and the
+ * records out of any op go to the group "-". It is enabled by the environment variable `CINN_COMPILE_PROFILE`, then
+ * the summary table is printed to stderr at exit and the JSON is written to the path given by the variable, or to
+ * `cinn_compile_profile.json` if its value is "1".
+ */
+class CompileProfiler {
+ public:
+  struct PhaseRecord {
+    int64_t calls{};
+    double total_ms{};
+  };
+
+  static CompileProfiler& Global();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool x) { enabled_.store(x, std::memory_order_relaxed); }
+
+  //! Record a call of \p phase that took \p ms milliseconds.
+  void AddTime(const std::string& phase, double ms);
+  //! Increase the counter \p name by \p n.
+  void AddCount(const std::string& name, int64_t n);
+
+  //! Get the record of \p phase of \p op, "-" for the records out of any op.
+  PhaseRecord GetPhase(const std::string& op, const std::string& phase) const;
+  int64_t GetCount(const std::string& op, const std::string& name) const;
+
+  void Clear();
+
+  //! The time and counts of each phase summed over the ops, followed by the per op details.
+  std::string SummaryTable() const;
+  std::string ToJson() const;
+
+  ~CompileProfiler();
+
+ private:
+  CompileProfiler();
+
+  //! Read by every timer on the compile threads, it might be toggled by another thread.
+  std::atomic<bool> enabled_{false};
+  std::string json_path_;
+
+  mutable std::mutex mu_;
+  std::map<std::string, std::map<std::string, PhaseRecord>> phases_;
+  std::map<std::string, std::map<std::string, int64_t>> counters_;
+};
+
+//! Attribute the records made by this thread to \p op until the scope exits.
+class ProfileOpScope {
+ public:
+  explicit ProfileOpScope(const std::string& op);
+  ~ProfileOpScope();
+
+  //! The op being compiled on the current thread, "-" if none.
+  static const std::string& Current();
+
+ private:
+  std::string prev_;
+};
+
+//! Time the scope as a call of \p phase, it does nothing if the profiler is disabled.
+class ProfileTimer {
+ public:
+  explicit ProfileTimer(std::string phase) : phase_(std::move(phase)) {
+    if (CompileProfiler::Global().enabled()) {
+      enabled_ = true;
+      timer_.Start();
+    }
+  }
+  ~ProfileTimer() {
+    if (enabled_) CompileProfiler::Global().AddTime(phase_, timer_.Stop());
+  }
+
+ private:
+  std::string phase_;
+  //! Whether the timer is started, the profiler might get toggled before the scope exits.
+  bool enabled_{false};
+  Timer timer_;
+};
+
+}  // namespace utils
+}  // namespace cinn
@@ -0,0 +1,44 @@
+#include "cinn/utils/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>  //NOLINT
+
+namespace cinn {
+namespace utils {
+
+TEST(CompileProfiler, record) {
+  auto& profiler = CompileProfiler::Global();
+  profiler.set_enabled(true);
+  profiler.Clear();
+
+  {
+    ProfileOpScope op("add_0");
+    { ProfileTimer timer("lower"); }
+    { ProfileTimer timer("lower"); }
+    profiler.AddCount("ir_nodes", 10);
+    // The records of other threads are not attributed to this op.
+    std::thread([&] { profiler.AddCount("ir_nodes", 1); }).join();
+  }
+  { ProfileTimer timer("codegen"); }
+
+  ASSERT_EQ(profiler.GetPhase("add_0", "lower").calls, 2);
+  ASSERT_EQ(profiler.GetPhase("-", "codegen").calls, 1);
+  ASSERT_EQ(profiler.GetPhase("-", "lower").calls, 0);
+  ASSERT_EQ(profiler.GetCount("add_0", "ir_nodes"), 10);
+  ASSERT_EQ(profiler.GetCount("-", "ir_nodes"), 1);
+
+  auto table = profiler.SummaryTable();
+  ASSERT_NE(table.find("op [add_0]"), std::string::npos);
+  auto json = profiler.ToJson();
+  ASSERT_NE(json.find("\"add_0\": {\"phases\": {\"lower\": {\"calls\": 2"), std::string::npos);
+  ASSERT_NE(json.find("\"counters\": {\"ir_nodes\": 10}"), std::string::npos);
+
+  profiler.Clear();
+  profiler.set_enabled(false);
+  { ProfileTimer timer("codegen"); }
+  ASSERT_EQ(profiler.GetPhase("-", "codegen").calls, 0);
+}
+
+}  // namespace utils
+}  // namespace cinn
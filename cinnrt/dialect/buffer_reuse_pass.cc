@@ -0,0 +1,195 @@
+#include "cinnrt/dialect/buffer_reuse_pass.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringSet.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/Function.h>
+#include <mlir/IR/Operation.h>
+#include <mlir/IR/StandardTypes.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace cinnrt::dialect {
+
+namespace {
+
+//! The elementwise operations having the `_inplace` forms.
+const llvm::StringSet<>& GetInplaceOps() {
+  static llvm::StringSet<> ops{
+      "add", "sub", "mul", "div", "max", "min", "neg", "abs", "relu", "exp", "sqrt", "tanh", "sigmoid"};
+  return ops;
+}
+
+//! Split the name `dt.<op>.<dtype>` of a DenseTensor operation, return false for the other operations.
+bool SplitDtOpName(llvm::StringRef name, llvm::StringRef* op, llvm::StringRef* dtype) {
+  if (!name.consume_front("dt.")) return false;
+  std::tie(*op, *dtype) = name.split('.');
+  return !dtype->empty();
+}
+
+bool IsDtOp(mlir::Operation* op) { return op->getName().getStringRef().startswith("dt."); }
+
+class BufferReusePass : public mlir::PassWrapper<BufferReusePass, mlir::FunctionPass> {
+ public:
+  void runOnFunction() override {
+    tensor_type_ = mlir::OpaqueType::get(mlir::Identifier::get("t", &getContext()), "tensor", &getContext());
+    for (auto& block : getFunction().getBody()) Run(&block);
+  }
+
+ private:
+  //! A buffer allocated by `dt.create_uninit_tensor`, the capacity is in elements.
+  struct Buffer {
+    int64_t capacity;
+    std::string dtype;
+  };
+
+  void Run(mlir::Block* block) {
+    ComputeLastUses(block);
+    buffers_.clear();
+    free_buffers_.clear();
+    dying_.clear();
+
+    llvm::SmallVector<mlir::Operation*, 32> ops;
+    for (auto& op : *block) ops.push_back(&op);
+    for (auto* op : ops) {
+      int pos = positions_[op];
+      llvm::StringRef op_name, dtype;
+      if (SplitDtOpName(op->getName().getStringRef(), &op_name, &dtype)) {
+        if (op_name == "create_uninit_tensor") {
+          ReuseBuffer(op, dtype);
+        } else if (GetInplaceOps().count(op_name)) {
+          RunInplace(op, op_name, dtype, pos);
+        }
+      }
+
+      // The buffers dying at this operation are free for the following ones.
+      auto it = dying_.find(pos);
+      if (it == dying_.end()) continue;
+      for (auto value : it->second) {
+        auto& buffer = buffers_[value];
+        if (last_uses_[value] == pos) free_buffers_[buffer.dtype].emplace(buffer.capacity, value);
+      }
+      dying_.erase(it);
+    }
+  }
+
+  /**
+   * Compute the position of the last operation using each tensor. The results of the operations outside the dt
+   * dialect might alias their operands, so they extend the liveness of the operands.
+   */
+  void ComputeLastUses(mlir::Block* block) {
+    positions_.clear();
+    last_uses_.clear();
+    int pos = 0;
+    for (auto& op : *block) positions_[&op] = pos++;
+
+    // In the reverse order, so the liveness of the results is known before the operands'.
+    for (auto& op : llvm::reverse(*block)) {
+      for (mlir::Value result : op.getResults()) {
+        if (!IsTensor(result)) continue;
+        int last = positions_[&op];
+        for (auto& use : result.getUses()) {
+          auto* user = block->findAncestorOpInBlock(*use.getOwner());
+          if (!user) {
+            last = std::numeric_limits<int>::max();
+            break;
+          }
+          last = std::max(last, positions_[user]);
+          if (IsDtOp(user)) continue;
+          for (mlir::Value alias : user->getResults()) {
+            if (IsTensor(alias)) last = std::max(last, last_uses_[alias]);
+          }
+        }
+        last_uses_[result] = last;
+      }
+    }
+  }
+
+  //! Rewrite a `dt.create_uninit_tensor` into a `dt.reuse_tensor` on the best fitting dead buffer if any.
+  void ReuseBuffer(mlir::Operation* op, llvm::StringRef dtype) {
+    auto shape = op->getAttrOfType<mlir::ArrayAttr>("shape");
+    if (!shape || op->getNumResults() != 1) return;
+    int64_t numel = 1;
+    for (auto dim : shape) {
+      if (!dim.isa<mlir::IntegerAttr>()) return;
+      numel *= dim.cast<mlir::IntegerAttr>().getInt();
+    }
+
+    mlir::Value result = op->getResult(0);
+    auto& pool         = free_buffers_[dtype.str()];
+    auto it            = pool.lower_bound(numel);
+    std::string name   = ("dt.reuse_tensor." + dtype).str();
+    if (it == pool.end() || !IsRegistered(name)) {
+      buffers_[result] = Buffer{numel, dtype.str()};
+      dying_[last_uses_[result]].push_back(result);
+      return;
+    }
+
+    mlir::Value dead = it->second;
+    pool.erase(it);
+    mlir::OpBuilder builder(op);
+    mlir::OperationState state(op->getLoc(), name);
+    state.addOperands(dead);
+    state.addAttribute("shape", shape);
+    builder.createOperation(state);
+
+    result.replaceAllUsesWith(dead);
+    last_uses_[dead] = last_uses_[result];
+    dying_[last_uses_[dead]].push_back(dead);
+    op->erase();
+  }
+
+  //! Rewrite an elementwise operation into its `_inplace` form if the first operand dies at it.
+  void RunInplace(mlir::Operation* op, llvm::StringRef op_name, llvm::StringRef dtype, int pos) {
+    if (op->getNumResults() != 1 || op->getNumOperands() == 0) return;
+    mlir::Value x      = op->getOperand(0);
+    mlir::Value result = op->getResult(0);
+    if (!IsTensor(x) || !IsTensor(result) || last_uses_.lookup(x) != pos) return;
+    // Only the tensors allocated by the DenseTensor operations in this block are owned by the function.
+    auto* def = x.getDefiningOp();
+    if (!def || def->getBlock() != op->getBlock() || !IsDtOp(def)) return;
+    if (llvm::count(op->getOperands(), x) > 1) return;
+    std::string name = ("dt." + op_name + "_inplace." + dtype).str();
+    if (!IsRegistered(name)) return;
+
+    mlir::OpBuilder builder(op);
+    mlir::OperationState state(op->getLoc(), name);
+    state.addOperands(op->getOperands());
+    builder.createOperation(state);
+
+    result.replaceAllUsesWith(x);
+    last_uses_[x] = last_uses_[result];
+    if (buffers_.count(x)) dying_[last_uses_[x]].push_back(x);
+    op->erase();
+  }
+
+  bool IsTensor(mlir::Value value) const { return value.getType() == tensor_type_; }
+
+  bool IsRegistered(const std::string& name) { return mlir::AbstractOperation::lookup(name, &getContext()) != nullptr; }
+
+  mlir::Type tensor_type_;
+  llvm::DenseMap<mlir::Operation*, int> positions_;
+  llvm::DenseMap<mlir::Value, int> last_uses_;
+  llvm::DenseMap<mlir::Value, Buffer> buffers_;
+  //! The dead buffers of each data type by the capacities.
+  std::map<std::string, std::multimap<int64_t, mlir::Value>> free_buffers_;
+  //! The buffers by the positions of their last uses, the liveness grows on reusing, so the entries are checked.
+  std::map<int, llvm::SmallVector<mlir::Value, 4>> dying_;
+};
+
+}  // namespace
+
+std::unique_ptr<mlir::Pass> CreateBufferReusePass() { return std::make_unique<BufferReusePass>(); }
+
+void RegisterBufferReusePass() {
+  mlir::PassRegistration<BufferReusePass>(
+      "cinn-buffer-reuse", "Reuse the buffers of the dead DenseTensors and run the elementwise operations in place");
+}
+
+}  // namespace cinnrt::dialect
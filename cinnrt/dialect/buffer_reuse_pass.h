@@ -0,0 +1,24 @@
+#pragma once
+#include <mlir/Pass/Pass.h>
+
+#include <memory>
+
+namespace cinnrt::dialect {
+
+/**
+ * Create a pass that bounds the memory of the DenseTensors in the cinnrt functions by the liveness of the tensors:
+ *
+ * - A `dt.create_uninit_tensor` is rewritten into a `dt.reuse_tensor` on a tensor of the same data type which is dead
+ *   by then and has a buffer no smaller, the best fitting one is picked.
+ * - An elementwise operation is rewritten into its `_inplace` form writing the first operand, if the operand is a
+ *   tensor allocated in the function and dies at the operation.
+ *
+ * The rewritten operations take no results, so the executor orders them after all the readers of the tensors they
+ * write.
+ */
+std::unique_ptr<mlir::Pass> CreateBufferReusePass();
+
+//! Register the pass as `-cinn-buffer-reuse` for cinn-opt.
+void RegisterBufferReusePass();
+
+}  // namespace cinnrt::dialect
@@ -0,0 +1,37 @@
+// CHECK-LABEL: func @buffer_reuse
+func @buffer_reuse() {
+  // CHECK: %[[A:.*]] = dt.create_uninit_tensor.f32 [2{{.*}}, 3{{.*}}]
+  %a = dt.create_uninit_tensor.f32 [2:i64, 3:i64]
+  dt.fill_tensor_with_constant.f32 %a 1.0:f32
+  "dt.print_tensor"(%a) : (!t.tensor) -> ()
+
+  // %a is dead, %b takes its buffer.
+  // CHECK: dt.reuse_tensor.f32 %[[A]] {shape = [3{{.*}}, 2{{.*}}]}
+  %b = dt.create_uninit_tensor.f32 [3:i64, 2:i64]
+  // CHECK: dt.fill_tensor_with_constant.f32 %[[A]]
+  dt.fill_tensor_with_constant.f32 %b 2.0:f32
+
+  // CHECK: %[[D:.*]] = dt.create_uninit_tensor.f32 [2{{.*}}]
+  %d = dt.create_uninit_tensor.f32 [2:i64]
+  dt.fill_tensor_with_constant.f32 %d 3.0:f32
+
+  // %b dies at the add, the add runs in place on it.
+  // CHECK: dt.add_inplace.f32 %[[A]], %[[D]]
+  %c = "dt.add.f32"(%b, %d) : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: dt.print_tensor %[[A]]
+  "dt.print_tensor"(%c) : (!t.tensor) -> ()
+
+  // No dead buffer is large enough.
+  // CHECK: %[[E:.*]] = dt.create_uninit_tensor.f32 [4{{.*}}, 4{{.*}}]
+  %e = dt.create_uninit_tensor.f32 [4:i64, 4:i64]
+  dt.fill_tensor_with_constant.f32 %e 4.0:f32
+  // %d is used later, so the relu does not run in place.
+  // CHECK: dt.relu.f32 %[[D]]
+  %f = "dt.relu.f32"(%d) : (!t.tensor) -> !t.tensor
+  // CHECK: dt.add_inplace.f32 %[[E]], %[[D]]
+  %g = "dt.add.f32"(%e, %d) : (!t.tensor, !t.tensor) -> !t.tensor
+  "dt.print_tensor"(%f) : (!t.tensor) -> ()
+  "dt.print_tensor"(%g) : (!t.tensor) -> ()
+
+  cinn.return
+}
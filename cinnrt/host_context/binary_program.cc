@@ -0,0 +1,353 @@
+#include "cinnrt/host_context/binary_program.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "cinn/common/arena.h"
+#include "cinnrt/host_context/core_runtime.h"
+#include "cinnrt/host_context/kernel_frame.h"
+#include "cinnrt/host_context/kernel_registry.h"
+#include "cinnrt/host_context/op_executable.h"
+#include "cinnrt/host_context/value.h"
+
+namespace cinnrt::host_context {
+
+namespace {
+
+constexpr uint32_t kMagic   = 0x54524e43;  // "CNRT"
+constexpr uint32_t kVersion = 1;
+
+//! The types of the values in the binary program.
+enum class ValueKind : uint32_t {
+  kInt16 = 0,
+  kInt32,
+  kInt64,
+  kFloat,
+  kDouble,
+  kBool,
+  kString,
+  kTensorShape,
+  kInt16Array,
+  kInt32Array,
+  kInt64Array,
+  kFloatArray,
+  kDoubleArray,
+};
+
+void PutWord(uint32_t x, std::vector<uint32_t>* words) { words->push_back(x); }
+
+//! Put the size of \p data in bytes and the data padded to words.
+void PutBytes(const void* data, size_t size, std::vector<uint32_t>* words) {
+  PutWord(size, words);
+  size_t offset = words->size();
+  words->resize(offset + (size + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+  if (size) std::memcpy(words->data() + offset, data, size);
+}
+
+void PutString(const std::string& x, std::vector<uint32_t>* words) { PutBytes(x.data(), x.size(), words); }
+
+template <typename T>
+void PutScalar(ValueKind kind, T x, std::vector<uint32_t>* words) {
+  PutWord(static_cast<uint32_t>(kind), words);
+  PutBytes(&x, sizeof(T), words);
+}
+
+template <typename T>
+void PutArray(ValueKind kind, const std::vector<T>& x, std::vector<uint32_t>* words) {
+  PutWord(static_cast<uint32_t>(kind), words);
+  PutBytes(x.data(), x.size() * sizeof(T), words);
+}
+
+void PutValue(const Value& x, std::vector<uint32_t>* words) {
+  if (x.is_type<int16_t>()) {
+    PutScalar(ValueKind::kInt16, x.get<int16_t>(), words);
+  } else if (x.is_type<int32_t>()) {
+    PutScalar(ValueKind::kInt32, x.get<int32_t>(), words);
+  } else if (x.is_type<int64_t>()) {
+    PutScalar(ValueKind::kInt64, x.get<int64_t>(), words);
+  } else if (x.is_type<float>()) {
+    PutScalar(ValueKind::kFloat, x.get<float>(), words);
+  } else if (x.is_type<double>()) {
+    PutScalar(ValueKind::kDouble, x.get<double>(), words);
+  } else if (x.is_type<bool>()) {
+    PutScalar(ValueKind::kBool, static_cast<uint8_t>(x.get<bool>()), words);
+  } else if (x.is_type<std::string>()) {
+    PutWord(static_cast<uint32_t>(ValueKind::kString), words);
+    PutString(x.get<std::string>(), words);
+  } else if (x.is_type<TensorShape>()) {
+    auto& shape = x.get<TensorShape>();
+    std::vector<int64_t> dims;
+    for (int i = 0; i < shape.GetRank(); i++) dims.push_back(shape.GetDim(i));
+    PutArray(ValueKind::kTensorShape, dims, words);
+  } else if (x.is_type<std::vector<int16_t>>()) {
+    PutArray(ValueKind::kInt16Array, x.get<std::vector<int16_t>>(), words);
+  } else if (x.is_type<std::vector<int32_t>>()) {
+    PutArray(ValueKind::kInt32Array, x.get<std::vector<int32_t>>(), words);
+  } else if (x.is_type<std::vector<int64_t>>()) {
+    PutArray(ValueKind::kInt64Array, x.get<std::vector<int64_t>>(), words);
+  } else if (x.is_type<std::vector<float>>()) {
+    PutArray(ValueKind::kFloatArray, x.get<std::vector<float>>(), words);
+  } else if (x.is_type<std::vector<double>>()) {
+    PutArray(ValueKind::kDoubleArray, x.get<std::vector<double>>(), words);
+  } else {
+    LOG(FATAL) << "Not supported value type in the binary program";
+  }
+}
+
+//! Read the words of a binary program in place.
+class WordReader {
+ public:
+  WordReader(const char* data, size_t size) : cur_(data), end_(data + size) {}
+
+  uint32_t Word() {
+    uint32_t x;
+    std::memcpy(&x, Advance(sizeof(uint32_t)), sizeof(uint32_t));
+    return x;
+  }
+
+  //! Read the size in bytes and the data padded to words, return the data.
+  const char* Bytes(uint32_t* size) {
+    *size = Word();
+    return Advance((*size + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t));
+  }
+
+  std::string String() {
+    uint32_t size;
+    const char* data = Bytes(&size);
+    return std::string(data, size);
+  }
+
+  bool empty() const { return cur_ == end_; }
+
+ private:
+  const char* Advance(size_t size) {
+    CHECK_LE(size, static_cast<size_t>(end_ - cur_)) << "The binary program is truncated";
+    const char* p = cur_;
+    cur_ += size;
+    return p;
+  }
+
+  const char* cur_{};
+  const char* end_{};
+};
+
+template <typename T>
+Value* MakeValue(T&& x) {
+  auto* value = cinn::common::make_shared<Value>();
+  value->set(std::forward<T>(x));
+  return value;
+}
+
+template <typename T>
+T GetScalar(const char* data, uint32_t size) {
+  CHECK_EQ(size, sizeof(T)) << "The size of the value mismatches its type";
+  T x;
+  std::memcpy(&x, data, sizeof(T));
+  return x;
+}
+
+template <typename T>
+std::vector<T> GetArray(const char* data, uint32_t size) {
+  CHECK_EQ(size % sizeof(T), 0UL) << "The size of the value mismatches its type";
+  std::vector<T> x(size / sizeof(T));
+  if (size) std::memcpy(x.data(), data, size);
+  return x;
+}
+
+Value* ReadValue(WordReader* reader) {
+  auto kind = static_cast<ValueKind>(reader->Word());
+  uint32_t size;
+  const char* data = reader->Bytes(&size);
+  switch (kind) {
+    case ValueKind::kInt16:
+      return MakeValue(GetScalar<int16_t>(data, size));
+    case ValueKind::kInt32:
+      return MakeValue(GetScalar<int32_t>(data, size));
+    case ValueKind::kInt64:
+      return MakeValue(GetScalar<int64_t>(data, size));
+    case ValueKind::kFloat:
+      return MakeValue(GetScalar<float>(data, size));
+    case ValueKind::kDouble:
+      return MakeValue(GetScalar<double>(data, size));
+    case ValueKind::kBool:
+      return MakeValue(static_cast<bool>(GetScalar<uint8_t>(data, size)));
+    case ValueKind::kString:
+      return MakeValue(std::string(data, size));
+    case ValueKind::kTensorShape: {
+      auto dims = GetArray<int64_t>(data, size);
+      return MakeValue(TensorShape(llvm::ArrayRef<int64_t>(dims)));
+    }
+    case ValueKind::kInt16Array:
+      return MakeValue(GetArray<int16_t>(data, size));
+    case ValueKind::kInt32Array:
+      return MakeValue(GetArray<int32_t>(data, size));
+    case ValueKind::kInt64Array:
+      return MakeValue(GetArray<int64_t>(data, size));
+    case ValueKind::kFloatArray:
+      return MakeValue(GetArray<float>(data, size));
+    case ValueKind::kDoubleArray:
+      return MakeValue(GetArray<double>(data, size));
+    default:
+      LOG(FATAL) << "Unknown value type [" << static_cast<uint32_t>(kind) << "] in the binary program";
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+struct BinaryProgramWriter::Impl {
+  std::vector<std::string> kernels;
+  std::unordered_map<std::string, uint32_t> kernel_ids;
+  uint32_t num_functions{};
+  //! The serialized functions.
+  std::vector<uint32_t> functions;
+
+  uint32_t GetKernelId(std::string_view name) {
+    auto res = kernel_ids.try_emplace(std::string(name), kernels.size());
+    if (res.second) kernels.emplace_back(name);
+    return res.first->second;
+  }
+};
+
+BinaryProgramWriter::BinaryProgramWriter() : impl_(new Impl) {}
+
+void BinaryProgramWriter::AddFunction(const std::string& name, CoreRuntime* runtime) {
+  std::unordered_map<const Value*, uint32_t> registers;
+  // The values read before any operation writes them.
+  std::vector<const Value*> constants;
+  auto get_register = [&](const Value* value, bool is_result) {
+    CHECK(value);
+    auto res = registers.try_emplace(value, registers.size());
+    if (res.second && !is_result) constants.push_back(value);
+    return res.first->second;
+  };
+
+  std::vector<uint32_t> ops;
+  auto op_executables = runtime->GetOpExecutables();
+  for (auto* op : op_executables) {
+    auto& frame = op->frame();
+    PutWord(impl_->GetKernelId(op->name()), &ops);
+    PutWord(frame.GetNumArgs(), &ops);
+    PutWord(frame.GetNumResults(), &ops);
+    PutWord(frame.GetNumAttributes(), &ops);
+    for (int i = 0; i < frame.GetNumArgs(); i++) PutWord(get_register(frame.GetArgAt(i), false), &ops);
+    for (auto& result : frame.GetResults()) PutWord(get_register(result.get(), true), &ops);
+    for (int i = 0; i < frame.GetNumAttributes(); i++) PutValue(*frame.GetAttributeAt(i), &ops);
+  }
+
+  auto* words = &impl_->functions;
+  PutString(name, words);
+  PutWord(registers.size(), words);
+  PutWord(constants.size(), words);
+  for (auto* value : constants) {
+    PutWord(registers.at(value), words);
+    PutValue(*value, words);
+  }
+  PutWord(op_executables.size(), words);
+  words->insert(words->end(), ops.begin(), ops.end());
+  impl_->num_functions++;
+}
+
+std::string BinaryProgramWriter::Finalize() const {
+  std::vector<uint32_t> words;
+  PutWord(kMagic, &words);
+  PutWord(kVersion, &words);
+  PutWord(impl_->kernels.size(), &words);
+  PutWord(impl_->num_functions, &words);
+  for (auto& kernel : impl_->kernels) PutString(kernel, &words);
+  words.insert(words.end(), impl_->functions.begin(), impl_->functions.end());
+  return std::string(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint32_t));
+}
+
+BinaryProgramWriter::~BinaryProgramWriter() {}
+
+std::unique_ptr<BinaryProgram> BinaryProgram::Load(const char* data, size_t size, KernelRegistry* registry) {
+  CHECK(registry);
+  WordReader reader(data, size);
+  CHECK_EQ(reader.Word(), kMagic) << "Not a binary program";
+  CHECK_EQ(reader.Word(), kVersion) << "Not supported version of the binary program";
+  uint32_t num_kernels   = reader.Word();
+  uint32_t num_functions = reader.Word();
+
+  // Resolve each kernel once, the operations refer to them by the indices.
+  std::vector<std::string> kernel_names;
+  std::vector<KernelImplementation> kernels;
+  for (uint32_t i = 0; i < num_kernels; i++) {
+    kernel_names.push_back(reader.String());
+    kernels.push_back(registry->GetKernel(kernel_names.back()));
+    CHECK(kernels.back()) << "No kernel called " << kernel_names.back();
+  }
+
+  std::unique_ptr<BinaryProgram> program(new BinaryProgram);
+  // The Values are packed in an arena, like the translation from MLIR.
+  cinn::common::ArenaScope arena_scope;
+  for (uint32_t fn = 0; fn < num_functions; fn++) {
+    auto name    = reader.String();
+    auto runtime = std::make_unique<CoreRuntimeBuilder>(registry);
+    runtime->NewSymbolTable(name);
+
+    std::vector<ValueRef> registers(reader.Word());
+    uint32_t num_constants = reader.Word();
+    for (uint32_t i = 0; i < num_constants; i++) {
+      uint32_t id = reader.Word();
+      CHECK_LT(id, registers.size());
+      registers[id].Reset(ReadValue(&reader));
+    }
+    for (auto& value : registers) {
+      if (!value.get()) value.Reset(cinn::common::make_shared<Value>());
+    }
+    auto get_register = [&](uint32_t id) {
+      CHECK_LT(id, registers.size()) << "Invalid register in the binary program";
+      return registers[id].get();
+    };
+
+    uint32_t num_ops = reader.Word();
+    for (uint32_t i = 0; i < num_ops; i++) {
+      uint32_t kernel_id = reader.Word();
+      CHECK_LT(kernel_id, kernels.size()) << "Invalid kernel in the binary program";
+      uint32_t num_args    = reader.Word();
+      uint32_t num_results = reader.Word();
+      uint32_t num_attrs   = reader.Word();
+
+      auto* op = runtime->NewOpExecutable(kernel_names[kernel_id], name, kernels[kernel_id]);
+      for (uint32_t j = 0; j < num_args; j++) op->AppendArgument(get_register(reader.Word()));
+      std::vector<Value*> results;
+      for (uint32_t j = 0; j < num_results; j++) results.push_back(get_register(reader.Word()));
+      op->SetResults(results);
+      for (uint32_t j = 0; j < num_attrs; j++) op->AppendAttribute(ReadValue(&reader));
+    }
+
+    program->function_names_.push_back(std::move(name));
+    program->functions_.push_back(std::move(runtime));
+  }
+  CHECK(reader.empty()) << "Unexpected data after the binary program";
+  return program;
+}
+
+std::unique_ptr<BinaryProgram> BinaryProgram::LoadFile(const std::string& path, KernelRegistry* registry) {
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Failed to open " << path;
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Failed to stat " << path;
+  size_t size = st.st_size;
+  CHECK_GT(size, 0UL) << "Empty binary program " << path;
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  CHECK(data != MAP_FAILED) << "Failed to map " << path;
+  auto program = Load(static_cast<const char*>(data), size, registry);
+  munmap(data, size);
+  return program;
+}
+
+CoreRuntime* BinaryProgram::function(int i) const { return functions_.at(i).get(); }
+
+BinaryProgram::~BinaryProgram() {}
+
+}  // namespace cinnrt::host_context
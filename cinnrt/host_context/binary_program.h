@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cinnrt::host_context {
+
+class CoreRuntime;
+class CoreRuntimeBuilder;
+class KernelRegistry;
+
+/**
+ * The binary program is a flat serialization of the translated functions, it is loaded by resolving a kernel table and
+ * filling the registers, without parsing and translating the MLIR again.
+ *
+ * All the fields are little endian 32-bit words, so a file can be mapped and read in place:
+ *
+ * - header: magic, version, number of kernels, number of functions.
+ * - kernel: the name, the kernels are resolved once by name in the KernelRegistry on loading.
+ * - function: the name, the number of registers, the constants and the operations.
+ * - constant: the register, the value.
+ * - operation: the kernel index, the numbers of the arguments, the results and the attributes, the registers of the
+ *   arguments and the results, the values of the attributes.
+ * - value: the type, the size of the payload in bytes, the payload padded to words.
+ * - string: the length, the characters padded to words.
+ *
+ * The registers are the Values of a function, a register holding a constant is initialized on loading.
+ */
+class BinaryProgramWriter {
+ public:
+  BinaryProgramWriter();
+
+  /**
+   * Append a function.
+   * @param name The name of the function.
+   * @param runtime The CoreRuntime translated from the function.
+   */
+  void AddFunction(const std::string& name, CoreRuntime* runtime);
+
+  //! Get the serialized program.
+  std::string Finalize() const;
+
+  ~BinaryProgramWriter();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * A program loaded from the binary format, its functions are ready to execute.
+ */
+class BinaryProgram {
+ public:
+  /**
+   * Load a program.
+   * @param data The serialized program, it is not referenced after loading.
+   * @param size The size of \p data in bytes.
+   * @param registry The registry to resolve the kernels in.
+   */
+  static std::unique_ptr<BinaryProgram> Load(const char* data, size_t size, KernelRegistry* registry);
+
+  //! Load a program from the file \p path by mapping it.
+  static std::unique_ptr<BinaryProgram> LoadFile(const std::string& path, KernelRegistry* registry);
+
+  size_t num_functions() const { return functions_.size(); }
+  const std::string& function_name(int i) const { return function_names_.at(i); }
+  CoreRuntime* function(int i) const;
+
+  ~BinaryProgram();
+
+ private:
+  BinaryProgram() = default;
+
+  std::vector<std::string> function_names_;
+  std::vector<std::unique_ptr<CoreRuntimeBuilder>> functions_;
+};
+
+}  // namespace cinnrt::host_context
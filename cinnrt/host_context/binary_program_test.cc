@@ -0,0 +1,95 @@
+#include "cinnrt/host_context/binary_program.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "cinnrt/host_context/core_runtime.h"
+#include "cinnrt/host_context/kernel_registry.h"
+#include "cinnrt/host_context/kernel_utils.h"
+#include "cinnrt/host_context/op_executable.h"
+#include "cinnrt/host_context/symbol_table.h"
+
+namespace cinnrt::host_context {
+
+int add(int a, int b) { return a + b; }
+int scale(int a, Attribute<int> factor) { return a * factor.get(); }
+int numel(const TensorShape& shape) { return shape.GetNumElements(); }
+
+void RegisterTestKernels(KernelRegistry* registry) {
+  registry->AddKernel("cinn.test.addi32", CINN_KERNEL(add));
+  registry->AddKernel("cinn.test.scalei32", CINN_KERNEL(scale));
+  registry->AddKernel("cinn.test.numel", CINN_KERNEL(numel));
+}
+
+// e = (a + b) * 3 + numel(s)
+std::string BuildProgram(KernelRegistry* registry) {
+  CoreRuntimeBuilder builder(registry);
+  auto* table = builder.NewSymbolTable("main");
+  table->Register("a", 1);
+  table->Register("b", 2);
+  int64_t dims[] = {3, 4};
+  table->Register("s")->set(TensorShape(llvm::ArrayRef<int64_t>(dims)));
+
+  auto* op0 = builder.NewOpExecutable("cinn.test.addi32", "main");
+  op0->AppendArgument("a");
+  op0->AppendArgument("b");
+  op0->SetResults({"c"});
+
+  auto* op1 = builder.NewOpExecutable("cinn.test.scalei32", "main");
+  op1->AppendArgument("c");
+  op1->SetResults({"d"});
+  op1->AppendAttribute(new Value(3));
+
+  auto* op2 = builder.NewOpExecutable("cinn.test.numel", "main");
+  op2->AppendArgument("s");
+  op2->SetResults({"n"});
+
+  auto* op3 = builder.NewOpExecutable("cinn.test.addi32", "main");
+  op3->AppendArgument("d");
+  op3->AppendArgument("n");
+  op3->SetResults({"e"});
+
+  BinaryProgramWriter writer;
+  writer.AddFunction("main", &builder);
+  return writer.Finalize();
+}
+
+TEST(BinaryProgram, basic) {
+  KernelRegistry registry;
+  RegisterTestKernels(&registry);
+  auto data = BuildProgram(&registry);
+
+  auto program = BinaryProgram::Load(data.data(), data.size(), &registry);
+  ASSERT_EQ(program->num_functions(), 1UL);
+  ASSERT_EQ(program->function_name(0), "main");
+
+  auto* runtime = program->function(0);
+  auto ops      = runtime->GetOpExecutables();
+  ASSERT_EQ(ops.size(), 4UL);
+  ASSERT_EQ(ops[1]->name(), "cinn.test.scalei32");
+  for (int i = 0; i < 2; i++) {
+    runtime->Execute();
+    ASSERT_EQ(ops[3]->frame().GetResults()[0].get<int>(), 21);
+  }
+  // The registers are shared by the operations.
+  ASSERT_EQ(ops[0]->frame().GetResults()[0].get(), ops[1]->frame().GetArgAt(0));
+}
+
+TEST(BinaryProgram, load_file) {
+  KernelRegistry registry;
+  RegisterTestKernels(&registry);
+  auto data = BuildProgram(&registry);
+
+  std::string path = "binary_program_test.cnrt";
+  std::ofstream(path, std::ios::binary) << data;
+  auto program = BinaryProgram::LoadFile(path, &registry);
+  std::remove(path.c_str());
+
+  program->function(0)->Execute();
+  ASSERT_EQ(program->function(0)->GetOpExecutables()[3]->frame().GetResults()[0].get<int>(), 21);
+}
+
+}  // namespace cinnrt::host_context
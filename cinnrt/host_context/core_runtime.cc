@@ -1,19 +1,85 @@
 #include "cinnrt/host_context/core_runtime.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "cinnrt/host_context/kernel_frame.h"
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/op_executable.h"
 #include "cinnrt/host_context/symbol_table.h"
+#include "cinnrt/host_context/thread_pool.h"
 
 namespace cinnrt::host_context {
 
+namespace {
+
+//! An operation in the dependency graph of a program.
+struct OpNode {
+  std::vector<int> successors;
+  int num_predecessors{};
+};
+
+/**
+ * Build the dependency graph of the operations in the program order. The operations without results might write their
+ * arguments, the other ones write their results only.
+ */
+std::vector<OpNode> BuildDependencies(std::vector<OpExecutableBuilder>* ops) {
+  std::vector<OpNode> nodes(ops->size());
+  std::unordered_map<const Value*, int> last_writers;
+  std::unordered_map<const Value*, std::vector<int>> readers_since_write;
+  int last_side_effect = -1;
+
+  for (int id = 0; id < ops->size(); id++) {
+    auto& frame = (*ops)[id].frame();
+    std::set<int> predecessors;
+    std::vector<const Value*> reads, writes;
+    for (int i = 0; i < frame.GetNumArgs(); i++) reads.push_back(frame.GetArgAt(i));
+    for (auto& result : frame.GetResults()) writes.push_back(result.get());
+    bool side_effect = writes.empty();
+    if (side_effect) {
+      writes = reads;
+      if (last_side_effect >= 0) predecessors.insert(last_side_effect);
+      last_side_effect = id;
+    }
+
+    for (auto* value : reads) {
+      auto it = last_writers.find(value);
+      if (it != last_writers.end()) predecessors.insert(it->second);
+      readers_since_write[value].push_back(id);
+    }
+    for (auto* value : writes) {
+      auto it = last_writers.find(value);
+      if (it != last_writers.end()) predecessors.insert(it->second);
+      auto& readers = readers_since_write[value];
+      predecessors.insert(readers.begin(), readers.end());
+      readers.clear();
+      last_writers[value] = id;
+    }
+
+    predecessors.erase(id);
+    nodes[id].num_predecessors = predecessors.size();
+    for (int predecessor : predecessors) nodes[predecessor].successors.push_back(id);
+  }
+  return nodes;
+}
+
+}  // namespace
+
 struct CoreRuntime::Impl {
   KernelRegistry* kernel_registry{};
   std::unordered_map<std::string /*function name*/, SymbolTable> symbol_tables;
   std::vector<OpExecutableBuilder> op_executables;
+  //! The dependency graph of `op_executables`, built on the first parallel execution.
+  std::vector<OpNode> op_nodes;
+  std::mutex op_nodes_mu;
 };
 
 SymbolTable* CoreRuntime::GetSymbolTable(const std::string& fn_name) {
@@ -21,6 +87,12 @@ SymbolTable* CoreRuntime::GetSymbolTable(const std::string& fn_name) {
   return it != impl_->symbol_tables.end() ? &it->second : nullptr;
 }
 
+std::vector<OpExecutable*> CoreRuntime::GetOpExecutables() {
+  std::vector<OpExecutable*> ops;
+  for (auto& op : impl_->op_executables) ops.push_back(&op);
+  return ops;
+}
+
 CoreRuntime::CoreRuntime(CoreRuntime::Impl* impl) : impl_(impl) {}
 
 void CoreRuntime::Execute() {
@@ -29,6 +101,61 @@ void CoreRuntime::Execute() {
   }
 }
 
+void CoreRuntime::Execute(ThreadPool* pool) {
+  CHECK(pool);
+  auto& ops = impl_->op_executables;
+  if (ops.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(impl_->op_nodes_mu);
+    if (impl_->op_nodes.size() != ops.size()) impl_->op_nodes = BuildDependencies(&ops);
+  }
+  const auto& nodes = impl_->op_nodes;
+
+  // The states of an execution, the last operation completing notifies the caller.
+  struct Execution {
+    std::unique_ptr<std::atomic<int>[]> num_pending;
+    std::atomic<int> num_remaining;
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done{false};
+  } execution;
+  execution.num_pending.reset(new std::atomic<int>[ops.size()]);
+  for (int id = 0; id < ops.size(); id++) execution.num_pending[id] = nodes[id].num_predecessors;
+  execution.num_remaining = ops.size();
+
+  std::function<void(int)> launch = [&](int id) {
+    pool->Schedule([&, id] {
+      ops[id].ExecuteAsync([&, id] {
+        for (int successor : nodes[id].successors) {
+          if (--execution.num_pending[successor] == 0) launch(successor);
+        }
+        if (--execution.num_remaining == 0) {
+          std::lock_guard<std::mutex> lock(execution.mu);
+          execution.done = true;
+          execution.cv.notify_one();
+        }
+      });
+    });
+  };
+  for (int id = 0; id < ops.size(); id++) {
+    if (nodes[id].num_predecessors == 0) launch(id);
+  }
+
+  std::unique_lock<std::mutex> lock(execution.mu);
+  if (!pool->InWorkerThread()) {
+    execution.cv.wait(lock, [&] { return execution.done; });
+    return;
+  }
+  // Blocking a worker might leave no thread to run the operations, so it runs the pending tasks while waiting, and
+  // polls for the asynchronous kernels completing on the other threads.
+  while (!execution.done) {
+    lock.unlock();
+    bool ran = pool->TryRunTask();
+    lock.lock();
+    if (!ran) execution.cv.wait_for(lock, std::chrono::microseconds(100), [&] { return execution.done; });
+  }
+}
+
 CoreRuntimeBuilder::CoreRuntimeBuilder(KernelRegistry* kernel_registry) : CoreRuntime(new Impl) {
   impl_->kernel_registry = kernel_registry ? kernel_registry : GetCpuKernelRegistry();
 }
@@ -37,8 +164,10 @@ SymbolTable* CoreRuntimeBuilder::NewSymbolTable(std::string_view fn_name) {
   return &impl_->symbol_tables.try_emplace(std::string(fn_name)).first->second;
 }
 
-OpExecutableBuilder* CoreRuntimeBuilder::NewOpExecutable(std::string_view op_name, const std::string& fn_name) {
-  impl_->op_executables.emplace_back(op_name, GetSymbolTable(fn_name), impl_->kernel_registry);
+OpExecutableBuilder* CoreRuntimeBuilder::NewOpExecutable(std::string_view op_name,
+                                                        const std::string& fn_name,
+                                                        KernelImplementation kernel_impl) {
+  impl_->op_executables.emplace_back(op_name, GetSymbolTable(fn_name), impl_->kernel_registry, kernel_impl);
   return &impl_->op_executables.back();
 }
 
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cinnrt::host_context {
 
@@ -10,6 +11,9 @@ class KernelRegistry;
 class OpExecutable;
 class OpExecutableBuilder;
 class SymbolTable;
+class ThreadPool;
+class KernelFrame;
+using KernelImplementation = void (*)(KernelFrame* frame);
 
 /**
  * CoreRuntime encapsulate the runtime facilities.
@@ -19,9 +23,24 @@ class CoreRuntime {
   //! Execute a program.
   void Execute();
 
+  /**
+   * Execute a program on \p pool and wait for it to complete.
+   *
+   * An operation is scheduled as soon as the values it reads are ready, so the independent branches of the program
+   * overlap. A value is ready once the last operation writing it before the reader in the program order completes. The
+   * operations without results are taken as side effects, they might modify their arguments in place and run in the
+   * program order among themselves.
+   *
+   * It can be called from a task of \p pool, then the calling worker runs the pending tasks of the pool while waiting.
+   */
+  void Execute(ThreadPool* pool);
+
   //! Get a SymbolTable bound to a function.
   SymbolTable* GetSymbolTable(const std::string& fn_name);
 
+  //! Get the operations of the program in order.
+  std::vector<OpExecutable*> GetOpExecutables();
+
   ~CoreRuntime();
 
  protected:
@@ -41,7 +60,15 @@ class CoreRuntimeBuilder : public CoreRuntime {
 
   llvm::ArrayRef<std::string_view> attr_names() const;
 
-  OpExecutableBuilder* NewOpExecutable(std::string_view op_name, const std::string& fn_name);
+  /**
+   * Append an operation to the function \p fn_name.
+   * @param op_name The name of the operation.
+   * @param fn_name The name of the function.
+   * @param kernel_impl The kernel resolved already, looked up by \p op_name if null.
+   */
+  OpExecutableBuilder* NewOpExecutable(std::string_view op_name,
+                                       const std::string& fn_name,
+                                       KernelImplementation kernel_impl = nullptr);
 };
 
 }  // namespace cinnrt::host_context
@@ -2,16 +2,35 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/kernel_utils.h"
 #include "cinnrt/host_context/op_executable.h"
 #include "cinnrt/host_context/symbol_table.h"
+#include "cinnrt/host_context/thread_pool.h"
 
 namespace cinnrt {
 namespace host_context {
 
 int add(int a, int b) { return a + b; }
 int sub(int a, int b) { return a - b; }
+int inc(int a) { return a + 1; }
+
+// Add on another thread and complete asynchronously.
+void async_add(KernelFrame* frame) {
+  int a     = frame->GetArgAt<int>(0);
+  int b     = frame->GetArgAt<int>(1);
+  auto done = frame->TakeAsyncDone();
+  std::thread([=] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    frame->SetResultAt(0, a + b);
+    done();
+  }).detach();
+}
 
 TEST(CoreRuntime, basic) {
   KernelRegistry registry;
@@ -44,5 +63,87 @@ TEST(CoreRuntime, basic) {
   ASSERT_EQ(table->Get("e")->get<int>(), -1);
 }
 
+TEST(CoreRuntime, parallel) {
+  KernelRegistry registry;
+  registry.AddKernel("cinn.test.addi32", CINN_KERNEL(add));
+  registry.AddKernel("cinn.test.subi32", CINN_KERNEL(sub));
+  registry.AddKernel("cinn.test.async_addi32", async_add);
+
+  CoreRuntimeBuilder builder(&registry);
+  auto* table = builder.NewSymbolTable("main");
+  table->Register("a", 1);
+  table->Register("b", 2);
+
+  // Two independent branches joined by the last operation.
+  // c = a + b, d = async(a + a), e = async(c + b), f = d - e
+  auto* op0 = builder.NewOpExecutable("cinn.test.addi32", "main");
+  op0->AppendArgument("a");
+  op0->AppendArgument("b");
+  op0->SetResults({"c"});
+
+  auto* op1 = builder.NewOpExecutable("cinn.test.async_addi32", "main");
+  op1->AppendArgument("a");
+  op1->AppendArgument("a");
+  op1->SetResults({"d"});
+
+  auto* op2 = builder.NewOpExecutable("cinn.test.async_addi32", "main");
+  op2->AppendArgument("c");
+  op2->AppendArgument("b");
+  op2->SetResults({"e"});
+
+  auto* op3 = builder.NewOpExecutable("cinn.test.subi32", "main");
+  op3->AppendArgument("d");
+  op3->AppendArgument("e");
+  op3->SetResults({"f"});
+
+  ThreadPool pool(4);
+  for (int i = 0; i < 10; i++) {
+    builder.Execute(&pool);
+    ASSERT_EQ(table->Get("c")->get<int>(), 3);
+    ASSERT_EQ(table->Get("d")->get<int>(), 2);
+    ASSERT_EQ(table->Get("e")->get<int>(), 5);
+    ASSERT_EQ(table->Get("f")->get<int>(), -3);
+  }
+
+  // Called from the only worker of a pool.
+  ThreadPool single_pool(1);
+  std::atomic<bool> done{false};
+  single_pool.Schedule([&] {
+    builder.Execute(&single_pool);
+    done = true;
+  });
+  while (!done) std::this_thread::yield();
+  ASSERT_EQ(table->Get("f")->get<int>(), -3);
+
+  // The sequential execution waits for the asynchronous kernels too.
+  builder.Execute();
+  ASSERT_EQ(table->Get("f")->get<int>(), -3);
+}
+
+// A chain of tiny kernels, x_{i+1} = x_i + 1. The results are written to the same Values in each execution.
+TEST(CoreRuntime, chain) {
+  KernelRegistry registry;
+  registry.AddKernel("cinn.test.inci32", CINN_KERNEL(inc));
+
+  const int num_ops = 100;
+  CoreRuntimeBuilder builder(&registry);
+  auto* table = builder.NewSymbolTable("main");
+  table->Register("x0", 0);
+  for (int i = 0; i < num_ops; i++) {
+    auto* op = builder.NewOpExecutable("cinn.test.inci32", "main");
+    op->AppendArgument("x" + std::to_string(i));
+    op->SetResults({"x" + std::to_string(i + 1)});
+  }
+  auto* result = table->Get("x" + std::to_string(num_ops));
+
+  ThreadPool pool(2);
+  for (int i = 0; i < 3; i++) {
+    builder.Execute();
+    ASSERT_EQ(result->get<int>(), num_ops);
+    builder.Execute(&pool);
+    ASSERT_EQ(result->get<int>(), num_ops);
+  }
+}
+
 }  // namespace host_context
 }  // namespace cinnrt
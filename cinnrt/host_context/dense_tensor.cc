@@ -11,6 +11,12 @@ DenseTensor::DenseTensor(const TensorShape& shape, const cinn_type_t& dtype, Dev
 }
 
 const TensorShape& DenseTensor::shape() const { return shape_; }
+
+void DenseTensor::Reshape(const TensorShape& shape) {
+  shape_ = shape;
+  buffer_->ResizeLazy(dtype_.bytes() * shape.GetNumElements());
+}
+
 const cinn::hlir::framework::Buffer* DenseTensor::buffer() const { return buffer_.get(); }
 
 template <typename T>
@@ -50,4 +56,6 @@ DenseTensor::~DenseTensor() {}
 
 void* DenseTensor::data() const { return buffer_->data()->memory; }
 
+cinn_buffer_t* DenseTensor::cinn_buffer() const { return buffer_->data(); }
+
 }  // namespace cinnrt::host_context
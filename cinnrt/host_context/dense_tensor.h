@@ -26,8 +26,16 @@ class DenseTensor {
 
   const TensorShape& shape() const;
 
+  //! Reset the shape, the buffer is kept if it is large enough.
+  void Reshape(const TensorShape& shape);
+
+  const cinn_type_t& dtype() const { return dtype_; }
+
   const cinn::hlir::framework::Buffer* buffer() const;
 
+  //! The runtime buffer to pass to the CINN compiled functions, it shares the memory with this tensor.
+  cinn_buffer_t* cinn_buffer() const;
+
   void* data() const;
 
   friend std::ostream& operator<<(std::ostream& os, const DenseTensor& instance);
@@ -0,0 +1,61 @@
+// Measure the dispatch overhead of the runtime by a chain of tiny kernels, x_{i+1} = x_i + 1.
+#include <glog/logging.h>
+#include <llvm/Support/CommandLine.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "cinn/utils/timer.h"
+#include "cinnrt/host_context/core_runtime.h"
+#include "cinnrt/host_context/kernel_registry.h"
+#include "cinnrt/host_context/kernel_utils.h"
+#include "cinnrt/host_context/op_executable.h"
+#include "cinnrt/host_context/symbol_table.h"
+#include "cinnrt/host_context/thread_pool.h"
+
+namespace {
+int inc(int a) { return a + 1; }
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace llvm;                   // NOLINT
+  using namespace cinnrt::host_context;  // NOLINT
+  cl::opt<int> num_ops("num-ops", cl::desc("The length of the chain"), cl::init(1000));
+  cl::opt<int> repeat("repeat", cl::desc("The number of the timed executions"), cl::init(1000));
+  cl::opt<int> num_threads(
+      "j", cl::desc("Execute on a thread pool too"), cl::value_desc("number of threads"), cl::init(0));
+  cl::ParseCommandLineOptions(argc, argv);
+
+  KernelRegistry registry;
+  registry.AddKernel("cinn.test.inci32", CINN_KERNEL(inc));
+
+  CoreRuntimeBuilder builder(&registry);
+  auto* table = builder.NewSymbolTable("main");
+  table->Register("x0", 0);
+  for (int i = 0; i < num_ops; i++) {
+    auto* op = builder.NewOpExecutable("cinn.test.inci32", "main");
+    op->AppendArgument("x" + std::to_string(i));
+    op->SetResults({"x" + std::to_string(i + 1)});
+  }
+  auto* result = table->Get("x" + std::to_string(num_ops));
+
+  auto measure = [&](const std::string& name, ThreadPool* pool) {
+    auto execute = [&] { pool ? builder.Execute(pool) : builder.Execute(); };
+    // Warm up, the first execution allocates the results.
+    execute();
+    CHECK_EQ(result->get<int>(), num_ops);
+    cinn::utils::Timer timer;
+    timer.Start();
+    for (int i = 0; i < repeat; i++) execute();
+    float ms = timer.Stop();
+    std::cout << name << ": " << ms * 1e6 / (repeat * num_ops) << " ns per kernel" << std::endl;
+  };
+
+  measure("sequential", nullptr);
+  if (num_threads > 0) {
+    ThreadPool pool(num_threads);
+    measure("thread pool of " + std::to_string(num_threads), &pool);
+  }
+  return 0;
+}
@@ -2,6 +2,8 @@
 #include <glog/logging.h>
 #include <llvm/ADT/ArrayRef.h>
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "cinn/utils/small_vector.h"
@@ -16,6 +18,7 @@ class KernelFrame {
  public:
   int GetNumArgs() const { return num_arguments_; }
   int GetNumResults() const { return num_results_; }
+  int GetNumAttributes() const { return value_or_attrs_.size() - num_arguments_ - std::max(num_results_, 0); }
 
   template <typename T>
   T& GetArgAt(int index) {
@@ -54,11 +57,13 @@ class KernelFrame {
     SetResultAt(index, T(std::forward<Args>(args)...));
   }
 
+  //! Set the result \p index, the Value of the result is allocated on the first call and reused by the later ones.
   template <typename T>
   void SetResultAt(int index, T&& value) {
     CHECK_LT(index, num_results_) << "Invalid result index";
-    CHECK(value_or_attrs_[num_arguments_ + index].get());
-    value_or_attrs_[num_arguments_ + index]->set(std::move(value));
+    auto& result = value_or_attrs_[num_arguments_ + index];
+    if (!result.get()) result.Reset(cinn::common::make_shared<Value>());
+    result->set(std::move(value));
   }
 
   llvm::ArrayRef<ValueRef> GetResults() const { return GetValues(num_arguments_, num_results_); }
@@ -77,10 +82,27 @@ class KernelFrame {
     return llvm::makeMutableArrayRef(&value_or_attrs_[from], length);
   }
 
+  /**
+   * Take over the completion of the kernel invocation. The results are ready only after the returned callback is
+   * called, which might happen on another thread after the kernel returns. The kernels not calling this complete on
+   * return.
+   */
+  const std::function<void()>& TakeAsyncDone() {
+    CHECK(done_) << "The kernel is invoked without a completion callback";
+    is_async_ = true;
+    return done_;
+  }
+
+  bool is_async() const { return is_async_; }
+
  protected:
   int num_arguments_{};
   int num_results_{-1};
 
+  //! The callback to signal the completion of an asynchronous invocation.
+  std::function<void()> done_;
+  bool is_async_{false};
+
   llvm::SmallVector<ValueRef, 8> value_or_attrs_;
   llvm::SmallVector<ValueRef, 4> attrs_;
 };
@@ -93,13 +115,12 @@ class KernelFrameBuilder : public KernelFrame {
     ++num_arguments_;
   }
 
+  //! Reserve \p n result slots, they are either bound to Values by SetResultAt or allocated on the first write.
   void SetNumResults(size_t n) {
     CHECK_EQ(num_arguments_, value_or_attrs_.size());
     CHECK_EQ(num_results_, -1);
     num_results_ = n;
-    for (int i = 0; i < n; i++) {
-      value_or_attrs_.emplace_back(new Value);
-    }
+    value_or_attrs_.resize(num_arguments_ + n);
   }
 
   void SetResultAt(int result_id, Value* value) {
@@ -109,6 +130,15 @@ class KernelFrameBuilder : public KernelFrame {
     value_or_attrs_[num_arguments_ + result_id].Reset(value);
   }
 
+  //! Prepare for an invocation completing by \p done.
+  void SetDone(std::function<void()> done) {
+    done_     = std::move(done);
+    is_async_ = false;
+  }
+
+  //! Signal the completion of a synchronous invocation.
+  void Done() const { done_(); }
+
   void Reset() {
     value_or_attrs_.clear();
     num_arguments_ = 0;
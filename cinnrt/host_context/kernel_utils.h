@@ -3,6 +3,7 @@
 #include <glog/logging.h>
 #include <llvm/ADT/ArrayRef.h>
 
+#include <functional>
 #include <utility>
 
 #include "cinnrt/host_context/kernel_frame.h"
@@ -14,15 +15,15 @@ namespace host_context {
 template <typename T>
 class Argument {
  public:
-  explicit Argument(ValueRef value) : value_(value) {}
+  explicit Argument(Value* value) : value_(value) {}
 
-  ValueRef& value() { return value_; }
-  const ValueRef& value() const { return value_; }
+  Value* value() const { return value_; }
 
-  T& get() const { return value_.get<T>(); }
+  T& get() const { return value_->get<T>(); }
 
  private:
-  ValueRef value_;
+  // Not counted, the frame holds the reference during the call.
+  Value* value_{};
 };
 
 class RemainingArguments {
@@ -51,7 +52,7 @@ class Result {
 
   void Set(Argument<T> argument) {
     CHECK(!result_->IsValid());
-    *result_ = argument.value();
+    *result_ = ValueRef(argument.value());
   }
 
  private:
@@ -69,6 +70,21 @@ class Attribute {
   const Value* value_;
 };
 
+/**
+ * The completion of an asynchronous kernel. A kernel taking it might return before setting its results, and should call
+ * it once they are set.
+ */
+class AsyncDone {
+ public:
+  explicit AsyncDone(std::function<void()> done) : done_(std::move(done)) {}
+
+  void operator()() const { done_(); }
+
+ private:
+  // A copy, the frame might be reused for the next invocation once it is called.
+  std::function<void()> done_;
+};
+
 template <typename ViewT>
 class ArgumentView {
   using UnderlyingT = typename ViewT::UnderlyingT;
@@ -165,6 +181,16 @@ struct KernelImpl<Return (*)(Args...), impl_fn> {
     }
   };
 
+  // Specialization to pass the completion callback of an asynchronous kernel.
+  template <typename... Tail>
+  struct KernelCallHelper<AsyncDone, Tail...> {
+    template <int in_idx, int out_idx, int const_idx, typename... PreviousArgs>
+    static void Invoke(KernelFrame* frame, const PreviousArgs&... pargs) {
+      AsyncDone arg(frame->TakeAsyncDone());
+      KernelCallHelper<Tail...>::template Invoke<in_idx, out_idx, const_idx>(frame, pargs..., arg);
+    }
+  };
+
   // Treat other pointer as an Argument.
   template <typename Head, typename... Tail>
   struct KernelCallHelper<Head*, Tail...> {
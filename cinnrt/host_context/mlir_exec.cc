@@ -1,32 +1,80 @@
+#include <glog/logging.h>
 #include <llvm/Support/CommandLine.h>
+#include <mlir/Pass/PassManager.h>
 
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
+#include "cinnrt/dialect/buffer_reuse_pass.h"
 #include "cinnrt/dialect/mlir_loader.h"
+#include "cinnrt/host_context/binary_program.h"
 #include "cinnrt/host_context/core_runtime.h"
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/mlir_to_runtime_translate.h"
+#include "cinnrt/host_context/thread_pool.h"
 #include "cinnrt/kernel/basic_kernels.h"
+#include "cinnrt/kernel/cinn_kernels.h"
 #include "cinnrt/kernel/tensor_kernels.h"
+#include "cinnrt/kernel/tensor_math_kernels.h"
 #include "cinnrt/kernel/tensor_shape_kernels.h"
 
 int main(int argc, char** argv) {
   using namespace llvm;    // NOLINT
   using namespace cinnrt;  // NOLINT
   cl::opt<std::string> input_file("i", cl::desc("Specify input filename"), cl::value_desc("input file name"));
+  cl::opt<int> num_threads(
+      "j", cl::desc("Execute the independent operations on a thread pool"), cl::value_desc("number of threads"));
+  cl::opt<std::string> output_file("o",
+                                   cl::desc("Write the program in the binary format instead of executing it"),
+                                   cl::value_desc("output file name"));
+  cl::opt<bool> binary_input("binary", cl::desc("The input file is a program in the binary format"));
+  cl::opt<bool> buffer_reuse("buffer-reuse", cl::desc("Reuse the buffers of the dead tensors and run in place"));
   cl::ParseCommandLineOptions(argc, argv);
 
-  mlir::MLIRContext context;
-  auto module = dialect::LoadMlirFile(input_file.c_str(), &context);
-
   host_context::KernelRegistry registry;
 
   kernel::RegisterBasicKernels(&registry);
   kernel::RegisterTensorShapeKernels(&registry);
   kernel::RegisterTensorKernels(&registry);
+  kernel::RegisterCinnKernels(&registry);
+  kernel::RegisterTensorMathKernels(&registry);
+
+  std::unique_ptr<host_context::ThreadPool> pool;
+  if (num_threads > 0) pool.reset(new host_context::ThreadPool(num_threads));
+
+  if (binary_input) {
+    auto program = host_context::BinaryProgram::LoadFile(input_file, &registry);
+    for (int i = 0; i < program->num_functions(); i++) {
+      // print the function name for llvm FileChecker macro, CHECK-LABEL
+      std::cout << program->function_name(i) << std::endl;
+      if (pool) {
+        program->function(i)->Execute(pool.get());
+      } else {
+        program->function(i)->Execute();
+      }
+    }
+    std::cout << std::endl;
+    return 0;
+  }
+
+  mlir::MLIRContext context;
+  auto module = dialect::LoadMlirFile(input_file.c_str(), &context);
+  if (buffer_reuse) {
+    mlir::PassManager pm(&context);
+    pm.addNestedPass<mlir::FuncOp>(dialect::CreateBufferReusePass());
+    CHECK(mlir::succeeded(pm.run(module.get()))) << "Failed to reuse the buffers";
+  }
+
+  if (!output_file.empty()) {
+    std::ofstream os(output_file, std::ios::binary);
+    os << host_context::MlirToBinaryProgram(module.get(), &registry);
+    CHECK(os.good()) << "Failed to write " << output_file;
+    return 0;
+  }
 
-  host_context::ExecuteMlir(module.get(), &registry);
+  host_context::ExecuteMlir(module.get(), &registry, pool.get());
 
   std::cout << std::endl;
   return 0;
@@ -0,0 +1,26 @@
+// CHECK-LABEL: buffer_reuse
+func @buffer_reuse() {
+  %a = dt.create_uninit_tensor.f32 [2:i64, 3:i64]
+  dt.fill_tensor_with_constant.f32 %a 1.0:f32
+  // CHECK: tensor: shape=shape[2,3], values=[1, 1, 1, 1, 1, 1]
+  "dt.print_tensor"(%a) : (!t.tensor) -> ()
+
+  %b = dt.create_uninit_tensor.f32 [3:i64, 2:i64]
+  dt.fill_tensor_with_constant.f32 %b 2.0:f32
+  %d = dt.create_uninit_tensor.f32 [2:i64]
+  dt.fill_tensor_with_constant.f32 %d 3.0:f32
+  %c = "dt.add.f32"(%b, %d) : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[3,2], values=[5, 5, 5, 5, 5, 5]
+  "dt.print_tensor"(%c) : (!t.tensor) -> ()
+
+  %e = dt.create_uninit_tensor.f32 [4:i64, 4:i64]
+  dt.fill_tensor_with_constant.f32 %e 4.0:f32
+  %f = "dt.relu.f32"(%d) : (!t.tensor) -> !t.tensor
+  %g = "dt.add.f32"(%e, %d) : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[2], values=[3, 3]
+  "dt.print_tensor"(%f) : (!t.tensor) -> ()
+  // CHECK: tensor: shape=shape[4,4], values=[7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7]
+  "dt.print_tensor"(%g) : (!t.tensor) -> ()
+
+  cinn.return
+}
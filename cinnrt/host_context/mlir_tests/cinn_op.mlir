@@ -0,0 +1,13 @@
+// CHECK-LABEL: call_cinn_op
+func @call_cinn_op() {
+  %a = dt.create_uninit_tensor.f32 [3:i64, 4:i64]
+  dt.fill_tensor_with_constant.f32 %a 1.0:f32
+  %b = dt.create_uninit_tensor.f32 [3:i64, 4:i64]
+  dt.fill_tensor_with_constant.f32 %b 2.0:f32
+
+  %c = "dt.call_cinn_op"(%a, %b) {op_name = "elementwise_add"} : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[3,4], values=[3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3]
+  "dt.print_tensor"(%c) : (!t.tensor) -> ()
+
+  cinn.return
+}
@@ -0,0 +1,29 @@
+// CHECK-LABEL: tensor_math
+func @tensor_math() {
+  %a = dt.create_uninit_tensor.f32 [2:i64, 3:i64]
+  dt.set_tensor_with_constant_values.f32 %a [1.0:f32, 2.0:f32, 3.0:f32, 4.0:f32, 5.0:f32, 6.0:f32]
+  %b = dt.create_uninit_tensor.f32 [3:i64]
+  dt.set_tensor_with_constant_values.f32 %b [10.0:f32, 20.0:f32, 30.0:f32]
+
+  %c = "dt.add.f32"(%a, %b) : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[2,3], values=[11, 22, 33, 14, 25, 36]
+  "dt.print_tensor"(%c) : (!t.tensor) -> ()
+
+  %d = "dt.reduce_sum.f32"(%a) {axis = 1 : i32} : (!t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[2], values=[6, 15]
+  "dt.print_tensor"(%d) : (!t.tensor) -> ()
+
+  %e = "dt.reduce_max.f32"(%a) {axis = 0 : i32} : (!t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[3], values=[4, 5, 6]
+  "dt.print_tensor"(%e) : (!t.tensor) -> ()
+
+  %f = "dt.transpose.f32"(%a) {perm = [1 : i64, 0 : i64]} : (!t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[3,2], values=[1, 4, 2, 5, 3, 6]
+  "dt.print_tensor"(%f) : (!t.tensor) -> ()
+
+  %g = "dt.matmul.f32"(%a, %f) : (!t.tensor, !t.tensor) -> !t.tensor
+  // CHECK: tensor: shape=shape[2,2], values=[14, 32, 32, 77]
+  "dt.print_tensor"(%g) : (!t.tensor) -> ()
+
+  cinn.return
+}
@@ -14,8 +14,10 @@
 #include <utility>
 #include <vector>
 
+#include "cinn/common/arena.h"
 #include "cinnrt/dialect/mlir_loader.h"
 #include "cinnrt/dialect/tensor_shape.h"
+#include "cinnrt/host_context/binary_program.h"
 #include "cinnrt/host_context/core_runtime.h"
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/op_executable.h"
@@ -119,6 +121,12 @@ std::optional<double> MlirToRuntimeTranslator::EmitAttribute(const mlir::Attribu
   }
 }
 
+template <>
+std::optional<std::string> MlirToRuntimeTranslator::EmitAttribute(const mlir::Attribute* attr) {
+  if (!attr->isa<mlir::StringAttr>()) return std::nullopt;
+  return attr->cast<mlir::StringAttr>().getValue().str();
+}
+
 #define PROCESS_ARRAY_INT(type__, bits__)                                                                  \
   template <>                                                                                              \
   std::optional<std::vector<type__>> MlirToRuntimeTranslator::EmitAttribute(const mlir::Attribute* attr) { \
@@ -200,23 +208,25 @@ bool MlirToRuntimeTranslator::EmitGeneralOp(mlir::Operation* op) {
   for (int i = 0; i < attrs.size(); i++) {
     auto& attr = attrs[i];
     if (auto v = EmitAttribute<int32_t>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(*v));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(*v));
     } else if (auto v = EmitAttribute<int64_t>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(*v));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(*v));
     } else if (auto v = EmitAttribute<float>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(*v));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(*v));
     } else if (auto v = EmitAttribute<double>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(*v));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(*v));
+    } else if (auto v = EmitAttribute<std::string>(&attr.second)) {
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else if (auto v = EmitAttribute<std::vector<int16_t>>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(std::move(*v)));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else if (auto v = EmitAttribute<std::vector<int32_t>>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(std::move(*v)));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else if (auto v = EmitAttribute<std::vector<int64_t>>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(std::move(*v)));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else if (auto v = EmitAttribute<std::vector<float>>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(std::move(*v)));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else if (auto v = EmitAttribute<std::vector<double>>(&attr.second)) {
-      impl_->cur_op->AppendAttribute(new Value(std::move(*v)));
+      impl_->cur_op->AppendAttribute(cinn::common::make_shared<Value>(std::move(*v)));
     } else {
       LOG(FATAL) << "Not supported attribute type";
     }
@@ -260,7 +270,7 @@ Value* MlirToRuntimeTranslator::GetValue(mlir::Value value) {
 }
 
 Value* MlirToRuntimeTranslator::AddValue(mlir::Value value) {
-  auto res = impl_->value_map.try_emplace(value, ValueRef(new Value));
+  auto res = impl_->value_map.try_emplace(value, ValueRef(cinn::common::make_shared<Value>()));
   CHECK(res.second) << "Duplicate add mlir value [" << DumpToString(value) << "]";
   return res.first->second.get();
 }
@@ -285,20 +295,38 @@ bool MlirToRuntimeTranslator::EmitBuildShapeOp(mlir::Operation* op) {
   for (auto& attr_v : values) {
     dims.push_back(attr_v.cast<mlir::IntegerAttr>().getInt());
   }
-  impl_->op_results[op] = {ValueRef(new Value(TensorShape(llvm::ArrayRef<int64_t>(dims))))};
+  impl_->op_results[op] = {ValueRef(cinn::common::make_shared<Value>(TensorShape(llvm::ArrayRef<int64_t>(dims))))};
 
   return true;
 }
 
+void MlirToRuntimeTranslator::EmitFunction(mlir::FuncOp func) {
+  UpdateCurFuncName(func.getName().str());
+  auto& blocks = func.getBlocks();
+  CHECK_EQ(blocks.size(), 1UL) << "function with more than one block is not supported yet";
+
+  // The Values of the function are packed in an arena.
+  cinn::common::ArenaScope arena_scope;
+  for (auto& op : blocks.front()) {
+    if (EmitConstantOp(&op)) continue;
+    if (EmitBuildShapeOp(&op)) continue;
+    if (EmitReturnOp(&op)) continue;
+    if (EmitGeneralOp(&op)) continue;
+    LOG(FATAL) << "Not supported op: " << DumpToString(op);
+  }
+}
+
 void MlirToRuntimeTranslate(mlir::ModuleOp module, CoreRuntimeBuilder* runtime) {
   mlir::MLIRContext* ctx = module.getContext();
+  // The Values of the program are packed in an arena.
+  cinn::common::ArenaScope arena_scope;
   MlirToRuntimeTranslator(module, runtime).Emit();
 }
 
 class FunctionExecute : public MlirToRuntimeTranslator {
  public:
-  FunctionExecute(mlir::ModuleOp module, KernelRegistry* registry)
-      : MlirToRuntimeTranslator(module, nullptr), registry(registry) {
+  FunctionExecute(mlir::ModuleOp module, KernelRegistry* registry, ThreadPool* pool)
+      : MlirToRuntimeTranslator(module, nullptr), registry(registry), pool(pool) {
     CHECK(registry);
   }
 
@@ -319,19 +347,14 @@ class FunctionExecute : public MlirToRuntimeTranslator {
       CoreRuntimeBuilder runtime(registry);
       impl_->runtime = &runtime;
 
-      auto& blocks = func.getBlocks();
-      CHECK_EQ(blocks.size(), 1UL) << "function with more than one block is not supported yet";
+      EmitFunction(func);
 
-      for (auto& op : blocks.front()) {
-        if (EmitConstantOp(&op)) continue;
-        if (EmitBuildShapeOp(&op)) continue;
-        if (EmitReturnOp(&op)) continue;
-        if (EmitGeneralOp(&op)) continue;
-        LOG(FATAL) << "Not supported op: " << DumpToString(op);
+      if (pool) {
+        runtime.Execute(pool);
+      } else {
+        runtime.Execute();
       }
 
-      runtime.Execute();
-
     } else {
       LOG(FATAL) << "Callable function is not supported yet";
     }
@@ -339,11 +362,23 @@ class FunctionExecute : public MlirToRuntimeTranslator {
 
  private:
   KernelRegistry* registry{};
+  ThreadPool* pool{};
 };
 
-void ExecuteMlir(mlir::ModuleOp module, KernelRegistry* registry) {
-  FunctionExecute execute(module, registry);
+void ExecuteMlir(mlir::ModuleOp module, KernelRegistry* registry, ThreadPool* pool) {
+  FunctionExecute execute(module, registry, pool);
   execute.Emit();
 }
 
+std::string MlirToBinaryProgram(mlir::ModuleOp module, KernelRegistry* registry) {
+  BinaryProgramWriter writer;
+  for (auto func_op : module.getOps<mlir::FuncOp>()) {
+    CHECK_EQ(func_op.getNumArguments(), 0) << "Callable function is not supported yet";
+    CoreRuntimeBuilder runtime(registry);
+    MlirToRuntimeTranslator(module, &runtime).EmitFunction(func_op);
+    writer.AddFunction(func_op.getName().str(), &runtime);
+  }
+  return writer.Finalize();
+}
+
 }  // namespace cinnrt::host_context
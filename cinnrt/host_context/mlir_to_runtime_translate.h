@@ -1,12 +1,16 @@
 #pragma once
 
+#include <mlir/IR/Function.h>
 #include <mlir/IR/Module.h>
 
+#include <string>
+
 namespace cinnrt::host_context {
 
 class CoreRuntimeBuilder;
 class Value;
 class KernelRegistry;
+class ThreadPool;
 
 class MlirToRuntimeTranslator {
  public:
@@ -14,6 +18,9 @@ class MlirToRuntimeTranslator {
 
   void Emit();
 
+  //! Emit the operations of an entry function \p func.
+  void EmitFunction(mlir::FuncOp func);
+
   //! Emit a "cinn.constant.*" operation, return true if succeed.
   bool EmitConstantOp(mlir::Operation* op);
   //! Emit a "cinn.return" operation.
@@ -46,6 +53,14 @@ class MlirToRuntimeTranslator {
  */
 void MlirToRuntimeTranslate(mlir::ModuleOp module, CoreRuntimeBuilder* runtime);
 
-void ExecuteMlir(mlir::ModuleOp module, KernelRegistry* registry);
+/**
+ * Execute the entry functions in a MLIR module, on \p pool if it is not null or on the calling thread otherwise.
+ */
+void ExecuteMlir(mlir::ModuleOp module, KernelRegistry* registry, ThreadPool* pool = nullptr);
+
+/**
+ * Translate the entry functions in a MLIR module and serialize them in the binary program format.
+ */
+std::string MlirToBinaryProgram(mlir::ModuleOp module, KernelRegistry* registry);
 
 }  // namespace cinnrt::host_context
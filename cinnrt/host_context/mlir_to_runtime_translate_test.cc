@@ -3,9 +3,11 @@
 #include <gtest/gtest.h>
 
 #include "cinnrt/dialect/mlir_loader.h"
+#include "cinnrt/host_context/binary_program.h"
 #include "cinnrt/host_context/core_runtime.h"
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/kernel_utils.h"
+#include "cinnrt/host_context/op_executable.h"
 #include "cinnrt/kernel/basic_kernels.h"
 
 namespace cinnrt::host_context {
@@ -65,4 +67,37 @@ func @main() -> () {
   ExecuteMlir(module.get(), &registry);
 }
 
+TEST(MlirToBinaryProgram, basic) {
+  mlir::MLIRContext context;
+
+  auto source = R"ROC(
+func @main() -> () {
+  %v0 = cinn.constant.f32 1.0
+  %v1 = cinn.constant.f32 2.0
+  %v2 = "cinn.add.f32"(%v0, %v1) : (f32, f32) -> f32
+  %v3 = "cinn.mul.f32"(%v2, %v1) : (f32, f32) -> f32
+
+  cinn.return
+}
+)ROC";
+
+  auto module = dialect::LoadMlirSource(&context, source);
+  module->verify();
+
+  KernelRegistry registry;
+  kernel::RegisterFloatBasicKernels(&registry);
+  kernel::RegisterIntBasicKernels(&registry);
+
+  auto data    = MlirToBinaryProgram(module.get(), &registry);
+  auto program = BinaryProgram::Load(data.data(), data.size(), &registry);
+  ASSERT_EQ(program->num_functions(), 1UL);
+  ASSERT_EQ(program->function_name(0), "main");
+
+  auto* runtime = program->function(0);
+  runtime->Execute();
+  auto ops = runtime->GetOpExecutables();
+  ASSERT_EQ(ops.size(), 2UL);
+  ASSERT_EQ(ops[1]->frame().GetResults()[0].get<float>(), 6.f);
+}
+
 }  // namespace cinnrt::host_context
\ No newline at end of file
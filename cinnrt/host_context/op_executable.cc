@@ -1,6 +1,9 @@
 #include "cinnrt/host_context/op_executable.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <utility>
 
 #include "cinnrt/host_context/kernel_frame.h"
 #include "cinnrt/host_context/kernel_registry.h"
@@ -14,22 +17,31 @@ struct OpExecutable::Impl {
         symbol_table(symbol_table),
         kernel_registry(kernel_registry ? kernel_registry : GetCpuKernelRegistry()) {}
 
-  std::string_view op_name;
+  std::string op_name;
   SymbolTable* symbol_table{};
   KernelFrameBuilder frame;
   KernelRegistry* kernel_registry{};
 
   KernelImplementation kernel_impl{};
+
+  //! The completion of the blocking executions, only waited for if the kernel is asynchronous.
+  struct Completion {
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done{false};
+  } completion;
+  std::function<void()> notify_completion;
 };
 
 OpExecutable::OpExecutable(OpExecutable::Impl* impl) : impl_(impl) {}
 
 OpExecutableBuilder::OpExecutableBuilder(std::string_view op_name,
                                          SymbolTable* symbol_table,
-                                         KernelRegistry* kernel_registry)
+                                         KernelRegistry* kernel_registry,
+                                         KernelImplementation kernel_impl)
     : OpExecutable(new Impl(op_name, symbol_table, kernel_registry)) {
   // Cpu kernel registry is the default KernelRegistry.
-  impl_->kernel_impl = impl_->kernel_registry->GetKernel(op_name);
+  impl_->kernel_impl = kernel_impl ? kernel_impl : impl_->kernel_registry->GetKernel(op_name);
   // TODO(Superjomn) support other device other than CPU.
   CHECK(impl_->kernel_impl) << "No CPU kernel called " << op_name;
 }
@@ -43,6 +55,8 @@ void OpExecutableBuilder::AppendArgument(std::string_view name) {
 
 void OpExecutableBuilder::AppendArgument(Value* value) { impl_->frame.AddArgument(ValueRef(value)); }
 
+std::string_view OpExecutable::name() const { return impl_->op_name; }
+
 KernelFrame& OpExecutable::frame() { return impl_->frame; }
 const KernelFrame& OpExecutable::frame() const { return impl_->frame; }
 
@@ -65,7 +79,31 @@ void OpExecutableBuilder::AppendAttribute(Value* value) { impl_->frame.AddAttrib
 
 OpExecutableBuilder::OpExecutableBuilder(OpExecutableBuilder&& other) : OpExecutable(other.impl_.release()) {}
 
-void OpExecutable::Execute() { impl_->kernel_impl(&impl_->frame); }
+void OpExecutable::Execute() {
+  auto& completion = impl_->completion;
+  if (!impl_->notify_completion) {
+    impl_->notify_completion = [c = &completion] {
+      std::lock_guard<std::mutex> lock(c->mu);
+      c->done = true;
+      c->cv.notify_one();
+    };
+  }
+  completion.done = false;
+
+  // A synchronous kernel completes on return, the frame and the completion are reused without any locking.
+  impl_->frame.SetDone(impl_->notify_completion);
+  impl_->kernel_impl(&impl_->frame);
+  if (!impl_->frame.is_async()) return;
+
+  std::unique_lock<std::mutex> lock(completion.mu);
+  completion.cv.wait(lock, [&] { return completion.done; });
+}
+
+void OpExecutable::ExecuteAsync(std::function<void()> done) {
+  impl_->frame.SetDone(std::move(done));
+  impl_->kernel_impl(&impl_->frame);
+  if (!impl_->frame.is_async()) impl_->frame.Done();
+}
 
 OpExecutable::~OpExecutable() {}
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <llvm/ADT/ArrayRef.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -11,6 +12,7 @@ class SymbolTable;
 class KernelRegistry;
 class KernelFrame;
 class Value;
+using KernelImplementation = void (*)(KernelFrame* frame);
 
 /**
  * OpExecutable is a runtime executable instance for an operation. It captures all the information(Tensors, attributes
@@ -19,11 +21,21 @@ class Value;
  */
 class OpExecutable {
  public:
+  //! The name of the operation.
+  std::string_view name() const;
+
   KernelFrame& frame();
   const KernelFrame& frame() const;
 
+  //! Execute the kernel and wait for its results.
   void Execute();
 
+  /**
+   * Execute the kernel, \p done is called once the results are ready. It is called before returning for a synchronous
+   * kernel, or maybe later on another thread for an asynchronous one.
+   */
+  void ExecuteAsync(std::function<void()> done);
+
   ~OpExecutable();
 
  protected:
@@ -38,7 +50,16 @@ class OpExecutable {
  */
 class OpExecutableBuilder : public OpExecutable {
  public:
-  OpExecutableBuilder(std::string_view op_name, SymbolTable* symbol_table, KernelRegistry* kernel_registry = nullptr);
+  /**
+   * @param op_name The name of the operation.
+   * @param symbol_table The SymbolTable of the function.
+   * @param kernel_registry The registry to look up the kernel of \p op_name in, the CPU one if null.
+   * @param kernel_impl The kernel resolved already, looked up in \p kernel_registry if null.
+   */
+  OpExecutableBuilder(std::string_view op_name,
+                      SymbolTable* symbol_table,
+                      KernelRegistry* kernel_registry = nullptr,
+                      KernelImplementation kernel_impl  = nullptr);
   OpExecutableBuilder(OpExecutableBuilder&& other);
 
   void AppendArgument(std::string_view name);
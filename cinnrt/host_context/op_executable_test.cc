@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "cinnrt/host_context/kernel_registry.h"
 #include "cinnrt/host_context/kernel_utils.h"
 #include "cinnrt/host_context/symbol_table.h"
@@ -37,5 +39,31 @@ TEST(OpExecutable, basic) {
   ASSERT_EQ(c, 3);
 }
 
+// Increase the argument in place on another thread.
+void async_inc(int* x, AsyncDone done) {
+  std::thread([=] {
+    (*x)++;
+    done();
+  }).detach();
+}
+
+TEST(OpExecutable, async) {
+  KernelRegistry registry;
+  registry.AddKernel("cinn.test.async_inc.i32", CINN_KERNEL(async_inc));
+
+  SymbolTable table;
+  table.Register("a", 1);
+
+  OpExecutableBuilder executable("cinn.test.async_inc.i32", &table, &registry);
+  executable.AppendArgument("a");
+  executable.SetResults(llvm::ArrayRef<std::string>{});
+
+  // Execute waits for the completion.
+  executable.Execute();
+  ASSERT_EQ(table.Get("a")->get<int>(), 2);
+  executable.Execute();
+  ASSERT_EQ(table.Get("a")->get<int>(), 3);
+}
+
 }  // namespace host_context
 }  // namespace cinnrt
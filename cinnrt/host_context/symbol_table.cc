@@ -12,7 +12,7 @@ struct SymbolTable::Impl {
 SymbolTable::SymbolTable() : impl_(new Impl) {}
 
 Value* SymbolTable::Register(std::string_view key) {
-  auto it = impl_->data.try_emplace(std::string(key), ValueRef(new Value));
+  auto it = impl_->data.try_emplace(std::string(key), ValueRef(cinn::common::make_shared<Value>()));
   CHECK(it.second) << "Duplicate register [" << key << "]";
   return it.first->second.get();
 }
@@ -14,6 +14,8 @@ class TensorShape {
 
   int GetRank() const;
 
+  int64_t GetDim(int idx) const;
+
   int GetNumElements() const;
 
   friend std::ostream& operator<<(std::ostream& os, const TensorShape& v);
@@ -0,0 +1,140 @@
+#include "cinnrt/host_context/thread_pool.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace cinnrt::host_context {
+
+namespace {
+//! The id of the worker running on this thread, -1 for the threads not in a pool.
+thread_local int tls_worker_id = -1;
+thread_local ThreadPool* tls_pool{};
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+  // `hardware_concurrency` returns 0 when it is not computable.
+  num_threads = std::max(num_threads, 1);
+  for (int i = 0; i < num_threads; i++) workers_.emplace_back(new Worker);
+  for (int i = 0; i < num_threads; i++) threads_.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+void ThreadPool::Schedule(Task task) {
+  int id = tls_pool == this ? tls_worker_id : next_worker_++ % workers_.size();
+  {
+    std::lock_guard<std::mutex> lock(workers_[id]->mu);
+    workers_[id]->tasks.push_back(std::move(task));
+  }
+  {
+    // Count under the lock, or a worker checking `num_pending_` right before the increment might miss the wakeup.
+    std::lock_guard<std::mutex> lock(mu_);
+    num_pending_++;
+  }
+  cv_.notify_one();
+}
+
+bool ThreadPool::PopTask(int id, Task* task) {
+  {
+    auto& worker = *workers_[id];
+    std::lock_guard<std::mutex> lock(worker.mu);
+    if (!worker.tasks.empty()) {
+      *task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      return true;
+    }
+  }
+  for (int i = 1; i < workers_.size(); i++) {
+    auto& victim = *workers_[(id + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mu);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool* ThreadPool::Default() {
+  static ThreadPool pool;
+  return &pool;
+}
+
+ThreadPool* ThreadPool::Current() { return tls_pool; }
+
+bool ThreadPool::TryRunTask() {
+  Task task;
+  if (!PopTask(InWorkerThread() ? tls_worker_id : 0, &task)) return false;
+  num_pending_--;
+  task();
+  return true;
+}
+
+bool ThreadPool::InWorkerThread() const { return tls_pool == this; }
+
+void ThreadPool::ParallelFor(int64_t n,
+                             int64_t grain_size,
+                             const std::function<void(int64_t begin, int64_t end)>& fn) {
+  if (n <= 0) return;
+  grain_size         = std::max<int64_t>(grain_size, 1);
+  int64_t num_blocks = std::min<int64_t>((n + grain_size - 1) / grain_size, 4 * num_threads());
+  if (num_blocks <= 1) {
+    fn(0, n);
+    return;
+  }
+  int64_t block_size = (n + num_blocks - 1) / num_blocks;
+  num_blocks         = (n + block_size - 1) / block_size;
+
+  // The helpers starting after all the blocks are claimed touch the state only, which outlives the call.
+  struct State {
+    std::atomic<int64_t> next_block{0};
+    std::atomic<int64_t> num_done{0};
+    std::mutex mu;
+    std::condition_variable cv;
+  };
+  auto state     = std::make_shared<State>();
+  auto run_block = [state, n, block_size, num_blocks, &fn] {
+    int64_t count = 0;
+    for (int64_t b = state->next_block++; b < num_blocks; b = state->next_block++, count++) {
+      fn(b * block_size, std::min(n, (b + 1) * block_size));
+    }
+    if (count > 0 && state->num_done.fetch_add(count) + count == num_blocks) {
+      std::lock_guard<std::mutex> lock(state->mu);
+      state->cv.notify_one();
+    }
+  };
+  for (int i = 0; i < std::min<int64_t>(num_blocks - 1, num_threads()); i++) Schedule(run_block);
+  run_block();
+
+  std::unique_lock<std::mutex> lock(state->mu);
+  state->cv.wait(lock, [&] { return state->num_done.load() == num_blocks; });
+}
+
+void ThreadPool::WorkerLoop(int id) {
+  tls_worker_id = id;
+  tls_pool      = this;
+  Task task;
+  while (true) {
+    if (PopTask(id, &task)) {
+      num_pending_--;
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [this] { return stop_ || num_pending_ > 0; });
+    if (stop_ && num_pending_ == 0) return;
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) thread.join();
+}
+
+}  // namespace cinnrt::host_context
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinnrt::host_context {
+
+/**
+ * A work-stealing thread pool.
+ *
+ * Each worker owns a task queue. The tasks scheduled from a worker go to its own queue and run in the LIFO order, which
+ * keeps the consumers of a value on the thread that produced it. The tasks scheduled from the other threads are
+ * distributed round robin. An idle worker steals the oldest tasks from the others.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(int num_threads = std::thread::hardware_concurrency());
+
+  //! Schedule a task to run on some worker.
+  void Schedule(Task task);
+
+  /**
+   * Split [0, \p n) into the ranges no smaller than \p grain_size, run \p fn on each of them and wait. The calling
+   * thread runs the ranges too, so it is safe to call from a task of this pool even if all the workers are busy.
+   */
+  void ParallelFor(int64_t n, int64_t grain_size, const std::function<void(int64_t begin, int64_t end)>& fn);
+
+  //! The pool of the hardware concurrency shared by the process, created on the first call.
+  static ThreadPool* Default();
+
+  //! The pool whose worker is the calling thread, null for the threads not in a pool.
+  static ThreadPool* Current();
+
+  //! Run a pending task on the calling thread, get false if there is none.
+  bool TryRunTask();
+
+  //! Whether the calling thread is a worker of this pool.
+  bool InWorkerThread() const;
+
+  int num_threads() const { return workers_.size(); }
+
+  ~ThreadPool();
+
+ private:
+  struct Worker {
+    std::mutex mu;
+    std::deque<Task> tasks;
+  };
+
+  void WorkerLoop(int id);
+  bool PopTask(int id, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  //! The number of the tasks in all the queues.
+  std::atomic<int> num_pending_{0};
+  std::atomic<unsigned> next_worker_{0};
+  bool stop_{false};
+};
+
+}  // namespace cinnrt::host_context
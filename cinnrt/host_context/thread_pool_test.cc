@@ -0,0 +1,66 @@
+#include "cinnrt/host_context/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinnrt {
+namespace host_context {
+
+TEST(ThreadPool, basic) {
+  ThreadPool pool(4);
+  std::atomic<int> count{0};
+  std::mutex mu;
+  std::condition_variable cv;
+
+  // The tasks scheduled from the workers spawn more tasks.
+  const int num_tasks = 100;
+  for (int i = 0; i < num_tasks; i++) {
+    pool.Schedule([&] {
+      pool.Schedule([&] {
+        if (++count == 2 * num_tasks) {
+          std::lock_guard<std::mutex> lock(mu);
+          cv.notify_one();
+        }
+      });
+      if (++count == 2 * num_tasks) {
+        std::lock_guard<std::mutex> lock(mu);
+        cv.notify_one();
+      }
+    });
+  }
+
+  std::unique_lock<std::mutex> lock(mu);
+  cv.wait(lock, [&] { return count == 2 * num_tasks; });
+  ASSERT_EQ(count, 2 * num_tasks);
+}
+
+TEST(ThreadPool, parallel_for) {
+  ThreadPool pool(4);
+  std::vector<int> data(10000, 0);
+  pool.ParallelFor(data.size(), 100, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) data[i]++;
+  });
+  for (int x : data) ASSERT_EQ(x, 1);
+
+  // Nested in the tasks occupying all the workers.
+  std::atomic<int64_t> sum{0};
+  std::atomic<int> num_done{0};
+  for (int i = 0; i < 4; i++) {
+    pool.Schedule([&] {
+      pool.ParallelFor(1000, 10, [&](int64_t begin, int64_t end) {
+        for (int64_t j = begin; j < end; j++) sum += j;
+      });
+      num_done++;
+    });
+  }
+  while (num_done < 4) std::this_thread::yield();
+  ASSERT_EQ(sum, 4 * 999 * 1000 / 2);
+}
+
+}  // namespace host_context
+}  // namespace cinnrt
@@ -7,11 +7,11 @@
 namespace cinnrt {
 namespace host_context {
 
-ValueRef::ValueRef(int32_t val) : Shared<Value>(new Value(val)) {}
-ValueRef::ValueRef(int64_t val) : Shared<Value>(new Value(val)) {}
-ValueRef::ValueRef(float val) : Shared<Value>(new Value(val)) {}
-ValueRef::ValueRef(double val) : Shared<Value>(new Value(val)) {}
-ValueRef::ValueRef(bool val) : Shared<Value>(new Value(val)) {}
+ValueRef::ValueRef(int32_t val) : Shared<Value>(cinn::common::make_shared<Value>(val)) {}
+ValueRef::ValueRef(int64_t val) : Shared<Value>(cinn::common::make_shared<Value>(val)) {}
+ValueRef::ValueRef(float val) : Shared<Value>(cinn::common::make_shared<Value>(val)) {}
+ValueRef::ValueRef(double val) : Shared<Value>(cinn::common::make_shared<Value>(val)) {}
+ValueRef::ValueRef(bool val) : Shared<Value>(cinn::common::make_shared<Value>(val)) {}
 
 const char* Value::type_info() const { return __type_info__; }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <glog/logging.h>
 
+#include <string>
 #include <utility>
 #include <variant>
 
@@ -20,6 +21,7 @@ using ValueVariantType = std::variant<int16_t,
                                       float,
                                       double,
                                       bool,
+                                      std::string,
                                       TensorShape,
                                       DenseTensor,
                                       std::vector<int16_t>,
@@ -30,6 +32,9 @@ using ValueVariantType = std::variant<int16_t,
 
 /**
  * Represents any data type for value in host context.
+ *
+ * The scalars are boxed in a Value like the other types. A result slot of a KernelFrame keeps its Value across the
+ * invocations, so a scalar result is allocated on the first write only, see `KernelFrame::SetResultAt`.
  */
 class Value : public cinn::common::Object {
  public:
@@ -41,6 +46,7 @@ class Value : public cinn::common::Object {
   explicit Value(float x) : data(x) {}
   explicit Value(double x) : data(x) {}
   explicit Value(bool x) : data(x) {}
+  explicit Value(std::string&& x) : data(std::move(x)) {}
   explicit Value(std::vector<int16_t>&& x) : data(x) {}
   explicit Value(std::vector<int32_t>&& x) : data(x) {}
   explicit Value(std::vector<int64_t>&& x) : data(x) {}
@@ -58,6 +64,11 @@ class Value : public cinn::common::Object {
     return std::get<T>(data);
   }
 
+  template <typename T>
+  bool is_type() const {
+    return std::holds_alternative<T>(data);
+  }
+
   template <typename T>
   void set(T&& v) {
     data = std::move(v);
@@ -0,0 +1,136 @@
+#include "cinnrt/kernel/cinn_kernels.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/syntax.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinnrt/host_context/dense_tensor.h"
+#include "cinnrt/host_context/kernel_frame.h"
+#include "cinnrt/host_context/kernel_registry.h"
+
+namespace cinnrt::kernel {
+using namespace host_context;  // NOLINT
+
+namespace {
+
+namespace framework = cinn::hlir::framework;
+
+/**
+ * A CINN operator compiled for the given input shapes. It holds the compiler and the program to keep the JIT compiled
+ * function alive.
+ */
+struct CompiledCinnOp {
+  std::unique_ptr<framework::GraphCompiler> compiler;
+  std::unique_ptr<framework::Program> program;
+  lower_func_ptr_t fn{};
+  std::vector<std::vector<int64_t>> out_shapes;
+};
+
+std::string GetCinnOpKey(const std::string& op_name, KernelFrame* frame) {
+  std::string key = op_name;
+  for (int i = 0; i < frame->GetNumArgs(); i++) {
+    auto& shape = frame->GetArgAt<DenseTensor>(i).shape();
+    key += ";";
+    for (int j = 0; j < shape.GetRank(); j++) key += std::to_string(shape.GetDim(j)) + ",";
+  }
+  return key;
+}
+
+std::unique_ptr<CompiledCinnOp> CompileCinnOp(const std::string& op_name, KernelFrame* frame) {
+  auto target = cinn::common::DefaultHostTarget();
+
+  cinn::frontend::Program program;
+  std::vector<cinn::frontend::Variable> inputs;
+  for (int i = 0; i < frame->GetNumArgs(); i++) {
+    auto& tensor = frame->GetArgAt<DenseTensor>(i);
+    CHECK(tensor.dtype() == cinn_type_of<float>()) << "Only float32 tensors are supported to call the CINN operators";
+    cinn::frontend::Variable var("cinn_op_input_" + std::to_string(i));
+    for (int j = 0; j < tensor.shape().GetRank(); j++) var->shape.push_back(tensor.shape().GetDim(j));
+    var->type = cinn::common::Float(32);
+    inputs.push_back(var);
+  }
+  cinn::frontend::Instruction instr(op_name, inputs);
+  program.AppendInstruction(instr);
+  program.SetInputs(inputs);
+
+  auto graph = std::make_shared<framework::Graph>(program);
+  framework::ApplyPass(graph.get(), "InferShape");
+  auto scope = framework::BuildScope(target, graph);
+
+  auto compiled      = std::make_unique<CompiledCinnOp>();
+  compiled->compiler = std::make_unique<framework::GraphCompiler>(target, scope, graph);
+  compiled->program  = compiled->compiler->Build();
+  auto& instrs       = compiled->program->GetRunInstructions();
+  CHECK_EQ(instrs.size(), 1UL) << "The CINN operator [" << op_name << "] should be compiled to a single function";
+  compiled->fn = instrs.front()->GetLoweredFunc();
+
+  auto out_args = instrs.front()->GetOutArgs();
+  CHECK_EQ(out_args.size(), frame->GetNumResults())
+      << "The CINN operator [" << op_name << "] has " << out_args.size() << " outputs";
+  auto& shapes = graph->GetAttrs<std::unordered_map<std::string, framework::shape_t>>("infershape");
+  for (auto& out : out_args) {
+    auto& shape = shapes.at(out);
+    compiled->out_shapes.emplace_back(shape.begin(), shape.end());
+  }
+  return compiled;
+}
+
+//! Get the CINN operator compiled for the input shapes in \p frame, compile it on the first call.
+const CompiledCinnOp& GetCompiledCinnOp(const std::string& op_name, KernelFrame* frame) {
+  static std::mutex mu;
+  static std::unordered_map<std::string, std::unique_ptr<CompiledCinnOp>> cache;
+
+  auto key = GetCinnOpKey(op_name, frame);
+  std::lock_guard<std::mutex> lock(mu);
+  auto& compiled = cache[key];
+  if (!compiled) {
+    VLOG(3) << "Compile the CINN operator " << key;
+    compiled = CompileCinnOp(op_name, frame);
+  }
+  return *compiled;
+}
+
+/// ===== Kernel begin ====
+
+/**
+ * Call the CINN operator named by the string attribute on the float32 input tensors, the operator is called with its
+ * default attributes. The results are allocated by this kernel, and all the tensors are passed to the compiled
+ * function in place.
+ */
+void CallCinnOp(KernelFrame* frame) {
+  auto& op_name   = frame->GetAttributeAt(0)->get<std::string>();
+  auto& compiled  = GetCompiledCinnOp(op_name, frame);
+  int num_results = frame->GetNumResults();
+
+  std::vector<cinn_pod_value_t> args;
+  for (int i = 0; i < frame->GetNumArgs(); i++) {
+    args.emplace_back(frame->GetArgAt<DenseTensor>(i).cinn_buffer());
+  }
+  for (int i = 0; i < num_results; i++) {
+    auto& shape = compiled.out_shapes[i];
+    frame->EmplaceResult<DenseTensor>(i, TensorShape(shape), cinn_type_of<float>());
+    args.emplace_back(frame->GetResults()[i]->get<DenseTensor>().cinn_buffer());
+  }
+  compiled.fn(args.data(), args.size());
+}
+
+/// ===== Kernel end ====
+
+}  // namespace
+
+void RegisterCinnKernels(host_context::KernelRegistry* registry) {
+  registry->AddKernel("dt.call_cinn_op", CallCinnOp);
+  registry->AddKernelAttrNameList("dt.call_cinn_op", {"op_name"});
+}
+
+}  // namespace cinnrt::kernel
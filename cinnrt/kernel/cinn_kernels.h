@@ -0,0 +1,17 @@
+#pragma once
+
+namespace cinnrt::host_context {
+
+class KernelRegistry;
+
+}  // namespace cinnrt::host_context
+
+namespace cinnrt::kernel {
+
+/**
+ * Register the kernels calling the CINN operators, the operators are JIT compiled for the shapes of the input tensors
+ * on the first call and cached for the later ones.
+ */
+void RegisterCinnKernels(host_context::KernelRegistry* registry);
+
+}  // namespace cinnrt::kernel
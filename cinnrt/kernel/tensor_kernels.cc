@@ -1,5 +1,6 @@
 #include "cinnrt/kernel/tensor_kernels.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -28,14 +29,34 @@ void FillTensorWithConstant(DenseTensor* tensor, Attribute<T> v) {
   MutableDTArrayView<T>(tensor).Fill(v.get());
 }
 
+template <typename T>
+void SetTensorWithConstantValues(DenseTensor* tensor, Attribute<std::vector<T>> values) {
+  CHECK_EQ(values.get().size(), static_cast<size_t>(tensor->shape().GetNumElements()))
+      << "The number of the values does not match the tensor";
+  std::copy(values.get().begin(), values.get().end(), static_cast<T*>(tensor->data()));
+}
+
+template <typename T>
+void ReuseTensor(DenseTensor* tensor, Attribute<std::vector<int64_t>> shape) {
+  CHECK(tensor->dtype() == cinn_type_of<T>()) << "The data type of the reused tensor does not match";
+  const auto& shape_data = shape.get();
+  tensor->Reshape(TensorShape(llvm::ArrayRef<int64_t>(shape_data.data(), shape_data.size())));
+}
+
 /// ===== Kernel end ====
 
 void RegisterTensorKernels(host_context::KernelRegistry* registry) {
   registry->AddKernel("dt.create_uninit_tensor.f32", CINN_KERNEL(CreateUninitTensor<float>));
   registry->AddKernelAttrNameList("dt.create_uninit_tensor.f32", {"shape"});
+  registry->AddKernel("dt.reuse_tensor.f32", CINN_KERNEL(ReuseTensor<float>));
+  registry->AddKernelAttrNameList("dt.reuse_tensor.f32", {"shape"});
   registry->AddKernel("dt.print_tensor", CINN_KERNEL(PrintTensor));
   registry->AddKernel("dt.fill_tensor_with_constant.f32", CINN_KERNEL(FillTensorWithConstant<float>));
   registry->AddKernel("dt.fill_tensor_with_constant.f64", CINN_KERNEL(FillTensorWithConstant<double>));
+  registry->AddKernel("dt.set_tensor_with_constant_values.f32", CINN_KERNEL(SetTensorWithConstantValues<float>));
+  registry->AddKernelAttrNameList("dt.set_tensor_with_constant_values.f32", {"values"});
+  registry->AddKernel("dt.set_tensor_with_constant_values.f64", CINN_KERNEL(SetTensorWithConstantValues<double>));
+  registry->AddKernelAttrNameList("dt.set_tensor_with_constant_values.f64", {"values"});
 }
 
 }  // namespace cinnrt::kernel
@@ -0,0 +1,546 @@
+#include "cinnrt/kernel/tensor_math_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cinnrt/host_context/dense_tensor.h"
+#include "cinnrt/host_context/kernel_registry.h"
+#include "cinnrt/host_context/kernel_utils.h"
+#include "cinnrt/host_context/tensor_shape.h"
+#include "cinnrt/host_context/thread_pool.h"
+
+namespace cinnrt::kernel {
+using namespace host_context;  // NOLINT
+
+namespace {
+
+//! The number of the scalar operations below which a kernel runs on the calling thread.
+constexpr int64_t kParallelCost = 32 * 1024;
+
+/**
+ * Run \p fn on the ranges of [0, \p n), split across a pool if \p n items each costing \p cost are worth it. A kernel
+ * run by the parallel executor splits across the pool of the executor, so the process keeps a single pool.
+ */
+void ParallelFor(int64_t n, int64_t cost, const std::function<void(int64_t, int64_t)>& fn) {
+  if (n <= 0) return;
+  int64_t grain_size = std::max<int64_t>(kParallelCost / std::max<int64_t>(cost, 1), 1);
+  if (n <= grain_size) {
+    fn(0, n);
+    return;
+  }
+  ThreadPool* pool = ThreadPool::Current();
+  (pool ? pool : ThreadPool::Default())->ParallelFor(n, grain_size, fn);
+}
+
+std::vector<int64_t> GetDims(const TensorShape& shape) {
+  std::vector<int64_t> dims(shape.GetRank());
+  for (int i = 0; i < shape.GetRank(); i++) dims[i] = shape.GetDim(i);
+  return dims;
+}
+
+int64_t GetNumElements(const std::vector<int64_t>& dims) {
+  int64_t res = 1;
+  for (int64_t dim : dims) res *= dim;
+  return res;
+}
+
+//! The strides of the row-major \p dims.
+std::vector<int64_t> GetStrides(const std::vector<int64_t>& dims) {
+  std::vector<int64_t> strides(dims.size());
+  int64_t stride = 1;
+  for (int i = static_cast<int>(dims.size()) - 1; i >= 0; i--) {
+    strides[i] = stride;
+    stride *= dims[i];
+  }
+  return strides;
+}
+
+template <typename T>
+DenseTensor MakeTensor(const std::vector<int64_t>& dims) {
+  return DenseTensor(TensorShape(llvm::ArrayRef<int64_t>(dims)), cinn_type_of<T>());
+}
+
+template <typename T>
+T* GetData(const DenseTensor& tensor) {
+  CHECK(tensor.dtype() == cinn_type_of<T>()) << "The data type of the tensor does not match the kernel";
+  return static_cast<T*>(tensor.data());
+}
+
+// ---- The elementwise functors.
+
+struct AddFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a + b;
+  }
+};
+struct SubFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a - b;
+  }
+};
+struct MulFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a * b;
+  }
+};
+struct DivFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a / b;
+  }
+};
+struct MaxFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a > b ? a : b;
+  }
+};
+struct MinFunctor {
+  template <typename T>
+  T operator()(T a, T b) const {
+    return a < b ? a : b;
+  }
+};
+
+struct NegFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return -x;
+  }
+};
+struct AbsFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return x < T(0) ? -x : x;
+  }
+};
+struct ReluFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return x > T(0) ? x : T(0);
+  }
+};
+struct ExpFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return std::exp(x);
+  }
+};
+struct SqrtFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return std::sqrt(x);
+  }
+};
+struct TanhFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return std::tanh(x);
+  }
+};
+struct SigmoidFunctor {
+  template <typename T>
+  T operator()(T x) const {
+    return T(1) / (T(1) + std::exp(-x));
+  }
+};
+
+// ---- The reducers, `Init` is the identity of the reduction.
+
+struct SumReducer : public AddFunctor {
+  template <typename T>
+  static T Init() {
+    return T(0);
+  }
+};
+struct MaxReducer : public MaxFunctor {
+  template <typename T>
+  static T Init() {
+    return std::numeric_limits<T>::lowest();
+  }
+};
+struct MinReducer : public MinFunctor {
+  template <typename T>
+  static T Init() {
+    return std::numeric_limits<T>::max();
+  }
+};
+
+//! The shape broadcast from \p a and \p b, the dimensions are aligned from the innermost one as numpy does.
+std::vector<int64_t> BroadcastDims(const std::vector<int64_t>& a, const std::vector<int64_t>& b) {
+  size_t rank = std::max(a.size(), b.size());
+  std::vector<int64_t> dims(rank);
+  for (size_t i = 0; i < rank; i++) {
+    int64_t x = i < rank - a.size() ? 1 : a[i - (rank - a.size())];
+    int64_t y = i < rank - b.size() ? 1 : b[i - (rank - b.size())];
+    CHECK(x == y || x == 1 || y == 1) << "The dimensions " << x << " and " << y << " can not be broadcast";
+    dims[i] = x == 1 ? y : x;
+  }
+  return dims;
+}
+
+//! The strides of \p dims in the dimensions of \p out_dims, 0 for the broadcast ones.
+std::vector<int64_t> BroadcastStrides(const std::vector<int64_t>& dims, const std::vector<int64_t>& out_dims) {
+  std::vector<int64_t> strides(out_dims.size(), 0);
+  int64_t stride = 1;
+  for (int i = static_cast<int>(dims.size()) - 1, j = static_cast<int>(out_dims.size()) - 1; i >= 0; i--, j--) {
+    strides[j] = dims[i] == 1 ? 0 : stride;
+    stride *= dims[i];
+  }
+  return strides;
+}
+
+/**
+ * Compute a row of \p n elements, \p a and \p b advance by the steps \p sa and \p sb, 0 for a broadcast operand. The
+ * common steps are specialized so the loops are contiguous and vectorized.
+ */
+template <typename T, typename F>
+void BinaryRow(
+    const T* __restrict__ a, int64_t sa, const T* __restrict__ b, int64_t sb, T* __restrict__ out, int64_t n) {
+  F f;
+  if (sa == 1 && sb == 1) {
+    for (int64_t i = 0; i < n; i++) out[i] = f(a[i], b[i]);
+  } else if (sa == 1 && sb == 0) {
+    const T y = *b;
+    for (int64_t i = 0; i < n; i++) out[i] = f(a[i], y);
+  } else if (sa == 0 && sb == 1) {
+    const T x = *a;
+    for (int64_t i = 0; i < n; i++) out[i] = f(x, b[i]);
+  } else {
+    for (int64_t i = 0; i < n; i++) out[i] = f(a[i * sa], b[i * sb]);
+  }
+}
+
+//! Compute a row of \p n elements in place on \p a, the steps of \p b are specialized as BinaryRow does.
+template <typename T, typename F>
+void BinaryRowInplace(T* __restrict__ a, const T* __restrict__ b, int64_t sb, int64_t n) {
+  F f;
+  if (sb == 1) {
+    for (int64_t i = 0; i < n; i++) a[i] = f(a[i], b[i]);
+  } else if (sb == 0) {
+    const T y = *b;
+    for (int64_t i = 0; i < n; i++) a[i] = f(a[i], y);
+  } else {
+    for (int64_t i = 0; i < n; i++) a[i] = f(a[i], b[i * sb]);
+  }
+}
+
+//! The offset of the row \p r of the innermost dimension of \p dims, in a tensor of the \p strides.
+int64_t GetRowOffset(int64_t r, const std::vector<int64_t>& dims, const std::vector<int64_t>& strides) {
+  int64_t offset = 0;
+  for (int d = static_cast<int>(dims.size()) - 2; d >= 0; d--) {
+    offset += r % dims[d] * strides[d];
+    r /= dims[d];
+  }
+  return offset;
+}
+
+/// ===== Kernel begin ====
+
+template <typename T, typename F>
+DenseTensor ElementwiseBinary(const DenseTensor& a, const DenseTensor& b) {
+  auto a_dims   = GetDims(a.shape());
+  auto b_dims   = GetDims(b.shape());
+  auto out_dims = BroadcastDims(a_dims, b_dims);
+  auto out      = MakeTensor<T>(out_dims);
+  const T* pa   = GetData<T>(a);
+  const T* pb   = GetData<T>(b);
+  T* po         = GetData<T>(out);
+  int64_t numel = GetNumElements(out_dims);
+
+  // The operands of the same shape, or a scalar one, are computed as a single row.
+  int64_t a_numel = GetNumElements(a_dims), b_numel = GetNumElements(b_dims);
+  if ((a_numel == numel || a_numel == 1) && (b_numel == numel || b_numel == 1)) {
+    int64_t sa = a_numel == 1 ? 0 : 1, sb = b_numel == 1 ? 0 : 1;
+    ParallelFor(numel, 1, [&](int64_t begin, int64_t end) {
+      BinaryRow<T, F>(pa + begin * sa, sa, pb + begin * sb, sb, po + begin, end - begin);
+    });
+    return out;
+  }
+
+  // Otherwise iterate the rows of the innermost dimension.
+  auto a_strides  = BroadcastStrides(a_dims, out_dims);
+  auto b_strides  = BroadcastStrides(b_dims, out_dims);
+  int64_t row     = out_dims.back();
+  int64_t num_row = row == 0 ? 0 : numel / row;
+  ParallelFor(num_row, row, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      BinaryRow<T, F>(pa + GetRowOffset(r, out_dims, a_strides),
+                      a_strides.back(),
+                      pb + GetRowOffset(r, out_dims, b_strides),
+                      b_strides.back(),
+                      po + r * row,
+                      row);
+    }
+  });
+  return out;
+}
+
+//! The binary operation writing the result to \p a, a broadcast or aliased \p a gets a new buffer.
+template <typename T, typename F>
+void ElementwiseBinaryInplace(DenseTensor* a, const DenseTensor& b) {
+  auto a_dims = GetDims(a->shape());
+  auto b_dims = GetDims(b.shape());
+  if (BroadcastDims(a_dims, b_dims) != a_dims || a->data() == b.data()) {
+    *a = ElementwiseBinary<T, F>(*a, b);
+    return;
+  }
+  T* pa           = GetData<T>(*a);
+  const T* pb     = GetData<T>(b);
+  int64_t numel   = GetNumElements(a_dims);
+  int64_t b_numel = GetNumElements(b_dims);
+  if (b_numel == numel || b_numel == 1) {
+    int64_t sb = b_numel == 1 ? 0 : 1;
+    ParallelFor(numel, 1, [&](int64_t begin, int64_t end) {
+      BinaryRowInplace<T, F>(pa + begin, pb + begin * sb, sb, end - begin);
+    });
+    return;
+  }
+
+  auto b_strides  = BroadcastStrides(b_dims, a_dims);
+  int64_t row     = a_dims.back();
+  int64_t num_row = row == 0 ? 0 : numel / row;
+  ParallelFor(num_row, row, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      BinaryRowInplace<T, F>(pa + r * row, pb + GetRowOffset(r, a_dims, b_strides), b_strides.back(), row);
+    }
+  });
+}
+
+template <typename T, typename F>
+DenseTensor ElementwiseUnary(const DenseTensor& x) {
+  auto dims   = GetDims(x.shape());
+  auto out    = MakeTensor<T>(dims);
+  const T* px = GetData<T>(x);
+  T* po       = GetData<T>(out);
+  ParallelFor(GetNumElements(dims), 1, [&](int64_t begin, int64_t end) {
+    const T* __restrict__ src = px;
+    T* __restrict__ dst       = po;
+    F f;
+    for (int64_t i = begin; i < end; i++) dst[i] = f(src[i]);
+  });
+  return out;
+}
+
+template <typename T, typename F>
+void ElementwiseUnaryInplace(DenseTensor* x) {
+  T* px = GetData<T>(*x);
+  ParallelFor(x->shape().GetNumElements(), 1, [&](int64_t begin, int64_t end) {
+    T* __restrict__ data = px;
+    F f;
+    for (int64_t i = begin; i < end; i++) data[i] = f(data[i]);
+  });
+}
+
+/**
+ * Reduce the dimension \p axis, negative for counting from the last one. The tensor is viewed as [outer, len, inner],
+ * the rows of the inner elements are accumulated contiguously.
+ */
+template <typename T, typename R>
+DenseTensor Reduce(const DenseTensor& x, Attribute<int32_t> axis_attr) {
+  auto dims = GetDims(x.shape());
+  int rank  = dims.size();
+  int axis  = axis_attr.get() < 0 ? axis_attr.get() + rank : axis_attr.get();
+  CHECK(axis >= 0 && axis < rank) << "The axis " << axis_attr.get() << " is out of the rank " << rank;
+
+  int64_t outer = GetNumElements(std::vector<int64_t>(dims.begin(), dims.begin() + axis));
+  int64_t len   = dims[axis];
+  int64_t inner = GetNumElements(std::vector<int64_t>(dims.begin() + axis + 1, dims.end()));
+  dims.erase(dims.begin() + axis);
+  auto out    = MakeTensor<T>(dims);
+  const T* px = GetData<T>(x);
+  T* po       = GetData<T>(out);
+
+  ParallelFor(outer, len * inner, [&](int64_t begin, int64_t end) {
+    R reducer;
+    for (int64_t o = begin; o < end; o++) {
+      const T* __restrict__ src = px + o * len * inner;
+      T* __restrict__ dst       = po + o * inner;
+      if (inner == 1) {
+        T acc = R::template Init<T>();
+        for (int64_t k = 0; k < len; k++) acc = reducer(acc, src[k]);
+        *dst = acc;
+        continue;
+      }
+      std::fill(dst, dst + inner, R::template Init<T>());
+      for (int64_t k = 0; k < len; k++) {
+        const T* __restrict__ row = src + k * inner;
+        for (int64_t j = 0; j < inner; j++) dst[j] = reducer(dst[j], row[j]);
+      }
+    }
+  });
+  return out;
+}
+
+template <typename T>
+DenseTensor ReduceMean(const DenseTensor& x, Attribute<int32_t> axis) {
+  auto out    = Reduce<T, SumReducer>(x, axis);
+  int64_t len = x.shape().GetNumElements() / std::max(out.shape().GetNumElements(), 1);
+  T* po       = GetData<T>(out);
+  T scale     = T(1) / std::max<T>(len, 1);
+  ParallelFor(out.shape().GetNumElements(), 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) po[i] *= scale;
+  });
+  return out;
+}
+
+/**
+ * Multiply the 2D matrices, the loops are in the i-k-j order so the innermost one runs over the contiguous rows of \p b
+ * and the output, and the k and j dimensions are blocked so the block of \p b in use stays in the cache across the rows
+ * of \p a.
+ */
+template <typename T>
+DenseTensor Matmul(const DenseTensor& a, const DenseTensor& b) {
+  CHECK_EQ(a.shape().GetRank(), 2) << "matmul only supports 2D tensors";
+  CHECK_EQ(b.shape().GetRank(), 2) << "matmul only supports 2D tensors";
+  int64_t M = a.shape().GetDim(0), K = a.shape().GetDim(1), N = b.shape().GetDim(1);
+  CHECK_EQ(K, b.shape().GetDim(0)) << "The shapes of matmul do not match";
+
+  auto out    = MakeTensor<T>({M, N});
+  const T* pa = GetData<T>(a);
+  const T* pb = GetData<T>(b);
+  T* po       = GetData<T>(out);
+
+  constexpr int64_t kBlockK = 128;
+  constexpr int64_t kBlockN = 256;
+  ParallelFor(M, K * N, [&](int64_t begin, int64_t end) {
+    std::fill(po + begin * N, po + end * N, T(0));
+    for (int64_t k0 = 0; k0 < K; k0 += kBlockK) {
+      int64_t k1 = std::min(K, k0 + kBlockK);
+      for (int64_t j0 = 0; j0 < N; j0 += kBlockN) {
+        int64_t j1 = std::min(N, j0 + kBlockN);
+        for (int64_t i = begin; i < end; i++) {
+          T* __restrict__ c = po + i * N;
+          for (int64_t k = k0; k < k1; k++) {
+            const T x                   = pa[i * K + k];
+            const T* __restrict__ b_row = pb + k * N;
+            for (int64_t j = j0; j < j1; j++) c[j] += x * b_row[j];
+          }
+        }
+      }
+    }
+  });
+  return out;
+}
+
+//! Permute the dimensions, the output dimension `i` is the input dimension `perm[i]`.
+template <typename T>
+DenseTensor Transpose(const DenseTensor& x, Attribute<std::vector<int64_t>> perm_attr) {
+  auto dims        = GetDims(x.shape());
+  const auto& perm = perm_attr.get();
+  int rank         = dims.size();
+  CHECK_EQ(perm.size(), dims.size()) << "The perm of transpose does not match the rank";
+
+  std::vector<bool> used(rank, false);
+  std::vector<int64_t> out_dims(rank), src_strides(rank);
+  auto strides = GetStrides(dims);
+  for (int i = 0; i < rank; i++) {
+    CHECK(perm[i] >= 0 && perm[i] < rank && !used[perm[i]]) << "The perm of transpose is not a permutation";
+    used[perm[i]]  = true;
+    out_dims[i]    = dims[perm[i]];
+    src_strides[i] = strides[perm[i]];
+  }
+  auto out    = MakeTensor<T>(out_dims);
+  const T* px = GetData<T>(x);
+  T* po       = GetData<T>(out);
+  if (rank == 0) {
+    *po = *px;
+    return out;
+  }
+
+  int64_t row     = out_dims.back();
+  int64_t step    = src_strides.back();
+  int64_t num_row = row == 0 ? 0 : GetNumElements(out_dims) / row;
+  ParallelFor(num_row, row, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      const T* __restrict__ src = px + GetRowOffset(r, out_dims, src_strides);
+      T* __restrict__ dst       = po + r * row;
+      if (step == 1) {
+        for (int64_t j = 0; j < row; j++) dst[j] = src[j];
+      } else {
+        for (int64_t j = 0; j < row; j++) dst[j] = src[j * step];
+      }
+    }
+  });
+  return out;
+}
+
+template <typename T>
+DenseTensor Copy(const DenseTensor& x) {
+  auto out    = MakeTensor<T>(GetDims(x.shape()));
+  const T* px = GetData<T>(x);
+  T* po       = GetData<T>(out);
+  ParallelFor(x.shape().GetNumElements(), 1, [&](int64_t begin, int64_t end) {
+    std::memcpy(po + begin, px + begin, (end - begin) * sizeof(T));
+  });
+  return out;
+}
+
+/// ===== Kernel end ====
+
+//! Register the kernels valid for all the data types, named `dt.<op>.<dtype>`.
+template <typename T>
+void RegisterCommonKernels(KernelRegistry* registry, const std::string& dtype) {
+  registry->AddKernel("dt.add." + dtype, CINN_KERNEL(ElementwiseBinary<T, AddFunctor>));
+  registry->AddKernel("dt.sub." + dtype, CINN_KERNEL(ElementwiseBinary<T, SubFunctor>));
+  registry->AddKernel("dt.mul." + dtype, CINN_KERNEL(ElementwiseBinary<T, MulFunctor>));
+  registry->AddKernel("dt.div." + dtype, CINN_KERNEL(ElementwiseBinary<T, DivFunctor>));
+  registry->AddKernel("dt.max." + dtype, CINN_KERNEL(ElementwiseBinary<T, MaxFunctor>));
+  registry->AddKernel("dt.min." + dtype, CINN_KERNEL(ElementwiseBinary<T, MinFunctor>));
+  registry->AddKernel("dt.add_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, AddFunctor>));
+  registry->AddKernel("dt.sub_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, SubFunctor>));
+  registry->AddKernel("dt.mul_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, MulFunctor>));
+  registry->AddKernel("dt.div_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, DivFunctor>));
+  registry->AddKernel("dt.max_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, MaxFunctor>));
+  registry->AddKernel("dt.min_inplace." + dtype, CINN_KERNEL(ElementwiseBinaryInplace<T, MinFunctor>));
+
+  registry->AddKernel("dt.neg." + dtype, CINN_KERNEL(ElementwiseUnary<T, NegFunctor>));
+  registry->AddKernel("dt.abs." + dtype, CINN_KERNEL(ElementwiseUnary<T, AbsFunctor>));
+  registry->AddKernel("dt.relu." + dtype, CINN_KERNEL(ElementwiseUnary<T, ReluFunctor>));
+  registry->AddKernel("dt.neg_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, NegFunctor>));
+  registry->AddKernel("dt.abs_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, AbsFunctor>));
+  registry->AddKernel("dt.relu_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, ReluFunctor>));
+
+  registry->AddKernel("dt.reduce_sum." + dtype, CINN_KERNEL(Reduce<T, SumReducer>));
+  registry->AddKernel("dt.reduce_max." + dtype, CINN_KERNEL(Reduce<T, MaxReducer>));
+  registry->AddKernel("dt.reduce_min." + dtype, CINN_KERNEL(Reduce<T, MinReducer>));
+
+  registry->AddKernel("dt.matmul." + dtype, CINN_KERNEL(Matmul<T>));
+  registry->AddKernel("dt.transpose." + dtype, CINN_KERNEL(Transpose<T>));
+  registry->AddKernel("dt.copy." + dtype, CINN_KERNEL(Copy<T>));
+}
+
+//! Register the kernels valid only for the floating point types.
+template <typename T>
+void RegisterFloatKernels(KernelRegistry* registry, const std::string& dtype) {
+  registry->AddKernel("dt.exp." + dtype, CINN_KERNEL(ElementwiseUnary<T, ExpFunctor>));
+  registry->AddKernel("dt.sqrt." + dtype, CINN_KERNEL(ElementwiseUnary<T, SqrtFunctor>));
+  registry->AddKernel("dt.tanh." + dtype, CINN_KERNEL(ElementwiseUnary<T, TanhFunctor>));
+  registry->AddKernel("dt.sigmoid." + dtype, CINN_KERNEL(ElementwiseUnary<T, SigmoidFunctor>));
+  registry->AddKernel("dt.exp_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, ExpFunctor>));
+  registry->AddKernel("dt.sqrt_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, SqrtFunctor>));
+  registry->AddKernel("dt.tanh_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, TanhFunctor>));
+  registry->AddKernel("dt.sigmoid_inplace." + dtype, CINN_KERNEL(ElementwiseUnaryInplace<T, SigmoidFunctor>));
+  registry->AddKernel("dt.reduce_mean." + dtype, CINN_KERNEL(ReduceMean<T>));
+}
+
+}  // namespace
+
+void RegisterTensorMathKernels(host_context::KernelRegistry* registry) {
+  RegisterCommonKernels<float>(registry, "f32");
+  RegisterCommonKernels<double>(registry, "f64");
+  RegisterCommonKernels<int32_t>(registry, "i32");
+  RegisterCommonKernels<int64_t>(registry, "i64");
+  RegisterFloatKernels<float>(registry, "f32");
+  RegisterFloatKernels<double>(registry, "f64");
+}
+
+}  // namespace cinnrt::kernel
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace cinnrt::host_context {
+
+class KernelRegistry;
+
+}  // namespace cinnrt::host_context
+
+namespace cinnrt::kernel {
+
+/**
+ * Register the math kernels on the host DenseTensors: the elementwise operations with broadcasting and their in-place
+ * forms, the reductions, matmul, transpose and copy.
+ *
+ * The innermost loops are contiguous and free of aliasing, so they are vectorized by the compiler, and the large
+ * tensors are split across the thread pool running the kernel, or `ThreadPool::Default()` out of a pool.
+ */
+void RegisterTensorMathKernels(host_context::KernelRegistry* registry);
+
+}  // namespace cinnrt::kernel
@@ -0,0 +1,271 @@
+#include "cinnrt/kernel/tensor_math_kernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cinnrt/host_context/dense_tensor.h"
+#include "cinnrt/host_context/kernel_registry.h"
+#include "cinnrt/host_context/kernel_utils.h"
+#include "cinnrt/host_context/tensor_shape.h"
+#include "cinnrt/host_context/thread_pool.h"
+#include "cinnrt/host_context/value.h"
+
+namespace cinnrt::kernel {
+using namespace host_context;  // NOLINT
+
+namespace {
+
+//! A tensor of \p dims filled by \p fn of the flat index.
+template <typename T>
+ValueRef MakeTensor(const std::vector<int64_t>& dims, const std::function<T(int64_t)>& fn) {
+  DenseTensor tensor(TensorShape(llvm::ArrayRef<int64_t>(dims)), cinn_type_of<T>());
+  auto* data = static_cast<T*>(tensor.data());
+  for (int64_t i = 0; i < tensor.shape().GetNumElements(); i++) data[i] = fn(i);
+  return ValueRef(new Value(std::move(tensor)));
+}
+
+template <typename T>
+const T* GetData(const DenseTensor& tensor) {
+  return static_cast<const T*>(tensor.data());
+}
+
+//! Call the kernel \p name of a single result.
+DenseTensor Call(const KernelRegistry& registry,
+                 const std::string& name,
+                 const std::vector<ValueRef>& args,
+                 const std::vector<ValueRef>& attrs = {}) {
+  auto kernel = registry.GetKernel(name);
+  CHECK(kernel) << "No kernel " << name;
+  KernelFrameBuilder frame;
+  for (auto& arg : args) frame.AddArgument(arg);
+  frame.SetNumResults(1);
+  for (auto& attr : attrs) frame.AddAttribute(attr.get());
+  kernel(&frame);
+  return frame.GetResults()[0].get<DenseTensor>();
+}
+
+//! Call the in-place kernel \p name, it writes its first argument.
+void CallInplace(const KernelRegistry& registry, const std::string& name, const std::vector<ValueRef>& args) {
+  auto kernel = registry.GetKernel(name);
+  CHECK(kernel) << "No kernel " << name;
+  KernelFrameBuilder frame;
+  for (auto& arg : args) frame.AddArgument(arg);
+  frame.SetNumResults(0);
+  kernel(&frame);
+}
+
+/**
+ * Check the binary kernels of \p dtype on \p a_dims and \p b_dims against a loop over the output indices, \p b has no
+ * zeros so the division is defined for the integers.
+ */
+template <typename T>
+void CheckBinary(const KernelRegistry& registry,
+                 const std::string& dtype,
+                 const std::vector<int64_t>& a_dims,
+                 const std::vector<int64_t>& b_dims) {
+  ValueRef a = MakeTensor<T>(a_dims, [](int64_t i) { return static_cast<T>(i * 7 % 23) - static_cast<T>(11); });
+  ValueRef b = MakeTensor<T>(b_dims, [](int64_t i) { return static_cast<T>(i % 5 + 1) * (i % 2 ? 1 : -1); });
+
+  std::vector<std::pair<std::string, std::function<T(T, T)>>> ops{
+      {"add", [](T x, T y) { return x + y; }},
+      {"sub", [](T x, T y) { return x - y; }},
+      {"mul", [](T x, T y) { return x * y; }},
+      {"div", [](T x, T y) { return x / y; }},
+      {"max", [](T x, T y) { return x > y ? x : y; }},
+      {"min", [](T x, T y) { return x < y ? x : y; }},
+  };
+
+  int rank = std::max(a_dims.size(), b_dims.size());
+  // The offset of the output index \p index in a tensor of \p dims broadcast to the rank.
+  auto offset = [&](const std::vector<int64_t>& dims, const std::vector<int64_t>& index) {
+    int64_t res = 0;
+    for (int i = 0; i < dims.size(); i++) {
+      int64_t x = index[rank - dims.size() + i];
+      res       = res * dims[i] + (dims[i] == 1 ? 0 : x);
+    }
+    return res;
+  };
+
+  for (auto& [name, op] : ops) {
+    auto out = Call(registry, "dt." + name + "." + dtype, {a, b});
+    ASSERT_EQ(out.shape().GetRank(), rank) << name;
+    std::vector<int64_t> out_dims(rank);
+    for (int i = 0; i < rank; i++) out_dims[i] = out.shape().GetDim(i);
+
+    const T* pa = GetData<T>(a->get<DenseTensor>());
+    const T* pb = GetData<T>(b->get<DenseTensor>());
+    const T* po = GetData<T>(out);
+    std::vector<int64_t> index(rank);
+    for (int64_t k = 0; k < out.shape().GetNumElements(); k++) {
+      for (int64_t d = rank - 1, rest = k; d >= 0; d--) {
+        index[d] = rest % out_dims[d];
+        rest /= out_dims[d];
+      }
+      ASSERT_EQ(po[k], op(pa[offset(a_dims, index)], pb[offset(b_dims, index)])) << name << "." << dtype << " at " << k;
+    }
+  }
+}
+
+template <typename T>
+void CheckUnary(const KernelRegistry& registry,
+                const std::string& dtype,
+                const std::string& name,
+                const std::function<T(T)>& op,
+                const std::function<T(int64_t)>& init) {
+  ValueRef x = MakeTensor<T>({3, 17}, init);
+  auto out = Call(registry, "dt." + name + "." + dtype, {x});
+  CallInplace(registry, "dt." + name + "_inplace." + dtype, {x});
+  const T* po = GetData<T>(out);
+  const T* px = GetData<T>(x->get<DenseTensor>());
+  for (int64_t i = 0; i < 3 * 17; i++) {
+    T expected = op(init(i));
+    if (std::is_floating_point<T>::value) {
+      ASSERT_NEAR(po[i], expected, 1e-6) << name << "." << dtype << " at " << i;
+    } else {
+      ASSERT_EQ(po[i], expected) << name << "." << dtype << " at " << i;
+    }
+    ASSERT_EQ(px[i], po[i]) << name << "_inplace." << dtype << " at " << i;
+  }
+}
+
+template <typename T>
+void CheckCommonUnary(const KernelRegistry& registry, const std::string& dtype) {
+  auto init = [](int64_t i) { return static_cast<T>(i % 9) - static_cast<T>(4); };
+  CheckUnary<T>(registry, dtype, "neg", [](T x) { return -x; }, init);
+  CheckUnary<T>(registry, dtype, "abs", [](T x) { return x < T(0) ? -x : x; }, init);
+  CheckUnary<T>(registry, dtype, "relu", [](T x) { return x > T(0) ? x : T(0); }, init);
+}
+
+template <typename T>
+void CheckFloatUnary(const KernelRegistry& registry, const std::string& dtype) {
+  auto init     = [](int64_t i) { return static_cast<T>(i % 9) / T(4) - T(1); };
+  auto positive = [](int64_t i) { return static_cast<T>(i % 9) / T(4); };
+  CheckUnary<T>(registry, dtype, "exp", [](T x) { return std::exp(x); }, init);
+  CheckUnary<T>(registry, dtype, "sqrt", [](T x) { return std::sqrt(x); }, positive);
+  CheckUnary<T>(registry, dtype, "tanh", [](T x) { return std::tanh(x); }, init);
+  CheckUnary<T>(registry, dtype, "sigmoid", [](T x) { return T(1) / (T(1) + std::exp(-x)); }, init);
+}
+
+class TensorMathKernelsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { RegisterTensorMathKernels(&registry_); }
+
+  KernelRegistry registry_;
+};
+
+}  // namespace
+
+TEST_F(TensorMathKernelsTest, binary) {
+  // The same shape, a scalar, a row broadcast across the rows, a column and a middle dimension.
+  std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> shapes{
+      {{4, 5}, {4, 5}}, {{4, 5}, {1}}, {{4, 5}, {5}}, {{4, 5}, {4, 1}}, {{3, 4, 5}, {4, 1}}, {{1, 5}, {3, 1}}};
+  for (auto& [a_dims, b_dims] : shapes) {
+    CheckBinary<float>(registry_, "f32", a_dims, b_dims);
+    CheckBinary<double>(registry_, "f64", a_dims, b_dims);
+    CheckBinary<int32_t>(registry_, "i32", a_dims, b_dims);
+    CheckBinary<int64_t>(registry_, "i64", a_dims, b_dims);
+  }
+}
+
+TEST_F(TensorMathKernelsTest, binary_inplace) {
+  // Broadcasting \p b across the rows of \p a writes \p a in place, broadcasting \p a gets a new buffer.
+  for (auto& [a_dims, b_dims] : std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>>{
+           {{4, 5}, {5}}, {{4, 5}, {4, 1}}, {{5}, {4, 5}}}) {
+    auto a      = MakeTensor<int32_t>(a_dims, [](int64_t i) { return static_cast<int32_t>(i); });
+    auto b      = MakeTensor<int32_t>(b_dims, [](int64_t i) { return static_cast<int32_t>(i + 1); });
+    auto out    = Call(registry_, "dt.div.i32", {a, b});
+    void* data  = a->get<DenseTensor>().data();
+    bool shaped = out.shape().GetNumElements() == a->get<DenseTensor>().shape().GetNumElements();
+    CallInplace(registry_, "dt.div_inplace.i32", {a, b});
+    auto& result = a->get<DenseTensor>();
+    ASSERT_EQ(result.data() == data, shaped);
+    ASSERT_EQ(result.shape().GetNumElements(), out.shape().GetNumElements());
+    for (int64_t i = 0; i < out.shape().GetNumElements(); i++) {
+      ASSERT_EQ(GetData<int32_t>(result)[i], GetData<int32_t>(out)[i]);
+    }
+  }
+}
+
+TEST_F(TensorMathKernelsTest, unary) {
+  CheckCommonUnary<float>(registry_, "f32");
+  CheckCommonUnary<double>(registry_, "f64");
+  CheckCommonUnary<int32_t>(registry_, "i32");
+  CheckCommonUnary<int64_t>(registry_, "i64");
+  CheckFloatUnary<float>(registry_, "f32");
+  CheckFloatUnary<double>(registry_, "f64");
+}
+
+TEST_F(TensorMathKernelsTest, reduce) {
+  auto x            = MakeTensor<int64_t>({3, 4, 5}, [](int64_t i) { return i * 7 % 11; });
+  const int64_t* px = GetData<int64_t>(x->get<DenseTensor>());
+  int64_t dims[]    = {3, 4, 5};
+  int64_t strides[] = {20, 5, 1};
+  for (int axis : {0, 1, 2, -1}) {
+    auto axis_attr = ValueRef(new Value(axis));
+    auto sum       = Call(registry_, "dt.reduce_sum.i64", {x}, {axis_attr});
+    auto max       = Call(registry_, "dt.reduce_max.i64", {x}, {axis_attr});
+    auto min       = Call(registry_, "dt.reduce_min.i64", {x}, {axis_attr});
+    // The output is indexed by the remaining dimensions d0 and d1.
+    int a  = axis < 0 ? axis + 3 : axis;
+    int d0 = a == 0 ? 1 : 0, d1 = a == 2 ? 1 : 2;
+    for (int64_t i = 0; i < dims[d0]; i++) {
+      for (int64_t j = 0; j < dims[d1]; j++) {
+        int64_t s = 0, hi = std::numeric_limits<int64_t>::lowest(), lo = std::numeric_limits<int64_t>::max();
+        for (int64_t k = 0; k < dims[a]; k++) {
+          int64_t v = px[i * strides[d0] + j * strides[d1] + k * strides[a]];
+          s += v;
+          hi = std::max(hi, v);
+          lo = std::min(lo, v);
+        }
+        int64_t o = i * dims[d1] + j;
+        ASSERT_EQ(GetData<int64_t>(sum)[o], s) << "axis " << axis;
+        ASSERT_EQ(GetData<int64_t>(max)[o], hi) << "axis " << axis;
+        ASSERT_EQ(GetData<int64_t>(min)[o], lo) << "axis " << axis;
+      }
+    }
+  }
+}
+
+// The tensors above the grain size of a single thread are split across the pool.
+TEST_F(TensorMathKernelsTest, parallel) {
+  const int64_t rows = 1024, cols = 1000;
+  auto a = MakeTensor<double>({rows, cols}, [](int64_t i) { return static_cast<double>(i % 1013); });
+  auto b = MakeTensor<double>({cols}, [](int64_t i) { return static_cast<double>(i); });
+
+  auto check = [&] {
+    auto out      = Call(registry_, "dt.add.f64", {a, b});
+    const auto* p = GetData<double>(out);
+    for (int64_t i = 0; i < rows * cols; i++) ASSERT_EQ(p[i], (i % 1013) + (i % cols)) << i;
+
+    auto sum = Call(registry_, "dt.reduce_sum.f64", {a}, {ValueRef(new Value(1))});
+    for (int64_t r = 0; r < rows; r++) {
+      double expected = 0;
+      for (int64_t j = 0; j < cols; j++) expected += (r * cols + j) % 1013;
+      ASSERT_EQ(GetData<double>(sum)[r], expected) << r;
+    }
+  };
+  // Out of a pool, on the default one.
+  check();
+
+  // In a task of a pool, on that pool, with the other workers busy.
+  ThreadPool pool(2);
+  std::atomic<int> num_done{0};
+  for (int i = 0; i < 2; i++) {
+    pool.Schedule([&] {
+      EXPECT_EQ(ThreadPool::Current(), &pool);
+      check();
+      num_done++;
+    });
+  }
+  while (num_done < 2) std::this_thread::yield();
+}
+
+}  // namespace cinnrt::kernel
@@ -70,8 +70,9 @@ endfunction()
 # Execute the mlir script with cinn-exec program.
 # @name: name of the test
 # @script: path to the mlir script file
+# the extra arguments are passed to cinn-exec
 function (cinn_exec_check name script)
   add_test(NAME ${name}
-    COMMAND sh -c "${CMAKE_BINARY_DIR}/cinnrt/host_context/cinn-exec -i ${CMAKE_CURRENT_SOURCE_DIR}/${script}| FileCheck-10  ${CMAKE_CURRENT_SOURCE_DIR}/${script}")
+    COMMAND sh -c "${CMAKE_BINARY_DIR}/cinnrt/host_context/cinn-exec -i ${CMAKE_CURRENT_SOURCE_DIR}/${script} ${ARGN}| FileCheck-10  ${CMAKE_CURRENT_SOURCE_DIR}/${script}")
 endfunction()
 